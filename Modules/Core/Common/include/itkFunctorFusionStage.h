@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkFunctorFusionStage_h
+#define __itkFunctorFusionStage_h
+
+#include "itkDataObject.h"
+#include "itkIndex.h"
+
+namespace itk
+{
+/** \class FunctorFusionStage
+ * \brief Interface of the pixel-wise filters that can be fused into a
+ * single pass.
+ *
+ * The functor image filters (UnaryFunctorImageFilter,
+ * BinaryFunctorImageFilter, TernaryFunctorImageFilter and
+ * NaryFunctorImageFilter) implement this interface in addition to
+ * deriving from ImageSource.  It lets FunctorFusionImageFilter evaluate
+ * the functor of each filter of a chain on one line of pixels at a time,
+ * so that the intermediate images of the chain are never allocated.
+ *
+ * The pixel lines are passed as untyped pointers.  A stage only accepts
+ * lines of the pixel type of its own inputs and produces lines of the
+ * pixel type of its output, which is guaranteed when CanFuse() returns
+ * true for every stage of a chain.
+ *
+ * \sa FunctorFusionImageFilter
+ * \ingroup ITKCommon
+ */
+template< unsigned int VImageDimension >
+class FunctorFusionStage
+{
+public:
+  typedef Index< VImageDimension > FusionIndexType;
+
+  virtual ~FunctorFusionStage() {}
+
+  /** Return true when the filter can be evaluated line by line: all its
+   * inputs and its output are itk::Image of dimension VImageDimension, and
+   * its functor does not depend on the contents of its input images.
+   * Subclasses that compute their functor parameters from the input
+   * pixels return false. */
+  virtual bool CanFuse() const = 0;
+
+  /** Number of image inputs of the stage.  Constant inputs, like the
+   * decorated constants of BinaryFunctorImageFilter, are not counted. */
+  virtual unsigned int GetNumberOfFusionInputs() const = 0;
+
+  /** Image input number "input" of the stage. */
+  virtual const DataObject * GetFusionInput(unsigned int input) const = 0;
+
+  /** Prepare the functor for the evaluation of lines.  This performs the
+   * setup the filter does in BeforeThreadedGenerateData(). */
+  virtual void BeforeFusedGenerateData() = 0;
+
+  /** Pointer to the pixel at "index" in the buffer of image input number
+   * "input".  The pixels of the line follow contiguously. */
+  virtual const void * GetFusionInputLine(unsigned int input, const FusionIndexType & index) const = 0;
+
+  /** Allocate and release a line of output pixels of the stage. */
+  virtual void * AllocateFusionLine(SizeValueType length) const = 0;
+  virtual void ReleaseFusionLine(void *line) const = 0;
+
+  /** Apply the functor to "length" pixels.  inputs[i] points to a line of
+   * pixels of image input number i. */
+  virtual void EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length) = 0;
+};
+} // end namespace itk
+
+#endif
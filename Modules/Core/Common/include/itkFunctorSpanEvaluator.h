@@ -0,0 +1,189 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkFunctorSpanEvaluator_h
+#define __itkFunctorSpanEvaluator_h
+
+#include "itkIsSame.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+/** \cond HIDE_META_PROGRAMMING */
+/** Whether TFunction has a batch operator
+ *   void operator()(const TInput *, TOutput *, SizeValueType) const */
+template< class TFunction, class TInput, class TOutput >
+struct HasUnarySpanOperator
+{
+  typedef char YesType;
+  typedef char NoType[2];
+
+  template< class U, void (U::*)(const TInput *, TOutput *, SizeValueType) const >
+  struct Check {};
+
+  template< class U >
+  static YesType & Test(Check< U, &U::operator() > *);
+
+  template< class U >
+  static NoType & Test(...);
+
+  static const bool Value = sizeof( Test< TFunction >(0) ) == sizeof( YesType );
+};
+
+/** Whether TFunction has a batch operator
+ *   void operator()(const TInput1 *, const TInput2 *, TOutput *, SizeValueType) const */
+template< class TFunction, class TInput1, class TInput2, class TOutput >
+struct HasBinarySpanOperator
+{
+  typedef char YesType;
+  typedef char NoType[2];
+
+  template< class U, void (U::*)(const TInput1 *, const TInput2 *, TOutput *, SizeValueType) const >
+  struct Check {};
+
+  template< class U >
+  static YesType & Test(Check< U, &U::operator() > *);
+
+  template< class U >
+  static NoType & Test(...);
+
+  static const bool Value = sizeof( Test< TFunction >(0) ) == sizeof( YesType );
+};
+
+template< bool VValue >
+struct BoolType:public FalseType {};
+
+template<>
+struct BoolType< true >:public TrueType {};
+/** \endcond */
+
+/** \class UnaryFunctorSpanEvaluator
+ * \brief Applies a unary functor to a span of contiguous pixels.
+ *
+ * Evaluate() calls the per-pixel operator() of the functor in a plain loop
+ * over raw pixel pointers, which the compiler can inline and vectorize
+ * since no iterator stands in the way.  A functor with a faster way of
+ * processing many pixels at once can provide the batch operator
+ *
+ * \code
+ * void operator()(const TInput *input, TOutput *output, SizeValueType length) const;
+ * \endcode
+ *
+ * which is then called instead of the loop.  It is detected at compile
+ * time, so functors without it need not change.
+ *
+ * \sa ImageRegionSpanIterator
+ * \ingroup ITKCommon
+ */
+template< class TFunction, class TInput, class TOutput >
+class UnaryFunctorSpanEvaluator
+{
+public:
+  typedef BoolType< HasUnarySpanOperator< TFunction, TInput, TOutput >::Value > HasSpanOperatorType;
+
+  static void Evaluate(TFunction & functor, const TInput *input, TOutput *output, SizeValueType length)
+  {
+    Dispatch( functor, input, output, length, HasSpanOperatorType() );
+  }
+
+private:
+  static void Dispatch(TFunction & functor, const TInput *input, TOutput *output, SizeValueType length,
+                       const FalseType &)
+  {
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      output[i] = functor(input[i]);
+      }
+  }
+
+  static void Dispatch(TFunction & functor, const TInput *input, TOutput *output, SizeValueType length,
+                       const TrueType &)
+  {
+    functor(input, output, length);
+  }
+};
+
+/** \class BinaryFunctorSpanEvaluator
+ * \brief Applies a binary functor to spans of contiguous pixels.
+ *
+ * Evaluate() takes two spans of input pixels, EvaluateWithConstant1() and
+ * EvaluateWithConstant2() a span and a constant.  Evaluate() calls the
+ * batch operator
+ *
+ * \code
+ * void operator()(const TInput1 *input1, const TInput2 *input2,
+ *                 TOutput *output, SizeValueType length) const;
+ * \endcode
+ *
+ * of the functor when it has one.
+ *
+ * \sa UnaryFunctorSpanEvaluator
+ * \ingroup ITKCommon
+ */
+template< class TFunction, class TInput1, class TInput2, class TOutput >
+class BinaryFunctorSpanEvaluator
+{
+public:
+  typedef BoolType< HasBinarySpanOperator< TFunction, TInput1, TInput2, TOutput >::Value > HasSpanOperatorType;
+
+  static void Evaluate(TFunction & functor, const TInput1 *input1, const TInput2 *input2,
+                       TOutput *output, SizeValueType length)
+  {
+    Dispatch( functor, input1, input2, output, length, HasSpanOperatorType() );
+  }
+
+  static void EvaluateWithConstant2(TFunction & functor, const TInput1 *input1, const TInput2 & constant2,
+                                    TOutput *output, SizeValueType length)
+  {
+    // The constant is copied so the compiler knows that writing the output
+    // does not change it.
+    const TInput2 value2 = constant2;
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      output[i] = functor(input1[i], value2);
+      }
+  }
+
+  static void EvaluateWithConstant1(TFunction & functor, const TInput1 & constant1, const TInput2 *input2,
+                                    TOutput *output, SizeValueType length)
+  {
+    const TInput1 value1 = constant1;
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      output[i] = functor(value1, input2[i]);
+      }
+  }
+
+private:
+  static void Dispatch(TFunction & functor, const TInput1 *input1, const TInput2 *input2,
+                       TOutput *output, SizeValueType length, const FalseType &)
+  {
+    for ( SizeValueType i = 0; i < length; ++i )
+      {
+      output[i] = functor(input1[i], input2[i]);
+      }
+  }
+
+  static void Dispatch(TFunction & functor, const TInput1 *input1, const TInput2 *input2,
+                       TOutput *output, SizeValueType length, const TrueType &)
+  {
+    functor(input1, input2, output, length);
+  }
+};
+} // end namespace itk
+
+#endif
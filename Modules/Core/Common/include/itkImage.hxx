@@ -47,14 +47,22 @@ Image< TPixel, VImageDimension >
 template< class TPixel, unsigned int VImageDimension >
 void
 Image< TPixel, VImageDimension >
-::Allocate()
+::Allocate(bool initializePixels)
 {
   SizeValueType num;
 
   this->ComputeOffsetTable();
   num = static_cast<SizeValueType>(this->GetOffsetTable()[VImageDimension]);
 
-  m_Buffer->Reserve(num);
+  m_Buffer->Reserve(num, initializePixels);
+}
+
+template< class TPixel, unsigned int VImageDimension >
+void
+Image< TPixel, VImageDimension >
+::FirstTouch(const RegionType & region)
+{
+  this->FirstTouchBuffer(m_Buffer->GetBufferPointer(), sizeof( PixelType ), region);
 }
 
 template< class TPixel, unsigned int VImageDimension >
@@ -239,13 +239,30 @@ public:
    * default origin is 0. */
   itkGetConstReferenceMacro(Origin, PointType);
 
+  /** Get the matrix mapping an index to its offset from the origin in
+   * physical space: the direction cosines scaled by the spacing.  It is
+   * computed automatically in SetDirection() and SetSpacing(), thus there
+   * is no Set accessor.
+   * \sa TransformIndexToPhysicalPoint() */
+  itkGetConstReferenceMacro(IndexToPhysicalPoint, DirectionType);
+
   /** Allocate the image memory. The size of the image must
    * already be set, e.g. by calling SetRegions() or SetBufferedRegion().
+   * The pixels are value-initialized (zero for the scalar types) if
+   * initializePixels is true, and left uninitialized otherwise.
    *
    * This method should be pure virtual, if backwards compatibility
    * was not required.
    */
-  virtual void Allocate() {}
+  virtual void Allocate(bool itkNotUsed(initializePixels) = false) {}
+
+  /** Write to the memory pages that hold the pixels of region, which
+   * must be inside the buffered region, without changing the pixel
+   * values.  Called by each thread on the part of a newly allocated
+   * buffer it will produce, it places these pages on the NUMA node of the
+   * thread.  Does nothing in images without a pixel buffer.
+   * \sa ImageSource::SetFirstTouchOutputs() */
+  virtual void FirstTouch(const RegionType & itkNotUsed(region)) {}
 
   /** Set the region object that defines the size and starting index
    * for the largest possible region this image could represent.  This
@@ -691,6 +708,10 @@ protected:
    * the BufferedRegion is set. */
   void ComputeOffsetTable();
 
+  /** Implementation of FirstTouch() for a buffer storing bytesPerPixel
+   * bytes per pixel, in the order given by the offset table. */
+  void FirstTouchBuffer(void *buffer, SizeValueType bytesPerPixel, const RegionType & region);
+
   /** Compute helper matrices used to transform Index coordinates to
    * PhysicalPoint coordinates and back. This method is virtual and will be
    * overloaded in derived classes in order to provide backward compatibility
@@ -31,6 +31,7 @@
 #include "itkImageBase.h"
 
 #include "itkFastMutexLock.h"
+#include "itkImageBufferAllocator.h"
 #include "itkProcessObject.h"
 #include "itkSpatialOrientation.h"
 #include <cstring>
@@ -228,6 +229,44 @@ ImageBase< VImageDimension >
   //   }
 }
 
+//----------------------------------------------------------------------------
+template< unsigned int VImageDimension >
+void
+ImageBase< VImageDimension >
+::FirstTouchBuffer(void *buffer, SizeValueType bytesPerPixel, const RegionType & region)
+{
+  if ( buffer == 0 || region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  // The lines along the first axis are contiguous in the buffer.
+  unsigned char *     bytes = static_cast< unsigned char * >( buffer );
+  const SizeValueType lineBytes = region.GetSize(0) * bytesPerPixel;
+  const IndexType &   startIndex = region.GetIndex();
+  IndexType           index = startIndex;
+
+  while ( true )
+    {
+    ImageBufferAllocator::TouchPages(bytes + this->ComputeOffset(index) * bytesPerPixel, lineBytes);
+
+    unsigned int dim = 1;
+    for (; dim < VImageDimension; ++dim )
+      {
+      ++index[dim];
+      if ( index[dim] < startIndex[dim] + static_cast< IndexValueType >( region.GetSize(dim) ) )
+        {
+        break;
+        }
+      index[dim] = startIndex[dim];
+      }
+    if ( dim >= VImageDimension )
+      {
+      break;
+      }
+    }
+}
+
 //----------------------------------------------------------------------------
 template< unsigned int VImageDimension >
 void
@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkImageBufferAllocator_h
+#define __itkImageBufferAllocator_h
+
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+/** \class ImageBufferAllocator
+ * \brief Allocates the raw memory of the image pixel buffers.
+ *
+ * Every buffer is aligned on at least Alignment bytes, so that
+ * vectorized code can use aligned loads on the first pixel of an image.
+ *
+ * Buffers of at least GlobalHugePageThreshold bytes are aligned on the
+ * huge page size and, where the system supports it, flagged for backing
+ * by transparent huge pages.  This reduces the TLB misses and the page
+ * faults when filters stream through multi-gigabyte volumes.
+ *
+ * The memory is not initialized.  ImportImageContainer constructs the
+ * elements in place.
+ *
+ * Allocate() and Free() go through ImageBufferPool, which may recycle
+ * released buffers instead of returning them to the system.
+ *
+ * \sa ImportImageContainer, ImageBufferPool
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocator
+{
+public:
+  /** Minimal alignment, in bytes, of every buffer: a cache line, which
+   * is also the width of the largest vector registers. */
+  itkStaticConstMacro(Alignment, unsigned int, 64);
+
+  /** Allocate numberOfBytes of uninitialized memory, possibly reusing a
+   * buffer cached by ImageBufferPool.  Return NULL when the allocation
+   * fails. */
+  static void * Allocate(SizeValueType numberOfBytes);
+
+  /** Release memory obtained from Allocate(), or hand it back to
+   * ImageBufferPool. */
+  static void Free(void *buffer);
+
+  /** Write back one byte of each memory page overlapping the
+   * numberOfBytes bytes at buffer, without changing their value.  The
+   * first write to a page of a new buffer makes the operating system map
+   * it, on NUMA systems on the memory node of the calling thread. */
+  static void TouchPages(void *buffer, SizeValueType numberOfBytes);
+
+  /** Set/Get the size, in bytes, from which buffers are allocated on huge
+   * page boundaries.  Zero disables the huge page hints.  The initial
+   * value is read from the ITK_HUGE_PAGE_THRESHOLD environment variable
+   * and defaults to 1 GiB. */
+  static void SetGlobalHugePageThreshold(SizeValueType numberOfBytes);
+  static SizeValueType GetGlobalHugePageThreshold();
+
+private:
+  ImageBufferAllocator();                      //purposely not implemented
+  ImageBufferAllocator(const ImageBufferAllocator &); //purposely not implemented
+  void operator=(const ImageBufferAllocator &);       //purposely not implemented
+
+  /** Allocate and release memory without going through the pool. */
+  static void * AllocateFromSystem(SizeValueType numberOfBytes);
+  static void FreeToSystem(void *buffer);
+
+  friend class ImageBufferPool;
+
+  static SizeValueType m_GlobalHugePageThreshold;
+  static bool          m_GlobalHugePageThresholdIsInitialized;
+};
+} // end namespace itk
+
+#endif
@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkImageBufferPool_h
+#define __itkImageBufferPool_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSimpleFastMutexLock.h"
+
+#include <map>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageBufferPool
+ * \brief Process-wide cache of released image buffers.
+ *
+ * When the pipeline releases the bulk data of an intermediate image, e.g.
+ * because its ReleaseDataFlag is on, the next filter usually allocates a
+ * buffer of the very same size.  With the pool enabled, the buffers of at
+ * least MinimumBufferSize bytes are not returned to the system when they
+ * are released but kept for the next allocation of a similar size, which
+ * saves the system calls and the page faults of a new allocation.
+ *
+ * Sizes are rounded up to one of BucketsPerOctave buckets between two
+ * consecutive powers of two, so that a cached buffer is reused for any
+ * request of the same bucket, wasting at most 1/BucketsPerOctave of the
+ * memory.  At most MaximumNumberOfCachedBytes bytes are kept; a buffer
+ * released beyond that high-water mark goes back to the system.
+ *
+ * ImageBufferAllocator, and therefore ImportImageContainer, goes through
+ * the pool for every allocation.  The pool is disabled, and caches
+ * nothing, while MaximumNumberOfCachedBytes is zero, which is the default
+ * unless the ITK_IMAGE_BUFFER_POOL_SIZE environment variable gives a size
+ * in bytes.
+ *
+ * \sa ImageBufferAllocator
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferPool:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageBufferPool            Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferPool, Object);
+
+  /** Return the process-wide pool, creating it on first use. */
+  static Pointer GetInstance();
+
+  /** Number of buckets between two consecutive powers of two. */
+  itkStaticConstMacro(BucketsPerOctave, unsigned int, 8);
+
+  /** Set/Get the high-water mark, in bytes, of the cached buffers.
+   * Lowering it releases cached buffers as needed, and zero disables the
+   * pool. */
+  void SetMaximumNumberOfCachedBytes(SizeValueType numberOfBytes);
+  SizeValueType GetMaximumNumberOfCachedBytes() const;
+
+  /** Set/Get the size, in bytes, of the smallest buffers handled by the
+   * pool.  Smaller buffers are cheap to allocate and are never cached.
+   * The default is 1 MiB. */
+  void SetMinimumBufferSize(SizeValueType numberOfBytes);
+  SizeValueType GetMinimumBufferSize() const;
+
+  /** Return a buffer of at least numberOfBytes bytes, reusing a cached one
+   * when possible.  Return NULL when the allocation fails. */
+  void * Allocate(SizeValueType numberOfBytes);
+
+  /** Cache or release a buffer obtained from Allocate(). */
+  void Free(void *buffer);
+
+  /** Return all the cached buffers to the system. */
+  void ReleaseCachedBuffers();
+
+  /** Size of the buffers of the bucket of numberOfBytes. */
+  static SizeValueType GetBucketSize(SizeValueType numberOfBytes);
+
+  /** Statistics since the creation of the pool or the last call to
+   * ResetStatistics().  Only the allocations handled by the pool, i.e.
+   * when it is enabled and for at least MinimumBufferSize bytes, are
+   * counted. */
+  SizeValueType GetNumberOfRequests() const;
+  SizeValueType GetNumberOfHits() const;
+  SizeValueType GetNumberOfEvictions() const;
+  SizeValueType GetPeakNumberOfBytes() const;
+  void ResetStatistics();
+
+  /** Current number of bytes in the buffers handed out by the pool, and
+   * kept in its cache. */
+  SizeValueType GetNumberOfBytesInUse() const;
+  SizeValueType GetNumberOfCachedBytes() const;
+
+protected:
+  ImageBufferPool();
+  ~ImageBufferPool();
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+private:
+  ImageBufferPool(const Self &); //purposely not implemented
+  void operator=(const Self &);  //purposely not implemented
+
+  /** Release cached buffers until at most numberOfBytes bytes are
+   * cached.  m_Mutex must be held. */
+  void ShrinkCache(SizeValueType numberOfBytes);
+
+  typedef std::map< SizeValueType, std::vector< void * > > CachedBuffersType;
+  typedef std::map< void *, SizeValueType >                BuffersInUseType;
+
+  /** Released buffers, by bucket size. */
+  CachedBuffersType m_CachedBuffers;
+
+  /** Buffers handed out by the pool, with their bucket size. */
+  BuffersInUseType m_BuffersInUse;
+
+  SizeValueType m_MaximumNumberOfCachedBytes;
+  SizeValueType m_MinimumBufferSize;
+  SizeValueType m_NumberOfCachedBytes;
+  SizeValueType m_NumberOfBytesInUse;
+
+  SizeValueType m_NumberOfRequests;
+  SizeValueType m_NumberOfHits;
+  SizeValueType m_NumberOfEvictions;
+  SizeValueType m_PeakNumberOfBytes;
+
+  /** Guards all of the above. */
+  mutable SimpleFastMutexLock m_Mutex;
+
+  static Pointer             m_ImageBufferPoolInstance;
+  static SimpleFastMutexLock m_ImageBufferPoolInstanceMutex;
+};
+} // end namespace itk
+
+#endif
@@ -174,8 +174,23 @@ public:
    * to the beginning of the next row of the region) up until the iterator
    * tries to moves past the last pixel of the region.  Here, the iterator
    * will be set to be one pixel past the end of the region.
+   *
+   * Moving along a row is inlined; only the wrap to the next row goes
+   * through the loop over the dimensions.
    * \sa operator-- */
-  Self & operator++();
+  Self & operator++()
+  {
+    if ( ++this->m_PositionIndex[0] < this->m_EndIndex[0] )
+      {
+      this->m_Position += this->m_OffsetTable[0];
+      this->m_Remaining = true;
+      }
+    else
+      {
+      this->IncrementRow();
+      }
+    return *this;
+  }
 
   /** Decrement (prefix) the fastest moving dimension of the iterator's index.
    * This operator will constrain the iterator within the region (i.e. the
@@ -184,7 +199,29 @@ public:
    * tries to moves past the first pixel of the region.  Here, the iterator
    * will be set to be one pixel past the beginning of the region.
    * \sa operator++ */
-  Self & operator--();
+  Self & operator--()
+  {
+    if ( this->m_PositionIndex[0] > this->m_BeginIndex[0] )
+      {
+      --this->m_PositionIndex[0];
+      this->m_Position -= this->m_OffsetTable[0];
+      this->m_Remaining = true;
+      }
+    else
+      {
+      this->DecrementRow();
+      }
+    return *this;
+  }
+
+private:
+  /** Wrap from the end of a row to the beginning of the next one, or past
+   * the end of the region. */
+  void IncrementRow();
+
+  /** Wrap from the beginning of a row to the end of the previous one, or
+   * past the beginning of the region. */
+  void DecrementRow();
 };
 } // end namespace itk
 
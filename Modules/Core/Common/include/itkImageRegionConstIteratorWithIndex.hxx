@@ -23,15 +23,20 @@
 namespace itk
 {
 //----------------------------------------------------------------------
-//  Advance along the line
+//  Wrap to the beginning of the next row
 //----------------------------------------------------------------------
 template< class TImage >
-ImageRegionConstIteratorWithIndex< TImage > &
+void
 ImageRegionConstIteratorWithIndex< TImage >
-::operator++()
+::IncrementRow()
 {
+  // The index has moved past the end of the row along the first dimension.
+  this->m_Position -= this->m_OffsetTable[0]
+                      * ( static_cast< OffsetValueType >( this->m_Region.GetSize()[0] ) - 1 );
+  this->m_PositionIndex[0] = this->m_BeginIndex[0];
+
   this->m_Remaining = false;
-  for ( unsigned int in = 0; in < TImage::ImageDimension; in++ )
+  for ( unsigned int in = 1; in < TImage::ImageDimension; in++ )
     {
     this->m_PositionIndex[in]++;
     if ( this->m_PositionIndex[in] < this->m_EndIndex[in] )
@@ -52,20 +57,23 @@ ImageRegionConstIteratorWithIndex< TImage >
     {
     this->m_Position = this->m_End;
     }
-
-  return *this;
 }
 
 //----------------------------------------------------------------------
-//  Advance along the line in reverse direction
+//  Wrap to the end of the previous row
 //----------------------------------------------------------------------
 template< class TImage >
-ImageRegionConstIteratorWithIndex< TImage > &
+void
 ImageRegionConstIteratorWithIndex< TImage >
-::operator--()
+::DecrementRow()
 {
+  // The index is at the beginning of the row along the first dimension.
+  this->m_Position += this->m_OffsetTable[0]
+                      * ( static_cast< OffsetValueType >( this->m_Region.GetSize()[0] ) - 1 );
+  this->m_PositionIndex[0] = this->m_EndIndex[0] - 1;
+
   this->m_Remaining = false;
-  for ( unsigned int in = 0; in < TImage::ImageDimension; in++ )
+  for ( unsigned int in = 1; in < TImage::ImageDimension; in++ )
     {
     if ( this->m_PositionIndex[in] > this->m_BeginIndex[in] )
       {
@@ -86,8 +94,6 @@ ImageRegionConstIteratorWithIndex< TImage >
     {
     this->m_Position = this->m_End;
     }
-
-  return *this;
 }
 } // end namespace itk
 
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkImageRegionSpanIterator_h
+#define __itkImageRegionSpanIterator_h
+
+#include "itkImageRegion.h"
+
+namespace itk
+{
+/** \class ImageRegionSpanIterator
+ * \brief Walks a region as the longest spans of pixels that are
+ * contiguous in the buffers of the images it is read from or written to.
+ *
+ * The lines of the first dimension are always contiguous in an
+ * itk::Image.  When the region covers the whole buffered region of every
+ * image along the first dimension, consecutive lines follow each other in
+ * memory too and are merged into a single span, and so on for the
+ * following dimensions.  This lets pixel-wise filters run plain loops over
+ * raw pixel pointers, which the compiler can vectorize, even on images
+ * made of short lines.
+ *
+ * The buffered regions of all the images involved are passed to
+ * AddBufferedRegion() before GoToBegin().  All the spans have the same
+ * length.
+ *
+ * \code
+ * ImageRegionSpanIterator< ImageDimension > sit( region );
+ * sit.AddBufferedRegion( input->GetBufferedRegion() );
+ * sit.AddBufferedRegion( output->GetBufferedRegion() );
+ * for ( sit.GoToBegin(); !sit.IsAtEnd(); ++sit )
+ *   {
+ *   const InputPixelType *in = input->GetBufferPointer() + input->ComputeOffset( sit.GetIndex() );
+ *   OutputPixelType *out = output->GetBufferPointer() + output->ComputeOffset( sit.GetIndex() );
+ *   for ( SizeValueType i = 0; i < sit.GetSpanLength(); ++i ) { out[i] = f( in[i] ); }
+ *   }
+ * \endcode
+ *
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template< unsigned int VImageDimension >
+class ImageRegionSpanIterator
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageRegionSpanIterator Self;
+
+  typedef ImageRegion< VImageDimension > RegionType;
+  typedef Index< VImageDimension >       IndexType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, VImageDimension);
+
+  ImageRegionSpanIterator(const RegionType & region);
+
+  /** Only merge the lines that are contiguous in a buffer holding
+   * bufferedRegion, which must contain the region walked. */
+  void AddBufferedRegion(const RegionType & bufferedRegion);
+
+  /** Move to the first span. */
+  void GoToBegin();
+
+  /** Whether all the spans have been walked. */
+  bool IsAtEnd() const
+  { return m_IsAtEnd; }
+
+  /** Move to the next span. */
+  Self & operator++();
+
+  /** Index of the first pixel of the current span. */
+  const IndexType & GetIndex() const
+  { return m_Index; }
+
+  /** Number of pixels of each span. */
+  SizeValueType GetSpanLength() const
+  { return m_SpanLength; }
+
+  /** Number of spans of the region. */
+  SizeValueType GetNumberOfSpans() const;
+
+private:
+  /** Compute the span length from the merged dimensions. */
+  void ComputeSpanLength();
+
+  RegionType m_Region;
+
+  /** The dimensions below m_SpanDimension are merged into a span. */
+  unsigned int  m_SpanDimension;
+  SizeValueType m_SpanLength;
+  IndexType     m_Index;
+  bool          m_IsAtEnd;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkImageRegionSpanIterator.hxx"
+#endif
+
+#endif
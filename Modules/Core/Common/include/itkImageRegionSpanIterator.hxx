@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkImageRegionSpanIterator_hxx
+#define __itkImageRegionSpanIterator_hxx
+
+#include "itkImageRegionSpanIterator.h"
+
+namespace itk
+{
+template< unsigned int VImageDimension >
+ImageRegionSpanIterator< VImageDimension >
+::ImageRegionSpanIterator(const RegionType & region):
+  m_Region(region),
+  m_SpanDimension(VImageDimension)
+{
+  this->ComputeSpanLength();
+  this->GoToBegin();
+}
+
+template< unsigned int VImageDimension >
+void
+ImageRegionSpanIterator< VImageDimension >
+::AddBufferedRegion(const RegionType & bufferedRegion)
+{
+  // Lines of dimension d can be merged when the region covers the buffer
+  // along all the dimensions below d.
+  unsigned int spanDimension = 1;
+
+  while ( spanDimension < m_SpanDimension
+          && m_Region.GetSize(spanDimension - 1) == bufferedRegion.GetSize(spanDimension - 1) )
+    {
+    ++spanDimension;
+    }
+  m_SpanDimension = spanDimension;
+  this->ComputeSpanLength();
+}
+
+template< unsigned int VImageDimension >
+void
+ImageRegionSpanIterator< VImageDimension >
+::ComputeSpanLength()
+{
+  m_SpanLength = 1;
+  for ( unsigned int i = 0; i < m_SpanDimension; ++i )
+    {
+    m_SpanLength *= m_Region.GetSize(i);
+    }
+}
+
+template< unsigned int VImageDimension >
+void
+ImageRegionSpanIterator< VImageDimension >
+::GoToBegin()
+{
+  m_Index = m_Region.GetIndex();
+  m_IsAtEnd = ( m_Region.GetNumberOfPixels() == 0 );
+}
+
+template< unsigned int VImageDimension >
+ImageRegionSpanIterator< VImageDimension > &
+ImageRegionSpanIterator< VImageDimension >
+::operator++()
+{
+  unsigned int dim = m_SpanDimension;
+
+  for (; dim < VImageDimension; ++dim )
+    {
+    ++m_Index[dim];
+    if ( m_Index[dim] < m_Region.GetIndex(dim) + static_cast< IndexValueType >( m_Region.GetSize(dim) ) )
+      {
+      break;
+      }
+    m_Index[dim] = m_Region.GetIndex(dim);
+    }
+  if ( dim >= VImageDimension )
+    {
+    m_IsAtEnd = true;
+    }
+  return *this;
+}
+
+template< unsigned int VImageDimension >
+SizeValueType
+ImageRegionSpanIterator< VImageDimension >
+::GetNumberOfSpans() const
+{
+  return m_SpanLength > 0 ? m_Region.GetNumberOfPixels() / m_SpanLength : 0;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkImageScanlineConstIterator_h
+#define __itkImageScanlineConstIterator_h
+
+#include "itkImageConstIterator.h"
+
+namespace itk
+{
+/** \class ImageScanlineConstIterator
+ * \brief A multi-dimensional iterator templated over image type that walks
+ * a region of pixels line by line.
+ *
+ * ImageScanlineConstIterator replaces the single loop over the pixels of
+ * a region with two nested loops: the outer one over the lines of the
+ * first dimension, the inner one along each line.  Moving along a line is
+ * a single increment of the offset, and all the bookkeeping of the index
+ * is done once per line in NextLine(), so the inner loop is as tight as a
+ * loop over a raw buffer.  GetIndex() is computed from the index of the
+ * first pixel of the line without any division.
+ *
+ * \code
+ * ImageScanlineConstIterator< ImageType > it( image, region );
+ * while ( !it.IsAtEnd() )
+ *   {
+ *   while ( !it.IsAtEndOfLine() )
+ *     {
+ *     value = it.Get();
+ *     ++it;
+ *     }
+ *   it.NextLine();
+ *   }
+ * \endcode
+ *
+ * \ingroup ImageIterators
+ *
+ * \sa ImageScanlineIterator \sa ImageRegionConstIterator
+ * \sa ImageRegionConstIteratorWithIndex \sa ImageLinearConstIteratorWithIndex
+ * \ingroup ITKCommon
+ */
+template< typename TImage >
+class ITK_EXPORT ImageScanlineConstIterator:public ImageConstIterator< TImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageScanlineConstIterator   Self;
+  typedef ImageConstIterator< TImage > Superclass;
+
+  /** Dimension of the image that the iterator walks. */
+  itkStaticConstMacro(ImageIteratorDimension, unsigned int,
+                      Superclass::ImageIteratorDimension);
+
+  /** Types inherited from the Superclass */
+  typedef typename Superclass::IndexType             IndexType;
+  typedef typename Superclass::SizeType              SizeType;
+  typedef typename Superclass::OffsetType            OffsetType;
+  typedef typename Superclass::RegionType            RegionType;
+  typedef typename Superclass::ImageType             ImageType;
+  typedef typename Superclass::PixelContainer        PixelContainer;
+  typedef typename Superclass::PixelContainerPointer PixelContainerPointer;
+  typedef typename Superclass::InternalPixelType     InternalPixelType;
+  typedef typename Superclass::PixelType             PixelType;
+  typedef typename Superclass::AccessorType          AccessorType;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageScanlineConstIterator, ImageConstIterator);
+
+  /** Default constructor. Needed since we provide a cast constructor. */
+  ImageScanlineConstIterator();
+
+  /** Constructor establishes an iterator to walk a particular image and a
+   * particular region of that image. */
+  ImageScanlineConstIterator(const ImageType *ptr, const RegionType & region);
+
+  /** Set the region of the image to iterate over, and move to its first
+   * pixel. */
+  virtual void SetRegion(const RegionType & region);
+
+  /** Move the iterator to the first pixel of the region. */
+  void GoToBegin();
+
+  /** Move the iterator past the last pixel of the region. */
+  void GoToEnd();
+
+  /** Whether the iterator is past the last pixel of the current line. */
+  bool IsAtEndOfLine(void) const
+  {
+    return this->m_Offset >= m_SpanEndOffset;
+  }
+
+  /** Move the iterator to the first pixel of the next line, or past the
+   * end of the region after the last line. */
+  void NextLine();
+
+  /** Index of the current pixel, computed from the index of the first
+   * pixel of the line. */
+  IndexType GetIndex() const
+  {
+    IndexType ind = m_LineIndex;
+    ind[0] += static_cast< IndexValueType >( this->m_Offset - m_SpanBeginOffset );
+    return ind;
+  }
+
+  /** Move the iterator to a pixel of the region. */
+  void SetIndex(const IndexType & ind);
+
+  /** Move to the next pixel of the line.  The iterator must not be at the
+   * end of the line. */
+  Self & operator++()
+  {
+    ++this->m_Offset;
+    return *this;
+  }
+
+  /** Move to the previous pixel of the line.  The iterator must not be at
+   * the beginning of the line. */
+  Self & operator--()
+  {
+    --this->m_Offset;
+    return *this;
+  }
+
+protected:
+  /** Offsets of the first pixel of the current line and of the pixel
+   * following its last pixel. */
+  OffsetValueType m_SpanBeginOffset;
+  OffsetValueType m_SpanEndOffset;
+
+  /** Index of the first pixel of the current line. */
+  IndexType m_LineIndex;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkImageScanlineConstIterator.hxx"
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkImageScanlineConstIterator_hxx
+#define __itkImageScanlineConstIterator_hxx
+
+#include "itkImageScanlineConstIterator.h"
+
+namespace itk
+{
+template< typename TImage >
+ImageScanlineConstIterator< TImage >
+::ImageScanlineConstIterator():
+  ImageConstIterator< TImage >(),
+  m_SpanBeginOffset(0),
+  m_SpanEndOffset(0)
+{
+  m_LineIndex.Fill(0);
+}
+
+template< typename TImage >
+ImageScanlineConstIterator< TImage >
+::ImageScanlineConstIterator(const ImageType *ptr, const RegionType & region):
+  ImageConstIterator< TImage >(ptr, region)
+{
+  this->GoToBegin();
+}
+
+template< typename TImage >
+void
+ImageScanlineConstIterator< TImage >
+::SetRegion(const RegionType & region)
+{
+  Superclass::SetRegion(region);
+  this->GoToBegin();
+}
+
+template< typename TImage >
+void
+ImageScanlineConstIterator< TImage >
+::GoToBegin()
+{
+  this->m_Offset = this->m_BeginOffset;
+  m_LineIndex = this->m_Region.GetIndex();
+  m_SpanBeginOffset = this->m_BeginOffset;
+  if ( this->m_Region.GetNumberOfPixels() > 0 )
+    {
+    m_SpanEndOffset = m_SpanBeginOffset
+                      + static_cast< OffsetValueType >( this->m_Region.GetSize()[0] );
+    }
+  else
+    {
+    m_SpanEndOffset = m_SpanBeginOffset;
+    }
+}
+
+template< typename TImage >
+void
+ImageScanlineConstIterator< TImage >
+::GoToEnd()
+{
+  this->m_Offset = this->m_EndOffset;
+  m_SpanBeginOffset = this->m_EndOffset;
+  m_SpanEndOffset = this->m_EndOffset;
+}
+
+template< typename TImage >
+void
+ImageScanlineConstIterator< TImage >
+::NextLine()
+{
+  const IndexType & startIndex = this->m_Region.GetIndex();
+  const SizeType &  size = this->m_Region.GetSize();
+
+  // Carry the increment of the index of the line over the dimensions
+  // above the first one.
+  for ( unsigned int i = 1; i < ImageIteratorDimension; ++i )
+    {
+    if ( ++m_LineIndex[i] < startIndex[i] + static_cast< IndexValueType >( size[i] ) )
+      {
+      m_SpanBeginOffset = this->m_Image->ComputeOffset(m_LineIndex);
+      m_SpanEndOffset = m_SpanBeginOffset + static_cast< OffsetValueType >( size[0] );
+      this->m_Offset = m_SpanBeginOffset;
+      return;
+      }
+    m_LineIndex[i] = startIndex[i];
+    }
+
+  // That was the last line of the region.
+  this->GoToEnd();
+}
+
+template< typename TImage >
+void
+ImageScanlineConstIterator< TImage >
+::SetIndex(const IndexType & ind)
+{
+  this->m_Offset = this->m_Image->ComputeOffset(ind);
+  m_LineIndex = ind;
+  m_LineIndex[0] = this->m_Region.GetIndex()[0];
+  m_SpanBeginOffset = this->m_Offset - static_cast< OffsetValueType >( ind[0] - m_LineIndex[0] );
+  m_SpanEndOffset = m_SpanBeginOffset + static_cast< OffsetValueType >( this->m_Region.GetSize()[0] );
+}
+} // end namespace itk
+
+#endif
@@ -30,6 +30,7 @@
 
 #include "itkProcessObject.h"
 #include "itkImage.h"
+#include "itkSimpleFastMutexLock.h"
 
 namespace itk
 {
@@ -209,9 +210,43 @@ public:
   using Superclass::MakeOutput;
   virtual ProcessObject::DataObjectPointer MakeOutput(ProcessObject::DataObjectPointerArraySizeType idx);
 
+  /** Set/Get whether GenerateData() splits the output requested region
+   * into many more pieces than threads, each thread taking the next
+   * unprocessed piece as soon as it is done with the previous one.  This
+   * balances the load of filters whose cost per pixel varies across the
+   * image.  ThreadedGenerateData() is then called several times per
+   * thread, always with the threadId of the calling thread, so this must
+   * only be turned on for filters that accumulate their per-thread
+   * results instead of overwriting them.  A ProgressReporter created in
+   * ThreadedGenerateData() then reports the progress of the current
+   * piece.  Off by default. */
+  itkSetMacro(DynamicMultiThreading, bool);
+  itkGetConstMacro(DynamicMultiThreading, bool);
+  itkBooleanMacro(DynamicMultiThreading);
+
+  /** Set/Get the approximate minimum number of pixels of the pieces
+   * processed when DynamicMultiThreading is on.  The default, zero,
+   * splits the requested region into a fixed number of pieces per
+   * thread. */
+  itkSetMacro(GrainSize, SizeValueType);
+  itkGetConstMacro(GrainSize, SizeValueType);
+
+  /** Set/Get whether GenerateData() lets each thread write to the memory
+   * pages of its part of the outputs right after they are allocated, and
+   * before BeforeThreadedGenerateData() is called.  The outputs are split
+   * with SplitRequestedRegion(), as for ThreadedGenerateData(), so on NUMA
+   * systems each thread then produces pixels stored on its own memory
+   * node.  This is most effective together with
+   * MultiThreader::SetUseThreadAffinity(), and is of no use with
+   * DynamicMultiThreading.  Off by default. */
+  itkSetMacro(FirstTouchOutputs, bool);
+  itkGetConstMacro(FirstTouchOutputs, bool);
+  itkBooleanMacro(FirstTouchOutputs);
+
 protected:
   ImageSource();
   virtual ~ImageSource() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
 
   /** A version of GenerateData() specific for image processing
    * filters.  This implementation will split the processing across
@@ -263,6 +298,11 @@ protected:
    * grafting its input to its output. */
   virtual void AllocateOutputs();
 
+  /** Write to the pages of the output buffers from the threads that will
+   * generate them.  Called by GenerateData() after AllocateOutputs() when
+   * FirstTouchOutputs is on. */
+  virtual void FirstTouchOutputs();
+
   /** If an imaging filter needs to perform processing after the buffer
    * has been allocated but before threads are spawned, the filter can
    * can provide an implementation for BeforeThreadedGenerateData(). The
@@ -305,9 +345,34 @@ protected:
   struct ThreadStruct {
     Pointer Filter;
   };
+
+  /** Number of pieces per thread requested from SplitRequestedRegion() when
+   * DynamicMultiThreading is on and GrainSize is zero. */
+  itkStaticConstMacro(DynamicPiecesPerThread, unsigned int, 16);
+
+  /** Callback used instead of ThreaderCallback() when DynamicMultiThreading
+   * is on.  Each thread repeatedly takes the next unprocessed piece and
+   * passes it to ThreadedGenerateData() with its own threadId. */
+  static ITK_THREAD_RETURN_TYPE DynamicThreaderCallback(void *arg);
+
+  /** Callback used by FirstTouchOutputs(). */
+  static ITK_THREAD_RETURN_TYPE FirstTouchThreaderCallback(void *arg);
+
+  /** Internal structure shared by the threads of DynamicThreaderCallback(). */
+  struct DynamicThreadStruct {
+    Pointer             Filter;
+    unsigned int        NumberOfRequestedPieces;
+    unsigned int        NumberOfPieces;
+    unsigned int        NextPiece;
+    SimpleFastMutexLock NextPieceLock;
+  };
 private:
   ImageSource(const Self &);    //purposely not implemented
   void operator=(const Self &); //purposely not implemented
+
+  bool          m_DynamicMultiThreading;
+  SizeValueType m_GrainSize;
+  bool          m_FirstTouchOutputs;
 };
 } // end namespace itk
 
@@ -30,6 +30,7 @@
 #include "itkImageSource.h"
 
 #include "itkOutputDataObjectIterator.h"
+#include "itkPipelineTracer.h"
 
 #include "vnl/vnl_math.h"
 
@@ -53,6 +54,10 @@ ImageSource< TOutputImage >
   // output bulk data prior to GenerateData() in case that bulk data
   // can be reused (an thus avoid a costly deallocate/allocate cycle).
   this->ReleaseDataBeforeUpdateFlagOff();
+
+  m_DynamicMultiThreading = false;
+  m_GrainSize = 0;
+  m_FirstTouchOutputs = false;
 }
 
 /**
@@ -239,11 +244,27 @@ ImageSource< TOutputImage >
     if ( outputPtr )
       {
       outputPtr->SetBufferedRegion( outputPtr->GetRequestedRegion() );
-      outputPtr->Allocate();
+      // The filter writes every pixel of its output, so the buffer is not
+      // initialized.
+      outputPtr->Allocate(false);
       }
     }
 }
 
+//----------------------------------------------------------------------------
+template< class TOutputImage >
+void
+ImageSource< TOutputImage >
+::FirstTouchOutputs()
+{
+  ThreadStruct str;
+  str.Filter = this;
+
+  this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+  this->GetMultiThreader()->SetSingleMethod(this->FirstTouchThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
 //----------------------------------------------------------------------------
 template< class TOutputImage >
 void
@@ -252,7 +273,15 @@ ImageSource< TOutputImage >
 {
   // Call a method that can be overriden by a subclass to allocate
   // memory for the filter's outputs
+  {
+  PipelineTracer::Scope traceScope("AllocateOutputs", "memory", this);
   this->AllocateOutputs();
+  }
+
+  if ( m_FirstTouchOutputs )
+    {
+    this->FirstTouchOutputs();
+    }
 
   // Call a method that can be overridden by a subclass to perform
   // some calculations prior to splitting the main computations into
@@ -260,14 +289,45 @@ ImageSource< TOutputImage >
   this->BeforeThreadedGenerateData();
 
   // Set up the multithreaded processing
-  ThreadStruct str;
-  str.Filter = this;
-
   this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
-  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
 
-  // multithread the execution
-  this->GetMultiThreader()->SingleMethodExecute();
+  if ( m_DynamicMultiThreading )
+    {
+    // Over-decompose the requested region; the threads take the pieces
+    // one at a time.
+    const ThreadIdType numberOfThreads = this->GetMultiThreader()->GetNumberOfThreads();
+    unsigned int       numberOfPieces = numberOfThreads * DynamicPiecesPerThread;
+    if ( m_GrainSize > 0 )
+      {
+      const SizeValueType numberOfPixels =
+        this->GetOutput()->GetRequestedRegion().GetNumberOfPixels();
+      numberOfPieces = static_cast< unsigned int >(
+        std::min( std::max( numberOfPixels / m_GrainSize,
+                            static_cast< SizeValueType >( numberOfThreads ) ),
+                  static_cast< SizeValueType >( NumericTraits< unsigned int >::max() ) ) );
+      }
+
+    DynamicThreadStruct dynamicStr;
+    dynamicStr.Filter = this;
+    dynamicStr.NumberOfRequestedPieces = numberOfPieces;
+    dynamicStr.NextPiece = 0;
+
+    OutputImageRegionType splitRegion;
+    dynamicStr.NumberOfPieces = this->SplitRequestedRegion(0, numberOfPieces, splitRegion);
+
+    this->GetMultiThreader()->SetSingleMethod(this->DynamicThreaderCallback, &dynamicStr);
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+  else
+    {
+    ThreadStruct str;
+    str.Filter = this;
+
+    this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+
+    // multithread the execution
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
 
   // Call a method that can be overridden by a subclass to perform
   // some calculations after all the threads have completed
@@ -320,6 +380,7 @@ ImageSource< TOutputImage >
 
   if ( threadId < total )
     {
+    PipelineTracer::Scope traceScope("ThreadedGenerateData", "thread", str->Filter.GetPointer());
     str->Filter->ThreadedGenerateData(splitRegion, threadId);
     }
   // else
@@ -331,6 +392,87 @@ ImageSource< TOutputImage >
 
   return ITK_THREAD_RETURN_VALUE;
 }
+
+// Callback routine used by the threading library when the requested region
+// is scheduled dynamically. Each thread keeps taking the next piece of the
+// over-decomposed region until none are left.
+template< class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+ImageSource< TOutputImage >
+::DynamicThreaderCallback(void *arg)
+{
+  const ThreadIdType threadId = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->ThreadID;
+
+  DynamicThreadStruct *str =
+    (DynamicThreadStruct *)( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
+
+  PipelineTracer::Scope traceScope("ThreadedGenerateData", "thread", str->Filter.GetPointer());
+
+  typename TOutputImage::RegionType splitRegion;
+  while ( true )
+    {
+    str->NextPieceLock.Lock();
+    const unsigned int piece = str->NextPiece++;
+    str->NextPieceLock.Unlock();
+
+    if ( piece >= str->NumberOfPieces || str->Filter->GetAbortGenerateData() )
+      {
+      break;
+      }
+
+    str->Filter->SplitRequestedRegion(piece, str->NumberOfRequestedPieces, splitRegion);
+    str->Filter->ThreadedGenerateData(splitRegion, threadId);
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+// Callback routine used by the threading library to touch the part of the
+// outputs that the same thread will then generate.
+template< class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+ImageSource< TOutputImage >
+::FirstTouchThreaderCallback(void *arg)
+{
+  typedef ImageBase< OutputImageDimension > ImageBaseType;
+
+  const ThreadIdType threadId = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->ThreadID;
+  const ThreadIdType threadCount = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->NumberOfThreads;
+
+  ThreadStruct *str = (ThreadStruct *)( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
+
+  typename TOutputImage::RegionType splitRegion;
+  const ThreadIdType total = str->Filter->SplitRequestedRegion(threadId, threadCount, splitRegion);
+
+  if ( threadId < total )
+    {
+    for ( OutputDataObjectIterator it( str->Filter.GetPointer() ); !it.IsAtEnd(); it++ )
+      {
+      ImageBaseType *outputPtr = dynamic_cast< ImageBaseType * >( it.GetOutput() );
+
+      // Outputs with another size than the first one are not split
+      // like it, they are left to the first thread that writes to them.
+      if ( outputPtr && outputPtr->GetBufferedRegion().IsInside(splitRegion) )
+        {
+        outputPtr->FirstTouch(splitRegion);
+        }
+      }
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< class TOutputImage >
+void
+ImageSource< TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "DynamicMultiThreading: " << m_DynamicMultiThreading << std::endl;
+  os << indent << "GrainSize: " << m_GrainSize << std::endl;
+  os << indent << "FirstTouchOutputs: " << m_FirstTouchOutputs << std::endl;
+}
 } // end namespace itk
 
 #endif
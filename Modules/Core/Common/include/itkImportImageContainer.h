@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocator.h"
 #include <utility>
 
 namespace itk
@@ -105,8 +106,14 @@ public:
    * container. However, in this particular case, Reserve as a Resize
    * semantics that is kept for backward compatibility reasons.
    *
+   * If UseDefaultConstructor is true, all the elements are
+   * value-initialized (zero for the scalar types) and the old contents
+   * are discarded.  Otherwise newly allocated elements are left
+   * uninitialized, which avoids touching every page of a buffer that is
+   * about to be overwritten.
+   *
    * \sa SetImportPointer() */
-  void Reserve(ElementIdentifier num);
+  void Reserve(ElementIdentifier num, const bool UseDefaultConstructor = false);
 
   /** Tell the container to try to minimize its memory usage for
    * storage of the current number of elements.  If new memory is
@@ -140,7 +147,14 @@ protected:
    * call this method but should call Print() instead. */
   void PrintSelf(std::ostream & os, Indent indent) const;
 
-  virtual TElement * AllocateElements(ElementIdentifier size) const;
+  /** Allocate the elements of the buffer with ImageBufferAllocator, so
+   * that the buffer is aligned for vectorized access.  The elements are
+   * value-initialized if UseDefaultConstructor is true, and
+   * default-initialized (not initialized for the scalar types) otherwise.
+   * Subclasses that override this method must also override
+   * DeallocateManagedMemory(). */
+  virtual TElement * AllocateElements(ElementIdentifier size,
+                                      bool UseDefaultConstructor = false) const;
 
   virtual void DeallocateManagedMemory();
 
@@ -173,6 +187,10 @@ private:
   TElementIdentifier m_Size;
   TElementIdentifier m_Capacity;
   bool               m_ContainerManageMemory;
+
+  /** True when m_ImportPointer was returned by AllocateElements() rather
+   * than passed to SetImportPointer(). */
+  bool m_MemoryAllocatedByContainer;
 };
 } // end namespace itk
 
@@ -31,7 +31,7 @@
 #include "itkImportImageContainer.h"
 #include <cstring>
 #include <cstdlib>
-#include <cstring>
+#include <new>
 
 namespace itk
 {
@@ -43,6 +43,7 @@ ImportImageContainer< TElementIdentifier, TElement >
   m_ContainerManageMemory = true;
   m_Capacity = 0;
   m_Size = 0;
+  m_MemoryAllocatedByContainer = false;
 }
 
 template< typename TElementIdentifier, typename TElement >
@@ -59,7 +60,7 @@ ImportImageContainer< TElementIdentifier, TElement >
 template< typename TElementIdentifier, typename TElement >
 void
 ImportImageContainer< TElementIdentifier, TElement >
-::Reserve(ElementIdentifier size)
+::Reserve(ElementIdentifier size, const bool UseDefaultConstructor)
 {
   // Reserve has a Resize semantics. We keep it that way for
   // backwards compatibility .
@@ -68,30 +69,50 @@ ImportImageContainer< TElementIdentifier, TElement >
     {
     if ( size > m_Capacity )
       {
-      TElement *temp = this->AllocateElements(size);
-      // only copy the portion of the data used in the old buffer
-      memcpy( temp, m_ImportPointer, m_Size * sizeof( TElement ) );
+      TElement *temp;
+      if ( UseDefaultConstructor )
+        {
+        // The old contents are replaced anyway, do not copy them.
+        DeallocateManagedMemory();
+        temp = this->AllocateElements(size, true);
+        }
+      else
+        {
+        temp = this->AllocateElements(size, false);
+        // only copy the portion of the data used in the old buffer
+        memcpy( temp, m_ImportPointer, m_Size * sizeof( TElement ) );
 
-      DeallocateManagedMemory();
+        DeallocateManagedMemory();
+        }
 
       m_ImportPointer = temp;
       m_ContainerManageMemory = true;
+      m_MemoryAllocatedByContainer = true;
       m_Capacity = size;
       m_Size = size;
       this->Modified();
       }
     else
       {
+      if ( UseDefaultConstructor )
+        {
+        const TElement zero = TElement();
+        for ( ElementIdentifier i = 0; i < size; ++i )
+          {
+          m_ImportPointer[i] = zero;
+          }
+        }
       m_Size = size;
       this->Modified();
       }
     }
   else
     {
-    m_ImportPointer = this->AllocateElements(size);
+    m_ImportPointer = this->AllocateElements(size, UseDefaultConstructor);
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
+    m_MemoryAllocatedByContainer = true;
     this->Modified();
     }
 }
@@ -110,13 +131,14 @@ ImportImageContainer< TElementIdentifier, TElement >
     if ( m_Size < m_Capacity )
       {
       const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size);
+      TElement *               temp = this->AllocateElements(size, false);
       memcpy( temp, m_ImportPointer, size * sizeof( TElement ) );
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
       m_ContainerManageMemory = true;
+      m_MemoryAllocatedByContainer = true;
       m_Capacity = size;
       m_Size = size;
 
@@ -161,6 +183,7 @@ ImportImageContainer< TElementIdentifier, TElement >
   DeallocateManagedMemory();
   m_ImportPointer = ptr;
   m_ContainerManageMemory = LetContainerManageMemory;
+  m_MemoryAllocatedByContainer = false;
   m_Capacity = num;
   m_Size = num;
 
@@ -169,21 +192,14 @@ ImportImageContainer< TElementIdentifier, TElement >
 
 template< typename TElementIdentifier, typename TElement >
 TElement *ImportImageContainer< TElementIdentifier, TElement >
-::AllocateElements(ElementIdentifier size) const
+::AllocateElements(ElementIdentifier size, bool UseDefaultConstructor) const
 {
   // Encapsulate all image memory allocation here to throw an
   // exception when memory allocation fails even when the compiler
   // does not do this by default.
-  TElement *data;
+  TElement *data = static_cast< TElement * >(
+    ImageBufferAllocator::Allocate( static_cast< SizeValueType >( size ) * sizeof( TElement ) ) );
 
-  try
-    {
-    data = new TElement[size];
-    }
-  catch ( ... )
-    {
-    data = 0;
-    }
   if ( !data )
     {
     // We cannot construct an error string here because we may be out
@@ -192,6 +208,24 @@ TElement *ImportImageContainer< TElementIdentifier, TElement >
                                 "Failed to allocate memory for image.",
                                 ITK_LOCATION);
     }
+
+  // Construct the elements in place.  Default-initialization leaves the
+  // scalar pixels untouched, so that the pages of the buffer are first
+  // written by the threads that fill the image.
+  if ( UseDefaultConstructor )
+    {
+    for ( ElementIdentifier i = 0; i < size; ++i )
+      {
+      new( data + i ) TElement();
+      }
+    }
+  else
+    {
+    for ( ElementIdentifier i = 0; i < size; ++i )
+      {
+      new( data + i ) TElement;
+      }
+    }
   return data;
 }
 
@@ -202,11 +236,23 @@ void ImportImageContainer< TElementIdentifier, TElement >
   // Encapsulate all image memory deallocation here
   if ( m_ImportPointer && m_ContainerManageMemory )
     {
-    delete[] m_ImportPointer;
+    if ( m_MemoryAllocatedByContainer )
+      {
+      for ( TElementIdentifier i = 0; i < m_Capacity; ++i )
+        {
+        m_ImportPointer[i].~TElement();
+        }
+      ImageBufferAllocator::Free(m_ImportPointer);
+      }
+    else
+      {
+      delete[] m_ImportPointer;
+      }
     }
   m_ImportPointer = 0;
   m_Capacity = 0;
   m_Size = 0;
+  m_MemoryAllocatedByContainer = false;
 }
 
 template< typename TElementIdentifier, typename TElement >
@@ -219,6 +265,8 @@ ImportImageContainer< TElementIdentifier, TElement >
   os << indent << "Pointer: " << static_cast< void * >( m_ImportPointer ) << std::endl;
   os << indent << "Container manages memory: "
      << ( m_ContainerManageMemory ? "true" : "false" ) << std::endl;
+  os << indent << "Memory allocated by container: "
+     << ( m_MemoryAllocatedByContainer ? "true" : "false" ) << std::endl;
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
 }
@@ -104,7 +104,10 @@ public:
    * in-place operation, i.e. calling SetInplace(true) or InplaceOn(),
    * will be effective only if CanRunInPlace also returns true.
    * By default CanRunInPlace checks whether the input and output
-   * image type match. */
+   * image type match.  The flag is ignored when AutomaticInPlace is on:
+   * the filter then runs in place exactly when the pipeline found that
+   * nothing else reads its first input.
+   * \sa ProcessObject::SetAutomaticInPlace() */
   itkSetMacro(InPlace, bool);
   itkGetConstMacro(InPlace, bool);
   itkBooleanMacro(InPlace);
@@ -159,6 +162,14 @@ protected:
    */
   itkGetConstMacro(RunningInPlace,bool);
 
+  /** Return true if AllocateOutputs() is going to graft the first input
+   * to the output: the filter can run in place, the buffered region of
+   * the input matches the requested region of the output, and either
+   * InPlace is on or, with AutomaticInPlace, the first input is
+   * releasable.  Valid once the requested regions are propagated, e.g.
+   * in GenerateData() before AllocateOutputs() is called. */
+  bool WillRunInPlace() const;
+
 private:
   InPlaceImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);     //purposely not implemented
@@ -70,39 +70,54 @@ InPlaceImageFilter< TInputImage, TOutputImage >
 }
 
 template< class TInputImage, class TOutputImage >
-void
+bool
 InPlaceImageFilter< TInputImage, TOutputImage >
-::InternalAllocateOutputs( const TrueType& )
+::WillRunInPlace() const
 {
-  const InputImageType *inputPtr = this->GetInput(0);
-  OutputImageType      *outputPtr = this->GetOutput();
+  if ( !this->CanRunInPlace() )
+    {
+    return false;
+    }
 
-  // if told to run in place and the types support it,
-  // additionally the buffered and requested regions of the input and
-  // output must match.
-  bool rMatch = true;
-  if( inputPtr != NULL && (unsigned int)InputImageDimension == (unsigned int)OutputImageDimension )
+  const InputImageType  *inputPtr = this->GetInput(0);
+  const OutputImageType *outputPtr = this->GetOutput();
+
+  // The buffered and requested regions of the input and output must
+  // match.
+  if( inputPtr == NULL || (unsigned int)InputImageDimension != (unsigned int)OutputImageDimension )
+    {
+    return false;
+    }
+  for( unsigned int i=0; i<(unsigned int)InputImageDimension; i++ )
     {
-    for( unsigned int i=0; i<(unsigned int)InputImageDimension; i++ )
+    if( inputPtr->GetBufferedRegion().GetIndex(i) != outputPtr->GetRequestedRegion().GetIndex(i) )
       {
-      if( inputPtr->GetBufferedRegion().GetIndex(i) != outputPtr->GetRequestedRegion().GetIndex(i) )
-        {
-        rMatch = false;
-        }
-      if( inputPtr->GetBufferedRegion().GetSize(i) != outputPtr->GetRequestedRegion().GetSize(i) )
-        {
-        rMatch = false;
-        }
+      return false;
+      }
+    if( inputPtr->GetBufferedRegion().GetSize(i) != outputPtr->GetRequestedRegion().GetSize(i) )
+      {
+      return false;
       }
     }
-  else
+
+  if ( this->GetAutomaticInPlace() )
     {
-    rMatch = false;
+    return this->IsInputReleasable(0);
     }
-  if ( this->GetInPlace() &&
-       this->CanRunInPlace() &&
-       rMatch )
+  return this->GetInPlace();
+}
+
+template< class TInputImage, class TOutputImage >
+void
+InPlaceImageFilter< TInputImage, TOutputImage >
+::InternalAllocateOutputs( const TrueType& )
+{
+  const InputImageType *inputPtr = this->GetInput(0);
+
+  if ( this->WillRunInPlace() )
     {
+    itkDebugMacro("Running in place: the output reuses the bulk data of the first input");
+
     // Graft this first input to the output.  Later, we'll need to
     // remove the input's hold on the bulk data.
     //
@@ -131,7 +146,7 @@ InPlaceImageFilter< TInputImage, TOutputImage >
       if ( nthOutputPtr )
         {
         nthOutputPtr->SetBufferedRegion( nthOutputPtr->GetRequestedRegion() );
-        nthOutputPtr->Allocate();
+        nthOutputPtr->Allocate(false);
         }
       // if the output is not of similar type then it is assumed the
       // the derived class allocated the output if needed.
@@ -140,6 +155,7 @@ InPlaceImageFilter< TInputImage, TOutputImage >
     }
   else
     {
+    itkDebugMacro("Not running in place: allocating the output");
     this->m_RunningInPlace = false;
     Superclass::AllocateOutputs();
     }
@@ -42,6 +42,9 @@ namespace itk
  * supporting POSIX threads.  This class can be used to execute a single
  * method on multiple threads, or to specify a method per thread.
  *
+ * When UseThreadPool is on, SingleMethodExecute() runs the threads on the
+ * persistent workers of the process-wide ThreadPool instead.
+ *
  * \ingroup OSSystemObjects
  *
  * If ITK_USE_PTHREADS is defined, then
@@ -89,6 +92,37 @@ public:
 
   static ThreadIdType  GetGlobalDefaultNumberOfThreads();
 
+  /** Set/Get whether SingleMethodExecute() runs the threads on the
+   * process-wide ThreadPool instead of creating and joining new threads
+   * each time.  The thread ids seen by the SingleMethod are unchanged. */
+  itkSetMacro(UseThreadPool, bool);
+  itkGetConstMacro(UseThreadPool, bool);
+  itkBooleanMacro(UseThreadPool);
+
+  /** Set/Get the value which is used to initialize UseThreadPool in the
+   * constructor.  Unless it is set explicitly, it is read from the
+   * ITK_USE_THREADPOOL environment variable and defaults to false. */
+  static void SetGlobalDefaultUseThreadPool(bool flag);
+
+  static bool GetGlobalDefaultUseThreadPool();
+
+  /** Set/Get whether the threads started by SingleMethodExecute() are
+   * pinned to a processor.  Thread i runs on processor (i modulo the
+   * number of processors available to the process), so that on NUMA
+   * systems a thread keeps accessing the memory it first touched, see
+   * ImageSource::SetFirstTouchOutputs().  The calling thread, which runs
+   * the method with ThreadID 0, is left to the scheduler. */
+  itkSetMacro(UseThreadAffinity, bool);
+  itkGetConstMacro(UseThreadAffinity, bool);
+  itkBooleanMacro(UseThreadAffinity);
+
+  /** Set/Get the value which is used to initialize UseThreadAffinity in
+   * the constructor.  Unless it is set explicitly, it is read from the
+   * ITK_USE_THREAD_AFFINITY environment variable and defaults to false. */
+  static void SetGlobalDefaultUseThreadAffinity(bool flag);
+
+  static bool GetGlobalDefaultUseThreadAffinity();
+
   /** Execute the SingleMethod (as define by SetSingleMethod) using
    * m_NumberOfThreads threads. As a side effect the m_NumberOfThreads will be
    * checked against the current m_GlobalMaximumNumberOfThreads and clamped if
@@ -185,6 +219,16 @@ private:
    */
   static ThreadIdType m_GlobalDefaultNumberOfThreads;
 
+  /** Global variable defining the default value of m_UseThreadPool, and
+   * whether it has been initialized, either explicitly or from the
+   * environment. */
+  static bool m_GlobalDefaultUseThreadPool;
+  static bool m_GlobalDefaultUseThreadPoolIsInitialized;
+
+  /** Same for m_UseThreadAffinity. */
+  static bool m_GlobalDefaultUseThreadAffinity;
+  static bool m_GlobalDefaultUseThreadAffinityIsInitialized;
+
   /**  Platform specific number of threads */
   static ThreadIdType  GetGlobalDefaultNumberOfThreadsByPlatform();
 
@@ -199,6 +243,12 @@ private:
    */
   ThreadIdType m_NumberOfThreads;
 
+  /** Whether SingleMethodExecute() dispatches into the ThreadPool. */
+  bool m_UseThreadPool;
+
+  /** Whether the threads of SingleMethodExecute() are pinned. */
+  bool m_UseThreadAffinity;
+
   /** Static function used as a "proxy callback" by the MultiThreader.  The
    * threading library will call this routine for each thread, which
    * will delegate the control to the prescribed SingleMethod. This
@@ -207,6 +257,15 @@ private:
    * exceptions thrown by the threads. */
   static ITK_THREAD_RETURN_TYPE SingleMethodProxy(void *arg);
 
+  /** Proxy used instead of SingleMethodProxy() when UseThreadAffinity is
+   * on.  It pins the calling thread before delegating to
+   * SingleMethodProxy(). */
+  static ITK_THREAD_RETURN_TYPE SingleMethodAffinityProxy(void *arg);
+
+  /** Platform specific pinning of the calling thread to the processor
+   * assigned to threadId.  Does nothing where it is not supported. */
+  static void SetCurrentThreadAffinity(ThreadIdType threadId);
+
   /** Spawn a thread for the prescribed SingleMethod.  This routine
    * spawns a thread to the SingleMethodProxy which runs the
    * prescribed SingleMethod.  The SingleMethodProxy allows for
@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkNeighborhoodRegionWalker_h
+#define __itkNeighborhoodRegionWalker_h
+
+#include "itkConstNeighborhoodIterator.h"
+#include "itkProgressReporter.h"
+#include <vector>
+
+namespace itk
+{
+/** \class NeighborhoodRegionWalker
+ * \brief Computes an output pixel from the neighborhood of each input
+ * pixel of a region, checking the image boundary only where needed.
+ *
+ * The region is split with NeighborhoodAlgorithm::ImageBoundaryFacesCalculator.
+ * In the interior face, the neighbors are read through precomputed
+ * offsets from a pointer to the center pixel, which moves along the
+ * lines of the first dimension, so no boundary condition is involved.
+ * The boundary faces are walked with a ConstNeighborhoodIterator and
+ * TBoundaryCondition.
+ *
+ * Two kinds of computations are supported:
+ * - ComputeFromNeighborhoods() hands all the values of the neighborhood
+ *   to a function, for order statistics such as the median;
+ * - ComputeFromSlidingWindow() feeds an accumulator with Add() and
+ *   Remove(), for sums and counts.  In the interior face, moving the
+ *   center one pixel along a line only removes the values leaving the
+ *   window and adds the ones entering it, instead of visiting the whole
+ *   neighborhood again.
+ *
+ * The function and the accumulator return the value written to the
+ * output pixel of the same index.  The function is called as
+ * function(values), values being a std::vector of the input pixels of
+ * the neighborhood in the order of ConstNeighborhoodIterator, which it
+ * may reorder.  The accumulator provides Reset(), Add(pixel),
+ * Remove(pixel), and GetValue(centerPixel).
+ *
+ * \code
+ * NeighborhoodRegionWalker< InputImageType > walker( input, radius );
+ * walker.ComputeFromSlidingWindow( output, outputRegionForThread, accumulator, progress );
+ * \endcode
+ *
+ * \sa NeighborhoodAlgorithm::ImageBoundaryFacesCalculator
+ * \sa ConstNeighborhoodIterator
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template< class TInputImage,
+          class TBoundaryCondition = ZeroFluxNeumannBoundaryCondition< TInputImage > >
+class NeighborhoodRegionWalker
+{
+public:
+  /** Standard class typedefs. */
+  typedef NeighborhoodRegionWalker Self;
+
+  typedef TInputImage                                     InputImageType;
+  typedef TBoundaryCondition                              BoundaryConditionType;
+  typedef typename InputImageType::PixelType              InputPixelType;
+  typedef typename InputImageType::InternalPixelType      InputInternalPixelType;
+  typedef typename InputImageType::RegionType             RegionType;
+  typedef typename InputImageType::SizeType               RadiusType;
+  typedef typename InputImageType::NeighborhoodAccessorFunctorType
+                                                          NeighborhoodAccessorFunctorType;
+  typedef std::vector< InputPixelType >                   NeighborhoodValuesType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
+
+  NeighborhoodRegionWalker(const InputImageType *input, const RadiusType & radius);
+
+  /** Number of pixels of a neighborhood. */
+  SizeValueType GetNeighborhoodSize() const
+  { return m_Offsets.size(); }
+
+  /** Write function(values) to each pixel of region of output. */
+  template< class TOutputImage, class TFunction >
+  void ComputeFromNeighborhoods(TOutputImage *output, const RegionType & region,
+                                TFunction & function, ProgressReporter & progress);
+
+  /** Write the value of the accumulator fed with the neighborhood to each
+   * pixel of region of output. */
+  template< class TOutputImage, class TAccumulator >
+  void ComputeFromSlidingWindow(TOutputImage *output, const RegionType & region,
+                                TAccumulator & accumulator, ProgressReporter & progress);
+
+private:
+  /** Split region into the interior face, which may be empty, and the
+   * boundary faces. */
+  void SplitRegion(const RegionType & region, RegionType & interior,
+                   std::vector< RegionType > & boundaryFaces) const;
+
+  const InputImageType *m_Input;
+  RadiusType            m_Radius;
+
+  /** Offsets in the buffer of the neighbors from the center, and of the
+   * neighbors leaving and entering the window when the center moves one
+   * pixel along the first dimension, from the old and the new center. */
+  std::vector< OffsetValueType > m_Offsets;
+  std::vector< OffsetValueType > m_LeavingOffsets;
+  std::vector< OffsetValueType > m_EnteringOffsets;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkNeighborhoodRegionWalker.hxx"
+#endif
+
+#endif
@@ -0,0 +1,240 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkNeighborhoodRegionWalker_hxx
+#define __itkNeighborhoodRegionWalker_hxx
+
+#include "itkNeighborhoodRegionWalker.h"
+#include "itkNeighborhoodAlgorithm.h"
+#include "itkImageRegionIterator.h"
+
+namespace itk
+{
+template< class TInputImage, class TBoundaryCondition >
+NeighborhoodRegionWalker< TInputImage, TBoundaryCondition >
+::NeighborhoodRegionWalker(const InputImageType *input, const RadiusType & radius):
+  m_Input(input),
+  m_Radius(radius)
+{
+  // Visit the neighbors in the order of ConstNeighborhoodIterator, the
+  // first dimension varying the fastest.
+  const typename InputImageType::OffsetValueType *offsetTable = input->GetOffsetTable();
+
+  typename InputImageType::OffsetType offset;
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    offset[i] = -static_cast< OffsetValueType >( radius[i] );
+    }
+
+  bool done = false;
+  while ( !done )
+    {
+    OffsetValueType bufferOffset = 0;
+    for ( unsigned int i = 0; i < ImageDimension; ++i )
+      {
+      bufferOffset += offset[i] * offsetTable[i];
+      }
+    m_Offsets.push_back(bufferOffset);
+    if ( offset[0] == -static_cast< OffsetValueType >( radius[0] ) )
+      {
+      m_LeavingOffsets.push_back(bufferOffset - 1);
+      }
+    if ( offset[0] == static_cast< OffsetValueType >( radius[0] ) )
+      {
+      m_EnteringOffsets.push_back(bufferOffset);
+      }
+
+    done = true;
+    for ( unsigned int i = 0; i < ImageDimension && done; ++i )
+      {
+      if ( offset[i] < static_cast< OffsetValueType >( radius[i] ) )
+        {
+        ++offset[i];
+        done = false;
+        }
+      else
+        {
+        offset[i] = -static_cast< OffsetValueType >( radius[i] );
+        }
+      }
+    }
+}
+
+template< class TInputImage, class TBoundaryCondition >
+void
+NeighborhoodRegionWalker< TInputImage, TBoundaryCondition >
+::SplitRegion(const RegionType & region, RegionType & interior,
+              std::vector< RegionType > & boundaryFaces) const
+{
+  typedef NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > FacesCalculatorType;
+  FacesCalculatorType                       facesCalculator;
+  typename FacesCalculatorType::FaceListType faceList = facesCalculator(m_Input, region, m_Radius);
+
+  boundaryFaces.clear();
+  interior = RegionType();
+  for ( typename FacesCalculatorType::FaceListType::const_iterator fit = faceList.begin();
+        fit != faceList.end(); ++fit )
+    {
+    if ( fit->GetNumberOfPixels() == 0 )
+      {
+      continue;
+      }
+
+    // The first face is the interior one, unless the buffer is too small
+    // for the neighborhoods to fit in it.
+    RegionType padded = *fit;
+    padded.PadByRadius(m_Radius);
+    if ( fit == faceList.begin() && m_Input->GetBufferedRegion().IsInside(padded) )
+      {
+      interior = *fit;
+      }
+    else
+      {
+      boundaryFaces.push_back(*fit);
+      }
+    }
+}
+
+template< class TInputImage, class TBoundaryCondition >
+template< class TOutputImage, class TFunction >
+void
+NeighborhoodRegionWalker< TInputImage, TBoundaryCondition >
+::ComputeFromNeighborhoods(TOutputImage *output, const RegionType & region,
+                           TFunction & function, ProgressReporter & progress)
+{
+  typedef typename TOutputImage::PixelType OutputPixelType;
+
+  RegionType                interior;
+  std::vector< RegionType > boundaryFaces;
+  this->SplitRegion(region, interior, boundaryFaces);
+
+  const SizeValueType    neighborhoodSize = m_Offsets.size();
+  NeighborhoodValuesType values(neighborhoodSize);
+
+  if ( interior.GetNumberOfPixels() > 0 )
+    {
+    const InputInternalPixelType   *buffer = m_Input->GetBufferPointer();
+    NeighborhoodAccessorFunctorType accessor = m_Input->GetNeighborhoodAccessor();
+    accessor.SetBegin(buffer);
+
+    const SizeValueType lineLength = interior.GetSize(0);
+    for ( ImageRegionIterator< TOutputImage > ot(output, interior); !ot.IsAtEnd(); )
+      {
+      const InputInternalPixelType *center = buffer + m_Input->ComputeOffset( ot.GetIndex() );
+      for ( SizeValueType x = 0; x < lineLength; ++x, ++center, ++ot )
+        {
+        for ( SizeValueType i = 0; i < neighborhoodSize; ++i )
+          {
+          values[i] = accessor.Get(center + m_Offsets[i]);
+          }
+        ot.Set( static_cast< OutputPixelType >( function(values) ) );
+        progress.CompletedPixel();
+        }
+      }
+    }
+
+  for ( typename std::vector< RegionType >::const_iterator fit = boundaryFaces.begin();
+        fit != boundaryFaces.end(); ++fit )
+    {
+    ConstNeighborhoodIterator< InputImageType, BoundaryConditionType > bit(m_Radius, m_Input, *fit);
+    ImageRegionIterator< TOutputImage >                                 ot(output, *fit);
+    for ( bit.GoToBegin(); !bit.IsAtEnd(); ++bit, ++ot )
+      {
+      for ( SizeValueType i = 0; i < neighborhoodSize; ++i )
+        {
+        values[i] = bit.GetPixel(i);
+        }
+      ot.Set( static_cast< OutputPixelType >( function(values) ) );
+      progress.CompletedPixel();
+      }
+    }
+}
+
+template< class TInputImage, class TBoundaryCondition >
+template< class TOutputImage, class TAccumulator >
+void
+NeighborhoodRegionWalker< TInputImage, TBoundaryCondition >
+::ComputeFromSlidingWindow(TOutputImage *output, const RegionType & region,
+                           TAccumulator & accumulator, ProgressReporter & progress)
+{
+  typedef typename TOutputImage::PixelType OutputPixelType;
+
+  RegionType                interior;
+  std::vector< RegionType > boundaryFaces;
+  this->SplitRegion(region, interior, boundaryFaces);
+
+  const SizeValueType neighborhoodSize = m_Offsets.size();
+
+  if ( interior.GetNumberOfPixels() > 0 )
+    {
+    const InputInternalPixelType   *buffer = m_Input->GetBufferPointer();
+    NeighborhoodAccessorFunctorType accessor = m_Input->GetNeighborhoodAccessor();
+    accessor.SetBegin(buffer);
+
+    const SizeValueType lineLength = interior.GetSize(0);
+    const SizeValueType numberOfLeaving = m_LeavingOffsets.size();
+    const SizeValueType numberOfEntering = m_EnteringOffsets.size();
+    for ( ImageRegionIterator< TOutputImage > ot(output, interior); !ot.IsAtEnd(); )
+      {
+      // Fill the window at the start of the line, then slide it.
+      const InputInternalPixelType *center = buffer + m_Input->ComputeOffset( ot.GetIndex() );
+      accumulator.Reset();
+      for ( SizeValueType i = 0; i < neighborhoodSize; ++i )
+        {
+        accumulator.Add( accessor.Get(center + m_Offsets[i]) );
+        }
+      ot.Set( static_cast< OutputPixelType >( accumulator.GetValue( accessor.Get(center) ) ) );
+      ++ot;
+      progress.CompletedPixel();
+
+      for ( SizeValueType x = 1; x < lineLength; ++x, ++ot )
+        {
+        ++center;
+        for ( SizeValueType i = 0; i < numberOfLeaving; ++i )
+          {
+          accumulator.Remove( accessor.Get(center + m_LeavingOffsets[i]) );
+          }
+        for ( SizeValueType i = 0; i < numberOfEntering; ++i )
+          {
+          accumulator.Add( accessor.Get(center + m_EnteringOffsets[i]) );
+          }
+        ot.Set( static_cast< OutputPixelType >( accumulator.GetValue( accessor.Get(center) ) ) );
+        progress.CompletedPixel();
+        }
+      }
+    }
+
+  for ( typename std::vector< RegionType >::const_iterator fit = boundaryFaces.begin();
+        fit != boundaryFaces.end(); ++fit )
+    {
+    ConstNeighborhoodIterator< InputImageType, BoundaryConditionType > bit(m_Radius, m_Input, *fit);
+    ImageRegionIterator< TOutputImage >                                 ot(output, *fit);
+    for ( bit.GoToBegin(); !bit.IsAtEnd(); ++bit, ++ot )
+      {
+      accumulator.Reset();
+      for ( SizeValueType i = 0; i < neighborhoodSize; ++i )
+        {
+        accumulator.Add( bit.GetPixel(i) );
+        }
+      ot.Set( static_cast< OutputPixelType >( accumulator.GetValue( bit.GetCenterPixel() ) ) );
+      progress.CompletedPixel();
+      }
+    }
+}
+} // end namespace itk
+
+#endif
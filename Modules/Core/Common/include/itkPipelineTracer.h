@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkPipelineTracer_h
+#define __itkPipelineTracer_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkRealTimeClock.h"
+#include "itkSimpleFastMutexLock.h"
+
+#include <map>
+#include <vector>
+
+namespace itk
+{
+/** \class PipelineTracer
+ * \brief Records the execution of the pipeline as a timeline.
+ *
+ * When enabled, the pipeline records a span for each phase of each
+ * ProcessObject: GenerateOutputInformation, PropagateRequestedRegion,
+ * GenerateData, the allocation of the outputs of ImageSource and its
+ * ThreadedGenerateData on each thread.  MultiThreader records the busy
+ * time of each thread, and ImageBufferAllocator the size of each buffer
+ * it allocates.  Spans nest, so the time of a filter includes the time
+ * of the phases and allocations it triggered.
+ *
+ * WriteChromeTrace() saves the spans in the trace event format of the
+ * Chrome tracing tools (chrome://tracing, Perfetto), one row per thread.
+ *
+ * Tracing is off by default and costs a test of a flag per span.
+ * Setting the ITK_PIPELINE_TRACE environment variable to a file name
+ * turns it on, and the trace is written to that file when the program
+ * exits, so an existing application can be profiled without being
+ * recompiled.
+ *
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineTracer:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef PipelineTracer             Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PipelineTracer, Object);
+
+  /** Return the process-wide tracer, creating it on first use. */
+  static Pointer GetInstance();
+
+  /** Turn the recording on or off.  The initial value is on when the
+   * ITK_PIPELINE_TRACE environment variable is set. */
+  static void SetEnabled(bool flag);
+  static bool GetEnabled()
+  {
+    if ( !m_EnabledIsInitialized )
+      {
+      InitializeFromEnvironment();
+      }
+    return m_Enabled;
+  }
+
+  /** Record a span of duration microseconds starting at start, in the
+   * timebase of GetTime(), on the calling thread.  numberOfBytes is
+   * reported with the span when it is not zero. */
+  void AddSpan(const std::string & name, const char *category,
+               double start, double duration, SizeValueType numberOfBytes = 0);
+
+  /** Time, in microseconds, since the creation of the tracer. */
+  double GetTime() const;
+
+  /** Number of spans recorded since the creation of the tracer or the
+   * last call to Clear(). */
+  SizeValueType GetNumberOfSpans() const;
+
+  /** Forget the recorded spans. */
+  void Clear();
+
+  /** Write the recorded spans as a Chrome trace event JSON document. */
+  void WriteChromeTrace(std::ostream & os) const;
+
+  /** Same, to a file.  Throws an exception when the file cannot be
+   * written. */
+  void WriteChromeTrace(const std::string & fileName) const;
+
+  /** Set/Get the file written when the tracer is destroyed, i.e. when
+   * the program exits.  Empty, the default, writes nothing.  The initial
+   * value is the content of the ITK_PIPELINE_TRACE environment
+   * variable. */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** \class Scope
+   * \brief Records a span from its construction to its destruction.
+   *
+   * Does nothing unless tracing is enabled.  The span is named after
+   * the class of the object, when given, followed by the phase.
+   * \ingroup ITKCommon
+   */
+  class ITKCommon_EXPORT Scope
+  {
+public:
+    Scope(const char *phase, const char *category, const Object *object = NULL);
+    ~Scope();
+
+    /** Report a number of bytes with the span. */
+    void SetNumberOfBytes(SizeValueType numberOfBytes)
+    {
+      m_NumberOfBytes = numberOfBytes;
+    }
+
+private:
+    Scope(const Scope &);          //purposely not implemented
+    void operator=(const Scope &); //purposely not implemented
+
+    Pointer       m_Tracer;
+    std::string   m_Name;
+    const char *  m_Category;
+    double        m_Start;
+    SizeValueType m_NumberOfBytes;
+  };
+
+protected:
+  PipelineTracer();
+  ~PipelineTracer();
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+private:
+  PipelineTracer(const Self &); //purposely not implemented
+  void operator=(const Self &); //purposely not implemented
+
+  static void InitializeFromEnvironment();
+
+  /** Small number identifying the calling thread in the trace.
+   * m_Mutex must be held. */
+  unsigned int GetCurrentThreadIndex();
+
+  struct Span
+  {
+    std::string   Name;
+    const char *  Category;
+    unsigned int  ThreadIndex;
+    double        Start;
+    double        Duration;
+    SizeValueType NumberOfBytes;
+  };
+
+  std::vector< Span >                       m_Spans;
+  std::map< unsigned long, unsigned int >   m_ThreadIndices;
+  std::string                               m_FileName;
+  RealTimeClock::Pointer                    m_Clock;
+  RealTimeClock::TimeStampType              m_Origin;
+
+  /** Guards m_Spans and m_ThreadIndices. */
+  mutable SimpleFastMutexLock m_Mutex;
+
+  static bool m_Enabled;
+  static bool m_EnabledIsInitialized;
+
+  static Pointer             m_PipelineTracerInstance;
+  static SimpleFastMutexLock m_PipelineTracerInstanceMutex;
+};
+} // end namespace itk
+
+#endif
@@ -38,6 +38,8 @@
 
 namespace itk
 {
+class UpdateFuture;
+
 /** \class ProcessObject
  * \brief The base class for all process objects (source,
  *        filters, mappers) in the Insight data processing pipeline.
@@ -271,6 +273,16 @@ public:
    * call UpdateLargestPossibleRegion() instead. */
   virtual void Update();
 
+  /** Start an Update() on the shared ThreadPool and return at once.  The
+   * returned UpdateFuture (include itkUpdateFuture.h) waits for or
+   * cancels the update; Cancel() aborts the running ProcessObject and
+   * stops the pipeline before the ProcessObjects that have not started
+   * yet.  Neither the pipeline nor its outputs may be used by other
+   * threads until the update is done, and pipelines updated
+   * concurrently must not share ProcessObjects.  When the pool cannot
+   * take the job, the update runs before UpdateAsync() returns. */
+  SmartPointer< UpdateFuture > UpdateAsync();
+
   /** Like Update(), but sets the output requested region to the
    * largest possible region for the output.  This is the method users
    * should call if they want the entire dataset to be processed.  If
@@ -356,6 +368,50 @@ public:
   itkGetConstReferenceMacro(ReleaseDataBeforeUpdateFlag, bool);
   itkBooleanMacro(ReleaseDataBeforeUpdateFlag);
 
+  /** Turn on/off the automatic in-place planning.  When on,
+   * UpdateOutputInformation() records which inputs are intermediate
+   * data (they have a source) that are referenced by this ProcessObject
+   * only, apart from their source.  Nothing else can read the bulk data
+   * of such an input after this ProcessObject has executed, so a filter
+   * able to overwrite it may reuse its buffer for an output instead of
+   * allocating a new one: InPlaceImageFilter then runs in place exactly
+   * when its first input is releasable, whatever its InPlace flag.
+   * The decisions are reported by IsInputReleasable() and by the debug
+   * output.  The default value is GlobalDefaultAutomaticInPlace. */
+  itkSetMacro(AutomaticInPlace, bool);
+  itkGetConstMacro(AutomaticInPlace, bool);
+  itkBooleanMacro(AutomaticInPlace);
+
+  /** Set/Get the value used to initialize AutomaticInPlace in the
+   * ProcessObjects created afterwards.  The initial value is read from
+   * the ITK_AUTOMATIC_IN_PLACE environment variable and defaults to
+   * off. */
+  static void SetGlobalDefaultAutomaticInPlace(bool flag);
+  static bool GetGlobalDefaultAutomaticInPlace();
+
+  /** Turn on/off the concurrent update of the inputs.  When on, and
+   * two or more inputs are produced by branches of the pipeline that do
+   * not share any ProcessObject, such as two readers feeding a
+   * BinaryFunctorImageFilter, the branches are updated concurrently on
+   * the shared ThreadPool instead of one after the other.  The default
+   * value is GlobalDefaultConcurrentInputUpdate. */
+  itkSetMacro(ConcurrentInputUpdate, bool);
+  itkGetConstMacro(ConcurrentInputUpdate, bool);
+  itkBooleanMacro(ConcurrentInputUpdate);
+
+  /** Set/Get the value used to initialize ConcurrentInputUpdate in the
+   * ProcessObjects created afterwards.  The initial value is read from
+   * the ITK_CONCURRENT_INPUT_UPDATE environment variable and defaults to
+   * off. */
+  static void SetGlobalDefaultConcurrentInputUpdate(bool flag);
+  static bool GetGlobalDefaultConcurrentInputUpdate();
+
+  /** Return true when the last UpdateOutputInformation() found the input
+   * to be referenced by this ProcessObject and its source only.  Always
+   * false when AutomaticInPlace is off. */
+  bool IsInputReleasable(const DataObjectIdentifierType & key) const;
+  bool IsInputReleasable(DataObjectPointerArraySizeType idx) const;
+
   /** Get/Set the number of threads to create when executing. */
   itkSetClampMacro(NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS);
   itkGetConstReferenceMacro(NumberOfThreads, ThreadIdType);
@@ -710,6 +766,34 @@ private:
   /** Memory management ivars */
   bool m_ReleaseDataBeforeUpdateFlag;
 
+  /** Automatic in-place planning. */
+  bool    m_AutomaticInPlace;
+  NameSet m_ReleasableInputNames;
+
+  static bool m_GlobalDefaultAutomaticInPlace;
+  static bool m_GlobalDefaultAutomaticInPlaceIsInitialized;
+
+  /** Record in m_ReleasableInputNames the inputs referenced by this
+   * ProcessObject and their source only. */
+  void PlanInPlaceExecution();
+
+  /** Concurrent update of independent input branches. */
+  bool m_ConcurrentInputUpdate;
+
+  static bool m_GlobalDefaultConcurrentInputUpdate;
+  static bool m_GlobalDefaultConcurrentInputUpdateIsInitialized;
+
+  /** Update the inputs of independent branches concurrently.  Returns
+   * false, having updated nothing, when ConcurrentInputUpdate is off,
+   * when fewer than two inputs have a source, or when their branches
+   * share a ProcessObject. */
+  bool UpdateInputsConcurrently();
+
+  /** Set by UpdateFuture::Cancel(): the ProcessObject throws
+   * ProcessAborted instead of executing, until the canceled update is
+   * over. */
+  bool m_UpdateCanceled;
+
   /** Friends of ProcessObject */
   friend class DataObject;
 
@@ -722,6 +806,7 @@ private:
   friend class OutputDataObjectIterator;
 
   friend class TestProcessObject;
+  friend class UpdateFuture;
 };
 } // end namespace itk
 
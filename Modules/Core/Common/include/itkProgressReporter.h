@@ -85,14 +85,23 @@ public:
           m_CurrentPixel * m_InverseNumberOfPixels * m_ProgressWeight + m_InitialProgress);
         }
       // all threads needs to check the abort flag
-      if ( m_Filter->GetAbortGenerateData() )
-        {
-        std::string    msg;
-        ProcessAborted e(__FILE__, __LINE__);
-        msg += "Object " + std::string( m_Filter->GetNameOfClass() ) + ": AbortGenerateDataOn";
-        e.SetDescription(msg);
-        throw e;
-        }
+      this->CheckAbortGenerateData();
+      }
+  }
+
+  /** Throw ProcessAborted when the AbortGenerateData flag of the filter
+   * is on.  CompletedPixel() calls it at each progress update; loops
+   * whose iterations are long, or which report progress rarely, may call
+   * it more often to react promptly to UpdateFuture::Cancel(). */
+  void CheckAbortGenerateData() const
+  {
+    if ( m_Filter->GetAbortGenerateData() )
+      {
+      std::string    msg;
+      ProcessAborted e(__FILE__, __LINE__);
+      msg += "Object " + std::string( m_Filter->GetNameOfClass() ) + ": AbortGenerateDataOn";
+      e.SetDescription(msg);
+      throw e;
       }
   }
 
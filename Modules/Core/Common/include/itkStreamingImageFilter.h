@@ -87,6 +87,13 @@ public:
    * will be executed this many times. */
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get the number of bytes of input pixels that a piece may hold.
+   * When it is not zero, the output is divided into the fewest pieces
+   * that fit in the budget, and NumberOfStreamDivisions is ignored.  The
+   * region splitter may still impose larger pieces.  Zero by default. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
   /** Set the helper class for dividing the input into chunks. */
   itkSetObjectMacro(RegionSplitter, SplitterType);
 
@@ -119,6 +126,10 @@ protected:
   ~StreamingImageFilter();
   void PrintSelf(std::ostream & os, Indent indent) const;
 
+  /** Copy a region of the input, freshly updated, to the output, with
+   * the threads of the filter. */
+  virtual void CopyInputRegionToOutput(const InputImageRegionType & streamRegion);
+
 private:
   StreamingImageFilter(const StreamingImageFilter &); //purposely not
                                                       // implemented
@@ -126,7 +137,19 @@ private:
 
   // implemented
 
+  /** Callback of the threads of CopyInputRegionToOutput(). */
+  static ITK_THREAD_RETURN_TYPE CopyThreaderCallback(void *arg);
+
+  /** Structure shared by the threads of CopyInputRegionToOutput(). */
+  struct CopyThreadStruct {
+    const InputImageType *InputImage;
+    OutputImageType *     OutputImage;
+    InputImageRegionType  Region;
+    RegionSplitterPointer Splitter;
+  };
+
   unsigned int          m_NumberOfStreamDivisions;
+  SizeValueType         m_MemoryBudget;
   RegionSplitterPointer m_RegionSplitter;
 };
 } // end namespace itk
@@ -21,6 +21,7 @@
 #include "itkCommand.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageAlgorithm.h"
+#include "vcl_cmath.h"
 
 namespace itk
 {
@@ -34,6 +35,9 @@ StreamingImageFilter< TInputImage, TOutputImage >
   // default to 10 divisions
   m_NumberOfStreamDivisions = 10;
 
+  // no memory budget
+  m_MemoryBudget = 0;
+
   // create default region splitter
   m_RegionSplitter = ImageRegionSplitter< InputImageDimension >::New();
 }
@@ -58,6 +62,7 @@ StreamingImageFilter< TInputImage, TOutputImage >
 
   os << indent << "Number of stream divisions: " << m_NumberOfStreamDivisions
      << std::endl;
+  os << indent << "Memory budget: " << m_MemoryBudget << std::endl;
   if ( m_RegionSplitter )
     {
     os << indent << "Region splitter:" << m_RegionSplitter << std::endl;
@@ -168,15 +173,35 @@ StreamingImageFilter< TInputImage, TOutputImage >
 
   /**
    * Determine of number of pieces to divide the input.  This will be the
-   * minimum of what the user specified via SetNumberOfStreamDivisions()
-   * and what the Splitter thinks is a reasonable value.
+   * minimum of what the user specified via SetNumberOfStreamDivisions(),
+   * or the number of pieces that fit in the memory budget, and what the
+   * Splitter thinks is a reasonable value.
    */
   unsigned int numDivisions, numDivisionsFromSplitter;
 
   numDivisions = m_NumberOfStreamDivisions;
+  if ( m_MemoryBudget > 0 )
+    {
+    const double pixelSize = static_cast< double >( inputPtr->GetNumberOfComponentsPerPixel() )
+                             * sizeof( typename InputImageType::InternalPixelType );
+    const double regionSize = pixelSize * static_cast< double >( outputRegion.GetNumberOfPixels() );
+    const double budgetDivisions = vcl_ceil( regionSize / static_cast< double >( m_MemoryBudget ) );
+    if ( budgetDivisions < 1.0 )
+      {
+      numDivisions = 1;
+      }
+    else if ( budgetDivisions < static_cast< double >( NumericTraits< unsigned int >::max() ) )
+      {
+      numDivisions = static_cast< unsigned int >( budgetDivisions );
+      }
+    else
+      {
+      numDivisions = NumericTraits< unsigned int >::max();
+      }
+    }
   numDivisionsFromSplitter =
     m_RegionSplitter
-    ->GetNumberOfSplits(outputRegion, m_NumberOfStreamDivisions);
+    ->GetNumberOfSplits(outputRegion, numDivisions);
   if ( numDivisionsFromSplitter < numDivisions )
     {
     numDivisions = numDivisionsFromSplitter;
@@ -203,8 +228,7 @@ StreamingImageFilter< TInputImage, TOutputImage >
     // requested region determined by the RegionSplitter (as opposed
     // to what the pipeline might have enlarged it to) is used to
     // copy the regions from the input to output
-    ImageAlgorithm::Copy( inputPtr, outputPtr, streamRegion, streamRegion );
-
+    this->CopyInputRegionToOutput(streamRegion);
 
     this->UpdateProgress( (float)piece / numDivisions );
     }
@@ -240,6 +264,57 @@ StreamingImageFilter< TInputImage, TOutputImage >
   // Mark that we are no longer updating the data in this filter
   this->m_Updating = false;
 }
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+void
+StreamingImageFilter< TInputImage, TOutputImage >
+::CopyInputRegionToOutput(const InputImageRegionType & streamRegion)
+{
+  CopyThreadStruct str;
+  str.InputImage = this->GetInput();
+  str.OutputImage = this->GetOutput();
+  str.Region = streamRegion;
+  str.Splitter = SplitterType::New();
+
+  // Each thread copies its own slab of the piece.
+  const ThreadIdType numberOfThreads =
+    str.Splitter->GetNumberOfSplits( streamRegion, this->GetNumberOfThreads() );
+  if ( numberOfThreads <= 1 )
+    {
+    ImageAlgorithm::Copy( str.InputImage, str.OutputImage, streamRegion, streamRegion );
+    return;
+    }
+
+  this->GetMultiThreader()->SetNumberOfThreads(numberOfThreads);
+  this->GetMultiThreader()->SetSingleMethod(this->CopyThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+/**
+ *
+ */
+template< class TInputImage, class TOutputImage >
+ITK_THREAD_RETURN_TYPE
+StreamingImageFilter< TInputImage, TOutputImage >
+::CopyThreaderCallback(void *arg)
+{
+  const ThreadIdType threadId = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->ThreadID;
+  const ThreadIdType threadCount = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->NumberOfThreads;
+
+  CopyThreadStruct *str = (CopyThreadStruct *)( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
+
+  const unsigned int total = str->Splitter->GetNumberOfSplits(str->Region, threadCount);
+  if ( threadId < total )
+    {
+    const InputImageRegionType splitRegion = str->Splitter->GetSplit(threadId, total, str->Region);
+    ImageAlgorithm::Copy( str->InputImage, str->OutputImage, splitRegion, splitRegion );
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
 } // end namespace itk
 
 #endif
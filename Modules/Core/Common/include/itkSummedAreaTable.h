@@ -0,0 +1,234 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkSummedAreaTable_h
+#define __itkSummedAreaTable_h
+
+#include "itkImage.h"
+#include "itkCompensatedSummation.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+/** \class SummedAreaTable
+ * \brief Computes statistics of the boxes centered on the pixels of a
+ * region in constant time per pixel.
+ *
+ * The sums of the input values in the boxes of the given radius, and
+ * optionally of their squares, of the values of a second image and of
+ * the products of both, are read from summed area tables (integral
+ * images): a box sum is a combination of the 2^ImageDimension table
+ * entries at its corners, whatever the radius.
+ *
+ * The tables are built for slabs of the region, padded by the radius,
+ * so that their memory stays bounded (see
+ * SetMaximumNumberOfTableEntries()); each thread of a filter builds its
+ * own.  The prefix sums use CompensatedSummation, so that an entry is
+ * about as accurate as the sum of the values of its box computed
+ * directly, even far from the origin of the table.
+ *
+ * Two boundary conditions are supported.  By default the boxes
+ * reaching out of the buffered region of the input replicate its edge,
+ * as ZeroFluxNeumannBoundaryCondition does, and always count
+ * (2r+1)^ImageDimension pixels.  With SetCropBoxes(true) they are cropped
+ * to the buffered region and count the pixels they keep.
+ *
+ * ComputeFromBoxes() calls function(box) for each pixel, box being a
+ * BoxStatistics, and writes the value returned to the output pixel of
+ * the same index.
+ *
+ * \code
+ * SummedAreaTable< InputImageType > table( input, radius );
+ * table.SetComputeSumOfSquares(true);
+ * table.ComputeFromBoxes( output, outputRegionForThread, sigmaFunction, progress );
+ * \endcode
+ *
+ * \sa NeighborhoodRegionWalker
+ * \sa CompensatedSummation
+ * \ingroup ITKCommon
+ */
+template< class TInputImage,
+          class TRealType = typename NumericTraits< typename TInputImage::PixelType >::RealType >
+class SummedAreaTable
+{
+public:
+  /** Standard class typedefs. */
+  typedef SummedAreaTable Self;
+
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::InternalPixelType InputInternalPixelType;
+  typedef typename InputImageType::RegionType        RegionType;
+  typedef typename InputImageType::IndexType         IndexType;
+  typedef typename InputImageType::SizeType          RadiusType;
+  typedef TRealType                                  RealType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
+
+  /** \class BoxStatistics
+   * \brief Sums over the box centered on a pixel.
+   *
+   * Only the sums requested from the table are computed; the others are
+   * zero.
+   * \ingroup ITKCommon
+   */
+  class BoxStatistics
+  {
+public:
+    RealType      Sum;
+    RealType      SumOfSquares;
+    RealType      SecondSum;
+    RealType      SecondSumOfSquares;
+    RealType      SumOfProducts;
+    SizeValueType NumberOfPixels;
+
+    RealType GetMean() const
+    {
+      return Sum / static_cast< RealType >( NumberOfPixels );
+    }
+
+    /** Sample variance of the values, zero for a single pixel. */
+    RealType GetVariance() const
+    {
+      return ( NumberOfPixels > 1 ) ?
+        ClampToZero( ( SumOfSquares - Sum * Sum / static_cast< RealType >( NumberOfPixels ) )
+                           / static_cast< RealType >( NumberOfPixels - 1 ) ) : NumericTraits< RealType >::Zero;
+    }
+
+    RealType GetSigma() const
+    {
+      return vcl_sqrt( this->GetVariance() );
+    }
+
+    /** Sample covariance of the values of both images. */
+    RealType GetCovariance() const
+    {
+      return ( NumberOfPixels > 1 ) ?
+        ( SumOfProducts - Sum * SecondSum / static_cast< RealType >( NumberOfPixels ) )
+        / static_cast< RealType >( NumberOfPixels - 1 ) : NumericTraits< RealType >::Zero;
+    }
+
+    /** Pearson correlation of the values of both images, zero when one of
+     * them is constant over the box. */
+    RealType GetCorrelation() const
+    {
+      const RealType n = static_cast< RealType >( NumberOfPixels );
+      const RealType denominator =
+        ClampToZero(SumOfSquares - Sum * Sum / n) * ClampToZero(SecondSumOfSquares - SecondSum * SecondSum / n);
+      return ( denominator > NumericTraits< RealType >::Zero ) ?
+        ( SumOfProducts - Sum * SecondSum / n ) / vcl_sqrt(denominator) : NumericTraits< RealType >::Zero;
+    }
+
+private:
+    /** The rounding of the sums may make a null variance negative. */
+    static RealType ClampToZero(const RealType & value)
+    { return ( value > NumericTraits< RealType >::Zero ) ? value : NumericTraits< RealType >::Zero; }
+  };
+
+  SummedAreaTable(const InputImageType *input, const RadiusType & radius);
+
+  /** Also sum the squares of the values.  Off by default. */
+  void SetComputeSumOfSquares(bool flag)
+  { m_ComputeSumOfSquares = flag; }
+
+  /** Also sum the values of a second image, their squares and the
+   * products of the values of both images.  The second image must have
+   * the buffered region of the first.  NULL, the default, disables these
+   * sums. */
+  void SetSecondInput(const InputImageType *input)
+  { m_SecondInput = input; }
+
+  /** Crop the boxes to the buffered region of the input instead of
+   * replicating its edge.  Off by default. */
+  void SetCropBoxes(bool flag)
+  { m_CropBoxes = flag; }
+
+  /** Bound the number of entries of each table, 2^21 by default.  The
+   * region is processed in slabs of at least one plane along the last
+   * dimension, whose tables stay below this size when possible. */
+  void SetMaximumNumberOfTableEntries(SizeValueType number)
+  { m_MaximumNumberOfTableEntries = number; }
+
+  /** Write function(box) to each pixel of region of output. */
+  template< class TOutputImage, class TFunction >
+  void ComputeFromBoxes(TOutputImage *output, const RegionType & region,
+                        TFunction & function, ProgressReporter & progress);
+
+private:
+  typedef enum { Values, Squares, SecondValues, SecondSquares, Products } TableContentType;
+
+  /** Fill table with the content computed from the inputs over the slab
+   * of centers, and integrate it. */
+  void BuildTable(std::vector< RealType > & table, TableContentType content, const RegionType & slab);
+
+  /** Number of pixels of the box centered at index along dimension,
+   * once cropped to valid. */
+  SizeValueType GetCroppedSize(IndexValueType index, unsigned int dimension, const RegionType & valid) const
+  {
+    const IndexValueType radius = static_cast< IndexValueType >( m_Radius[dimension] );
+    const IndexValueType first = std::max( index - radius, valid.GetIndex(dimension) );
+    const IndexValueType last =
+      std::min( index + radius, valid.GetIndex(dimension) + static_cast< IndexValueType >( valid.GetSize(dimension) ) - 1 );
+    return ( last >= first ) ? static_cast< SizeValueType >( last - first + 1 ) : 0;
+  }
+
+  /** Sum of the box whose lowest corner is at offset in table. */
+  RealType GetBoxSum(const std::vector< RealType > & table, OffsetValueType offset) const
+  {
+    RealType sum = NumericTraits< RealType >::Zero;
+    for ( unsigned int i = 0; i < m_PositiveCorners.size(); ++i )
+      {
+      sum += table[offset + m_PositiveCorners[i]];
+      }
+    for ( unsigned int i = 0; i < m_NegativeCorners.size(); ++i )
+      {
+      sum -= table[offset + m_NegativeCorners[i]];
+      }
+    return sum;
+  }
+
+  const InputImageType *m_Input;
+  const InputImageType *m_SecondInput;
+  RadiusType            m_Radius;
+  bool                  m_ComputeSumOfSquares;
+  bool                  m_CropBoxes;
+  SizeValueType         m_MaximumNumberOfTableEntries;
+
+  /** Size and offset table of the current tables, which have a leading
+   * plane of zeros in each dimension. */
+  SizeValueType   m_TableSize[ImageDimension];
+  OffsetValueType m_TableStrides[ImageDimension + 1];
+
+  /** Offsets of the corners of a box from its lowest corner, by sign in
+   * the box sum. */
+  std::vector< OffsetValueType > m_PositiveCorners;
+  std::vector< OffsetValueType > m_NegativeCorners;
+
+  std::vector< RealType > m_Sums;
+  std::vector< RealType > m_SumsOfSquares;
+  std::vector< RealType > m_SecondSums;
+  std::vector< RealType > m_SecondSumsOfSquares;
+  std::vector< RealType > m_SumsOfProducts;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkSummedAreaTable.hxx"
+#endif
+
+#endif
@@ -0,0 +1,313 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkSummedAreaTable_hxx
+#define __itkSummedAreaTable_hxx
+
+#include "itkSummedAreaTable.h"
+#include "itkImageRegionIterator.h"
+
+namespace itk
+{
+template< class TInputImage, class TRealType >
+SummedAreaTable< TInputImage, TRealType >
+::SummedAreaTable(const InputImageType *input, const RadiusType & radius):
+  m_Input(input),
+  m_SecondInput(NULL),
+  m_Radius(radius),
+  m_ComputeSumOfSquares(false),
+  m_CropBoxes(false),
+  m_MaximumNumberOfTableEntries(static_cast< SizeValueType >( 1 ) << 21)
+{
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    m_TableSize[i] = 0;
+    }
+  for ( unsigned int i = 0; i <= ImageDimension; ++i )
+    {
+    m_TableStrides[i] = 0;
+    }
+}
+
+template< class TInputImage, class TRealType >
+void
+SummedAreaTable< TInputImage, TRealType >
+::BuildTable(std::vector< RealType > & table, TableContentType content, const RegionType & slab)
+{
+  const RegionType &                 valid = m_Input->GetBufferedRegion();
+  const OffsetValueType *            inputStrides = m_Input->GetOffsetTable();
+  const InputInternalPixelType *     buffer = m_Input->GetBufferPointer();
+  const InputInternalPixelType *     secondBuffer = m_SecondInput ? m_SecondInput->GetBufferPointer() : NULL;
+  const SizeValueType                numberOfEntries = m_TableStrides[ImageDimension];
+
+  // The entries of index 0 along any dimension stay zero.
+  table.assign(numberOfEntries, NumericTraits< RealType >::Zero);
+
+  // Offsets in the input buffer of the pixels of a line, clamped to the
+  // buffered region or -1 when the boxes are cropped.
+  std::vector< OffsetValueType > lineOffsets(m_TableSize[0] - 1);
+  for ( SizeValueType t = 0; t < lineOffsets.size(); ++t )
+    {
+    const IndexValueType index = slab.GetIndex(0) - static_cast< IndexValueType >( m_Radius[0] )
+                                 + static_cast< IndexValueType >( t );
+    const IndexValueType clamped =
+      std::min( std::max( index, valid.GetIndex(0) ),
+                valid.GetIndex(0) + static_cast< IndexValueType >( valid.GetSize(0) ) - 1 );
+    lineOffsets[t] = ( m_CropBoxes && clamped != index ) ? -1 : clamped - valid.GetIndex(0);
+    }
+
+  // Fill the lines with their prefix sums along the first dimension.
+  SizeValueType position[ImageDimension];
+  for ( unsigned int i = 1; i < ImageDimension; ++i )
+    {
+    position[i] = 1;
+    }
+  bool done = ( numberOfEntries == 0 );
+  while ( !done )
+    {
+    OffsetValueType tableOffset = 0;
+    OffsetValueType inputOffset = 0;
+    bool            inside = true;
+    for ( unsigned int i = 1; i < ImageDimension; ++i )
+      {
+      tableOffset += position[i] * m_TableStrides[i];
+      const IndexValueType index = slab.GetIndex(i) - static_cast< IndexValueType >( m_Radius[i] )
+                                   + static_cast< IndexValueType >( position[i] ) - 1;
+      const IndexValueType clamped =
+        std::min( std::max( index, valid.GetIndex(i) ),
+                  valid.GetIndex(i) + static_cast< IndexValueType >( valid.GetSize(i) ) - 1 );
+      inside = inside && ( !m_CropBoxes || clamped == index );
+      inputOffset += ( clamped - valid.GetIndex(i) ) * inputStrides[i];
+      }
+
+    if ( inside )
+      {
+      RealType *                       line = &table[tableOffset];
+      CompensatedSummation< RealType > running;
+      for ( SizeValueType t = 0; t < lineOffsets.size(); ++t )
+        {
+        if ( lineOffsets[t] >= 0 )
+          {
+          const OffsetValueType offset = inputOffset + lineOffsets[t];
+          const RealType        value = static_cast< RealType >( buffer[offset] );
+          switch ( content )
+            {
+            case Values:
+              running.AddElement(value);
+              break;
+            case Squares:
+              running.AddElement(value * value);
+              break;
+            case SecondValues:
+              running.AddElement( static_cast< RealType >( secondBuffer[offset] ) );
+              break;
+            case SecondSquares:
+              running.AddElement( static_cast< RealType >( secondBuffer[offset] )
+                                  * static_cast< RealType >( secondBuffer[offset] ) );
+              break;
+            case Products:
+              running.AddElement( value * static_cast< RealType >( secondBuffer[offset] ) );
+              break;
+            }
+          }
+        line[t + 1] = running.GetSum();
+        }
+      }
+
+    done = true;
+    for ( unsigned int i = 1; i < ImageDimension && done; ++i )
+      {
+      if ( ++position[i] < m_TableSize[i] )
+        {
+        done = false;
+        }
+      else
+        {
+        position[i] = 1;
+        }
+      }
+    }
+
+  // Integrate along the other dimensions, one slice after the other so
+  // that the memory is read in order.
+  for ( unsigned int i = 1; i < ImageDimension; ++i )
+    {
+    const OffsetValueType                           stride = m_TableStrides[i];
+    const OffsetValueType                           blockSize = m_TableStrides[i + 1];
+    std::vector< CompensatedSummation< RealType > > running(stride);
+    for ( OffsetValueType block = 0; block < static_cast< OffsetValueType >( numberOfEntries ); block += blockSize )
+      {
+      for ( OffsetValueType k = 0; k < stride; ++k )
+        {
+        running[k].ResetToZero();
+        }
+      for ( SizeValueType t = 1; t < m_TableSize[i]; ++t )
+        {
+        RealType *slice = &table[block + t * stride];
+        for ( OffsetValueType k = 0; k < stride; ++k )
+          {
+          running[k].AddElement(slice[k]);
+          slice[k] = running[k].GetSum();
+          }
+        }
+      }
+    }
+}
+
+template< class TInputImage, class TRealType >
+template< class TOutputImage, class TFunction >
+void
+SummedAreaTable< TInputImage, TRealType >
+::ComputeFromBoxes(TOutputImage *output, const RegionType & region,
+                   TFunction & function, ProgressReporter & progress)
+{
+  typedef typename TOutputImage::PixelType OutputPixelType;
+
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+  if ( m_SecondInput && m_SecondInput->GetBufferedRegion() != m_Input->GetBufferedRegion() )
+    {
+    itkGenericExceptionMacro(<< "The second input of SummedAreaTable must have the buffered region of the first");
+    }
+
+  const RegionType & valid = m_Input->GetBufferedRegion();
+  const unsigned int last = ImageDimension - 1;
+
+  // Cut the region in slabs along the last dimension, so that each table
+  // has at most m_MaximumNumberOfTableEntries entries.
+  SizeValueType planeSize = 1;
+  SizeValueType boxSize = 1;
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    if ( i < last )
+      {
+      planeSize *= region.GetSize(i) + 2 * m_Radius[i] + 1;
+      }
+    boxSize *= 2 * m_Radius[i] + 1;
+    }
+  const SizeValueType planesPerTable = m_MaximumNumberOfTableEntries / planeSize;
+  const SizeValueType slabSize =
+    ( planesPerTable > 2 * m_Radius[last] + 2 ) ? planesPerTable - 2 * m_Radius[last] - 1 : 1;
+
+  BoxStatistics box;
+  box.Sum = NumericTraits< RealType >::Zero;
+  box.SumOfSquares = NumericTraits< RealType >::Zero;
+  box.SecondSum = NumericTraits< RealType >::Zero;
+  box.SecondSumOfSquares = NumericTraits< RealType >::Zero;
+  box.SumOfProducts = NumericTraits< RealType >::Zero;
+  box.NumberOfPixels = boxSize;
+
+  for ( SizeValueType slabStart = 0; slabStart < region.GetSize(last); slabStart += slabSize )
+    {
+    RegionType slab = region;
+    slab.SetIndex( last, region.GetIndex(last) + static_cast< IndexValueType >( slabStart ) );
+    slab.SetSize( last, std::min( slabSize, region.GetSize(last) - slabStart ) );
+
+    // The tables cover the boxes centered in the slab, plus a leading
+    // plane of zeros in each dimension.
+    m_TableStrides[0] = 1;
+    m_PositiveCorners.clear();
+    m_NegativeCorners.clear();
+    for ( unsigned int i = 0; i < ImageDimension; ++i )
+      {
+      m_TableSize[i] = slab.GetSize(i) + 2 * m_Radius[i] + 1;
+      m_TableStrides[i + 1] = m_TableStrides[i] * m_TableSize[i];
+      }
+    for ( unsigned int corner = 0; corner < ( 1u << ImageDimension ); ++corner )
+      {
+      OffsetValueType offset = 0;
+      unsigned int    numberOfLowSides = 0;
+      for ( unsigned int i = 0; i < ImageDimension; ++i )
+        {
+        if ( corner & ( 1u << i ) )
+          {
+          offset += ( 2 * m_Radius[i] + 1 ) * m_TableStrides[i];
+          }
+        else
+          {
+          ++numberOfLowSides;
+          }
+        }
+      if ( numberOfLowSides % 2 == 0 )
+        {
+        m_PositiveCorners.push_back(offset);
+        }
+      else
+        {
+        m_NegativeCorners.push_back(offset);
+        }
+      }
+
+    this->BuildTable(m_Sums, Values, slab);
+    if ( m_ComputeSumOfSquares )
+      {
+      this->BuildTable(m_SumsOfSquares, Squares, slab);
+      }
+    if ( m_SecondInput )
+      {
+      this->BuildTable(m_SecondSums, SecondValues, slab);
+      this->BuildTable(m_SecondSumsOfSquares, SecondSquares, slab);
+      this->BuildTable(m_SumsOfProducts, Products, slab);
+      }
+
+    const SizeValueType lineLength = slab.GetSize(0);
+    for ( ImageRegionIterator< TOutputImage > ot(output, slab); !ot.IsAtEnd(); )
+      {
+      // The lowest corner of the box of a pixel is at the position of the
+      // pixel in the table, since the table starts one radius before the
+      // slab, with the plane of zeros.
+      const IndexType index = ot.GetIndex();
+      OffsetValueType offset = 0;
+      SizeValueType   lineBoxSize = 1;
+      for ( unsigned int i = 0; i < ImageDimension; ++i )
+        {
+        offset += ( index[i] - slab.GetIndex(i) ) * m_TableStrides[i];
+        if ( i > 0 && m_CropBoxes )
+          {
+          lineBoxSize *= this->GetCroppedSize(index[i], i, valid);
+          }
+        }
+
+      for ( SizeValueType x = 0; x < lineLength; ++x, ++offset, ++ot )
+        {
+        box.Sum = this->GetBoxSum(m_Sums, offset);
+        if ( m_ComputeSumOfSquares )
+          {
+          box.SumOfSquares = this->GetBoxSum(m_SumsOfSquares, offset);
+          }
+        if ( m_SecondInput )
+          {
+          box.SecondSum = this->GetBoxSum(m_SecondSums, offset);
+          box.SecondSumOfSquares = this->GetBoxSum(m_SecondSumsOfSquares, offset);
+          box.SumOfProducts = this->GetBoxSum(m_SumsOfProducts, offset);
+          }
+        if ( m_CropBoxes )
+          {
+          box.NumberOfPixels =
+            lineBoxSize * this->GetCroppedSize(index[0] + static_cast< IndexValueType >( x ), 0, valid);
+          }
+        ot.Set( static_cast< OutputPixelType >( function(box) ) );
+        progress.CompletedPixel();
+        }
+      }
+    }
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkThreadPool_h
+#define __itkThreadPool_h
+
+#include "itkMultiThreader.h"
+#include "itkConditionVariable.h"
+#include "itkSimpleFastMutexLock.h"
+
+#include <deque>
+#include <vector>
+
+namespace itk
+{
+/** \class ThreadPool
+ * \brief Process-wide pool of persistent worker threads.
+ *
+ * The pool keeps its worker threads alive between executions so that
+ * filters running many short Update() calls do not pay for thread
+ * creation and joining each time.  It is shared by every MultiThreader
+ * whose UseThreadPool flag is on, and therefore by ImageSource and
+ * DomainThreader as well.
+ *
+ * Each worker owns a job queue.  Workers take the most recently queued
+ * job from their own queue and, when it is empty, steal the oldest job
+ * from the queues of other workers.  A thread waiting in WaitForWork()
+ * also runs queued jobs instead of sleeping, so nested parallel sections
+ * cannot exhaust the pool.
+ *
+ * AddWork() grows the pool so that every job it queues can start
+ * immediately on its own worker.  Jobs of one batch may therefore
+ * synchronize with each other, e.g. with an itk::Barrier, exactly as
+ * the threads created by MultiThreader::SingleMethodExecute() can.
+ *
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ThreadPool:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef ThreadPool                 Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ThreadPool, Object);
+
+  /** Return the process-wide pool, creating it on first use. */
+  static Pointer GetInstance();
+
+  /** Tracks the completion of the jobs queued by one or more calls to
+   * AddWork(). */
+  class JobGroup
+  {
+public:
+    JobGroup():m_NumberOfPendingJobs(0) {}
+private:
+    friend class ThreadPool;
+    unsigned int m_NumberOfPendingJobs;
+  };
+
+  /** Queue one job per element of userData, each calling
+   * function( userData[i] ).  Workers are added as needed so that all
+   * the jobs can run concurrently.  Returns false, without queuing any
+   * job, when the pool cannot grow enough (see GetMaximumNumberOfWorkers()). */
+  bool AddWork(ThreadFunctionType function,
+               const std::vector< void * > & userData,
+               JobGroup & group);
+
+  /** Block until every job of the group has finished.  The calling thread
+   * runs queued jobs while it waits. */
+  void WaitForWork(JobGroup & group);
+
+  /** Number of worker threads currently alive. */
+  ThreadIdType GetNumberOfWorkers() const;
+
+  /** Upper bound on the number of worker threads. */
+  static ThreadIdType GetMaximumNumberOfWorkers();
+
+protected:
+  ThreadPool();
+  ~ThreadPool();
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+private:
+  ThreadPool(const Self &);     //purposely not implemented
+  void operator=(const Self &); //purposely not implemented
+
+  struct ThreadJob {
+    ThreadFunctionType Function;
+    void *UserData;
+    JobGroup *Group;
+  };
+  typedef std::deque< ThreadJob > JobQueueType;
+
+  /** Body of every worker thread. */
+  static ITK_THREAD_RETURN_TYPE WorkerThread(void *arg);
+
+  /** Take a job, preferring the newest one of queue "owner" and otherwise
+   * stealing the oldest one of any other queue.  m_Mutex must be held. */
+  bool PopJob(unsigned int owner, ThreadJob & job);
+
+  /** Run a job with m_Mutex released and account for its completion. */
+  void RunJob(const ThreadJob & job);
+
+  /** Used to spawn and join the workers. */
+  MultiThreader::Pointer m_Spawner;
+
+  /** One job queue per worker, indexed by the worker's spawned thread id. */
+  std::vector< JobQueueType > m_Queues;
+
+  unsigned int m_NextQueue;
+  unsigned int m_NumberOfQueuedJobs;
+  unsigned int m_NumberOfBusyWorkers;
+  bool         m_Terminate;
+
+  /** Guards all of the above, and the JobGroup counters. */
+  mutable SimpleMutexLock m_Mutex;
+
+  ConditionVariable::Pointer m_WorkAvailable;
+  ConditionVariable::Pointer m_WorkCompleted;
+
+  static Pointer             m_ThreadPoolInstance;
+  static SimpleFastMutexLock m_ThreadPoolInstanceMutex;
+};
+}  // end namespace itk
+#endif
@@ -20,6 +20,8 @@
 
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkFunctorFusionStage.h"
+#include "itkFunctorSpanEvaluator.h"
 
 namespace itk
 {
@@ -35,6 +37,17 @@ namespace itk
  * UnaryFunctorImageFilter (like the CastImageFilter) can be used
  * to promote a 2D image to a 3D image, etc.
  *
+ * When the input and the output are itk::Image of the same dimension, the
+ * functor is applied to the spans of pixels that are contiguous in both
+ * buffers (see ImageRegionSpanIterator) in plain loops over the pixel
+ * buffers, which the compiler can vectorize.  A functor may also provide
+ * a batch operator() processing a whole span, see
+ * UnaryFunctorSpanEvaluator.
+ *
+ * The filter implements FunctorFusionStage, so a chain of functor filters
+ * ending with it can be executed in a single pass by
+ * FunctorFusionImageFilter.
+ *
  * \sa BinaryFunctorImageFilter TernaryFunctorImageFilter
  *
  * \ingroup   IntensityImageFilters     MultiThreaded
@@ -45,7 +58,9 @@ namespace itk
  * \endwiki
  */
 template< class TInputImage, class TOutputImage, class TFunction >
-class ITK_EXPORT UnaryFunctorImageFilter:public InPlaceImageFilter< TInputImage, TOutputImage >
+class ITK_EXPORT UnaryFunctorImageFilter:
+  public InPlaceImageFilter< TInputImage, TOutputImage >,
+  public FunctorFusionStage< TOutputImage::ImageDimension >
 {
 public:
   /** Standard class typedefs. */
@@ -95,6 +110,26 @@ public:
       }
   }
 
+  /** FunctorFusionStage interface. */
+  typedef FunctorFusionStage< TOutputImage::ImageDimension > FusionStageType;
+  typedef typename FusionStageType::FusionIndexType          FusionIndexType;
+
+  virtual bool CanFuse() const;
+
+  virtual unsigned int GetNumberOfFusionInputs() const { return 1; }
+
+  virtual const DataObject * GetFusionInput(unsigned int input) const;
+
+  virtual void BeforeFusedGenerateData();
+
+  virtual const void * GetFusionInputLine(unsigned int input, const FusionIndexType & index) const;
+
+  virtual void * AllocateFusionLine(SizeValueType length) const;
+
+  virtual void ReleaseFusionLine(void *line) const;
+
+  virtual void EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length);
+
 protected:
   UnaryFunctorImageFilter();
   virtual ~UnaryFunctorImageFilter() {}
@@ -126,6 +161,23 @@ private:
   UnaryFunctorImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);          //purposely not implemented
 
+  /** Whether the pixels of the input and of the output are stored in the
+   * buffers of itk::Image of the same dimension. */
+  typedef BoolType< IsSame< TInputImage, Image< InputImagePixelType, TInputImage::ImageDimension > >::Value
+                    && IsSame< TOutputImage, Image< OutputImagePixelType, TOutputImage::ImageDimension > >::Value
+                    && static_cast< unsigned int >( TInputImage::ImageDimension )
+                    == static_cast< unsigned int >( TOutputImage::ImageDimension ) > HasContiguousPixelsType;
+
+  typedef UnaryFunctorSpanEvaluator< FunctorType, InputImagePixelType, OutputImagePixelType > SpanEvaluatorType;
+
+  /** Apply the functor to the spans of contiguous pixels of the region. */
+  void DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                      ThreadIdType threadId, const TrueType &);
+
+  /** Apply the functor to the pixels of the region with image iterators. */
+  void DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                      ThreadIdType threadId, const FalseType &);
+
   FunctorType m_Functor;
 };
 } // end namespace itk
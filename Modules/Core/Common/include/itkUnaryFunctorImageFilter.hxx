@@ -20,6 +20,7 @@
 
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSpanIterator.h"
 #include "itkProgressReporter.h"
 
 namespace itk
@@ -150,6 +151,40 @@ void
 UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
+{
+  this->DispatchedThreadedGenerateData( outputRegionForThread, threadId, HasContiguousPixelsType() );
+}
+
+template< class TInputImage, class TOutputImage, class TFunction  >
+void
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                 ThreadIdType threadId, const TrueType &)
+{
+  const InputImageType *inputPtr = this->GetInput();
+  OutputImageType *     outputPtr = this->GetOutput(0);
+
+  ImageRegionSpanIterator< Superclass::OutputImageDimension > sit(outputRegionForThread);
+  sit.AddBufferedRegion( inputPtr->GetBufferedRegion() );
+  sit.AddBufferedRegion( outputPtr->GetBufferedRegion() );
+
+  ProgressReporter progress( this, threadId, sit.GetNumberOfSpans() );
+
+  for ( sit.GoToBegin(); !sit.IsAtEnd(); ++sit )
+    {
+    SpanEvaluatorType::Evaluate( m_Functor,
+                                 inputPtr->GetBufferPointer() + inputPtr->ComputeOffset( sit.GetIndex() ),
+                                 outputPtr->GetBufferPointer() + outputPtr->ComputeOffset( sit.GetIndex() ),
+                                 sit.GetSpanLength() );
+    progress.CompletedPixel(); // potential exception thrown here
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TFunction  >
+void
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                 ThreadIdType threadId, const FalseType &)
 {
   InputImagePointer  inputPtr = this->GetInput();
   OutputImagePointer outputPtr = this->GetOutput(0);
@@ -178,6 +213,78 @@ UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
     progress.CompletedPixel();  // potential exception thrown here
     }
 }
+
+template< class TInputImage, class TOutputImage, class TFunction >
+bool
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::CanFuse() const
+{
+  // The lines are addressed in the pixel buffers, so only plain images of
+  // the same dimension can take part in a fused pass.
+  return this->GetInput() != NULL
+         && typeid( TInputImage ) == typeid( Image< InputImagePixelType, Superclass::InputImageDimension > )
+         && typeid( TOutputImage ) == typeid( Image< OutputImagePixelType, Superclass::OutputImageDimension > )
+         && Superclass::InputImageDimension == Superclass::OutputImageDimension;
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+const DataObject *
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::GetFusionInput(unsigned int) const
+{
+  return this->GetInput();
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::BeforeFusedGenerateData()
+{
+  this->BeforeThreadedGenerateData();
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+const void *
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::GetFusionInputLine(unsigned int, const FusionIndexType & index) const
+{
+  const InputImageType *inputPtr = this->GetInput();
+
+  typename InputImageType::IndexType inputIndex;
+  inputIndex.Fill(0);
+  for ( unsigned int i = 0; i < Superclass::InputImageDimension && i < Superclass::OutputImageDimension; ++i )
+    {
+    inputIndex[i] = index[i];
+    }
+  return inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(inputIndex);
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void *
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::AllocateFusionLine(SizeValueType length) const
+{
+  return new OutputImagePixelType[length];
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::ReleaseFusionLine(void *line) const
+{
+  delete[] static_cast< OutputImagePixelType * >( line );
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void
+UnaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length)
+{
+  const InputImagePixelType *inputLine = static_cast< const InputImagePixelType * >( inputs[0] );
+  OutputImagePixelType *     outputLine = static_cast< OutputImagePixelType * >( output );
+
+  SpanEvaluatorType::Evaluate(m_Functor, inputLine, outputLine, length);
+}
 } // end namespace itk
 
 #endif
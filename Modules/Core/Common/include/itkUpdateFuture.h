@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkUpdateFuture_h
+#define __itkUpdateFuture_h
+
+#include "itkProcessObject.h"
+#include "itkThreadPool.h"
+
+namespace itk
+{
+/** \class UpdateFuture
+ * \brief Handle on an update started by ProcessObject::UpdateAsync().
+ *
+ * The update runs on a worker of the shared ThreadPool.  Wait() blocks
+ * until it is over and throws the exception that ended it, if any;
+ * WaitForAny() returns as soon as one of several updates is over, so
+ * that many independent pipelines can be launched and their results
+ * consumed in the order they complete.
+ *
+ * Cancel() is cooperative: it turns on AbortGenerateData on every
+ * ProcessObject of the pipeline, which the running ones poll through
+ * ProgressReporter, and the ProcessObjects that have not started yet
+ * throw ProcessAborted instead of executing.  The update then ends with
+ * the Canceled status.
+ *
+ * Destroying the last reference to the future waits for the end of the
+ * update.
+ *
+ * \code
+ * std::vector< itk::UpdateFuture::Pointer > futures;
+ * for ( unsigned int i = 0; i < writers.size(); ++i )
+ *   {
+ *   futures.push_back( writers[i]->UpdateAsync() );
+ *   }
+ * while ( !futures.empty() )
+ *   {
+ *   const unsigned int done = itk::UpdateFuture::WaitForAny(futures);
+ *   futures[done]->Wait(); // throws if the update failed
+ *   futures.erase( futures.begin() + done );
+ *   }
+ * \endcode
+ *
+ * \sa ProcessObject::UpdateAsync()
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT UpdateFuture:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef UpdateFuture               Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(UpdateFuture, Object);
+
+  typedef enum { Running, Completed, Canceled, Failed } StatusType;
+
+  /** The ProcessObject being updated. */
+  ProcessObject * GetProcessObject() const
+  { return m_ProcessObject; }
+
+  /** State of the update.  Canceled when it was stopped by Cancel(), and
+   * Failed when it ended with any other exception. */
+  StatusType GetStatus() const;
+
+  /** Return true when the update is over, whatever its status. */
+  bool IsDone() const
+  { return this->GetStatus() != Running; }
+
+  /** Block until the update is over.  Throws the exception that ended a
+   * failed update, and ProcessAborted for a canceled one. */
+  void Wait();
+
+  /** Request the cancellation of the update.  Does nothing once the
+   * update is over. */
+  void Cancel();
+
+  /** Block until one of the updates is over and return its index.
+   * Returns the size of futures when futures is empty. */
+  static unsigned int WaitForAny(const std::vector< Pointer > & futures);
+
+protected:
+  UpdateFuture(ProcessObject *processObject);
+  ~UpdateFuture();
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+private:
+  UpdateFuture(const Self &);   //purposely not implemented
+  void operator=(const Self &); //purposely not implemented
+
+  /** Queue the update on the pool, or run it right away when the pool
+   * cannot take it. */
+  void Start();
+
+  /** Body of the job. */
+  static ITK_THREAD_RETURN_TYPE UpdateCallback(void *arg);
+
+  /** Set the m_UpdateCanceled flag of every ProcessObject of the
+   * pipeline.  m_CompletionMutex must be held. */
+  void SetPipelineCanceled(bool flag);
+
+  ProcessObject::Pointer                m_ProcessObject;
+  std::vector< ProcessObject::Pointer > m_Pipeline;
+  StatusType                            m_Status;
+  ExceptionObject                       m_Exception;
+  bool                                  m_Queued;
+  ThreadPool::JobGroup                  m_JobGroup;
+
+  /** Guard the status of every future, and signal its changes.  The
+   * condition variable is created by the first Start(). */
+  static SimpleMutexLock            m_CompletionMutex;
+  static ConditionVariable::Pointer m_Completion;
+
+  friend class ProcessObject;
+};
+} // end namespace itk
+
+#endif
@@ -198,13 +198,18 @@ public:
   /** \endcond */
 
   /** Allocate the image memory. The size of the image must
-   * already be set, e.g. by calling SetRegions(). */
-  void Allocate();
+   * already be set, e.g. by calling SetRegions(), as well as the
+   * VectorLength.  All the components are set to zero if initializePixels
+   * is true, and left uninitialized otherwise. */
+  void Allocate(bool initializePixels = false);
 
   /** Restore the data object to its initial state. This means releasing
    * memory. */
   virtual void Initialize();
 
+  /** Write to the pages of the buffer holding the pixels of region. */
+  virtual void FirstTouch(const RegionType & region);
+
   /** Fill the image buffer with a value.  Be sure to call Allocate()
    * first. */
   void FillBuffer(const PixelType & value);
@@ -47,7 +47,7 @@ VectorImage< TPixel, VImageDimension >
 template< class TPixel, unsigned int VImageDimension >
 void
 VectorImage< TPixel, VImageDimension >
-::Allocate()
+::Allocate(bool initializePixels)
 {
   if ( m_VectorLength == 0 )
     {
@@ -58,7 +58,15 @@ VectorImage< TPixel, VImageDimension >
   this->ComputeOffsetTable();
   num = this->GetOffsetTable()[VImageDimension];
 
-  m_Buffer->Reserve(num * m_VectorLength);
+  m_Buffer->Reserve(num * m_VectorLength, initializePixels);
+}
+
+template< class TPixel, unsigned int VImageDimension >
+void
+VectorImage< TPixel, VImageDimension >
+::FirstTouch(const RegionType & region)
+{
+  this->FirstTouchBuffer(m_Buffer->GetBufferPointer(), sizeof( InternalPixelType ) * m_VectorLength, region);
 }
 
 template< class TPixel, unsigned int VImageDimension >
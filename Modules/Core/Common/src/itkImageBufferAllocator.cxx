@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkImageBufferPool.h"
+#include "itkPipelineTracer.h"
+#include "itksys/SystemTools.hxx"
+
+#include <cstdlib>
+
+#if defined( _WIN32 )
+#include <malloc.h>
+#endif
+
+#if defined( ITK_HAVE_MADVISE )
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+// Size of the transparent huge pages on x86-64 and aarch64 with 4 KiB
+// base pages.
+const itk::SizeValueType HugePageSize = 2 * 1024 * 1024;
+
+// Smallest memory page size on the supported systems.
+const itk::SizeValueType PageSize = 4096;
+
+// Default size from which the buffers are backed by huge pages.
+const itk::SizeValueType DefaultHugePageThreshold = 1024 * 1024 * 1024;
+}
+
+namespace itk
+{
+// Initialize static members that control the huge page hints : not
+// initialized, the environment is checked on first use.
+SizeValueType ImageBufferAllocator:: m_GlobalHugePageThreshold = DefaultHugePageThreshold;
+bool          ImageBufferAllocator:: m_GlobalHugePageThresholdIsInitialized = false;
+
+void ImageBufferAllocator::SetGlobalHugePageThreshold(SizeValueType numberOfBytes)
+{
+  m_GlobalHugePageThreshold = numberOfBytes;
+  m_GlobalHugePageThresholdIsInitialized = true;
+}
+
+SizeValueType ImageBufferAllocator::GetGlobalHugePageThreshold()
+{
+  if ( !m_GlobalHugePageThresholdIsInitialized )
+    {
+    itksys_stl::string thresholdEnv;
+    if ( itksys::SystemTools::GetEnv("ITK_HUGE_PAGE_THRESHOLD", thresholdEnv) )
+      {
+      m_GlobalHugePageThreshold = static_cast< SizeValueType >( atof( thresholdEnv.c_str() ) );
+      }
+    m_GlobalHugePageThresholdIsInitialized = true;
+    }
+  return m_GlobalHugePageThreshold;
+}
+
+void * ImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  PipelineTracer::Scope traceScope("ImageBufferAllocator::Allocate", "memory");
+  traceScope.SetNumberOfBytes(numberOfBytes);
+  return ImageBufferPool::GetInstance()->Allocate(numberOfBytes);
+}
+
+void ImageBufferAllocator::Free(void *buffer)
+{
+  if ( buffer == NULL )
+    {
+    return;
+    }
+  ImageBufferPool::GetInstance()->Free(buffer);
+}
+
+void * ImageBufferAllocator::AllocateFromSystem(SizeValueType numberOfBytes)
+{
+  // Never return NULL for an empty buffer, NULL means failure.
+  if ( numberOfBytes == 0 )
+    {
+    numberOfBytes = 1;
+    }
+
+  const SizeValueType threshold = GetGlobalHugePageThreshold();
+  const bool          useHugePages = threshold > 0 && numberOfBytes >= threshold;
+  const SizeValueType alignment = useHugePages ? HugePageSize : static_cast< SizeValueType >( Alignment );
+
+  void *buffer = NULL;
+
+#if defined( _WIN32 )
+  buffer = _aligned_malloc(numberOfBytes, alignment);
+#elif defined( ITK_HAVE_POSIX_MEMALIGN )
+  if ( posix_memalign(&buffer, alignment, numberOfBytes) != 0 )
+    {
+    buffer = NULL;
+    }
+#else
+  // Over-allocate and keep the offset to the block returned by malloc()
+  // just before the aligned buffer.
+  void *block = malloc(numberOfBytes + alignment);
+  if ( block )
+    {
+    unsigned char *aligned = static_cast< unsigned char * >( block ) + alignment;
+    aligned -= reinterpret_cast< size_t >( aligned ) % alignment;
+    reinterpret_cast< void ** >( aligned )[-1] = block;
+    buffer = aligned;
+    }
+#endif
+
+#if defined( ITK_HAVE_MADVISE ) && defined( MADV_HUGEPAGE )
+  if ( buffer && useHugePages )
+    {
+    // Only a hint: the kernel may ignore it, e.g. when transparent huge
+    // pages are disabled, so the result is not checked.
+    madvise(buffer, numberOfBytes, MADV_HUGEPAGE);
+    }
+#endif
+
+  return buffer;
+}
+
+void ImageBufferAllocator::FreeToSystem(void *buffer)
+{
+  if ( buffer == NULL )
+    {
+    return;
+    }
+
+#if defined( _WIN32 )
+  _aligned_free(buffer);
+#elif defined( ITK_HAVE_POSIX_MEMALIGN )
+  free(buffer);
+#else
+  free( static_cast< void ** >( buffer )[-1] );
+#endif
+}
+
+void ImageBufferAllocator::TouchPages(void *buffer, SizeValueType numberOfBytes)
+{
+  if ( buffer == NULL || numberOfBytes == 0 )
+    {
+    return;
+    }
+
+  // The accesses must not be optimized away.
+  volatile unsigned char *bytes = static_cast< volatile unsigned char * >( buffer );
+
+  // Touch the first byte of each page, starting with the page holding the
+  // first byte of the range, then the last byte.
+  const SizeValueType firstPageOffset = reinterpret_cast< size_t >( buffer ) % PageSize;
+  bytes[0] = bytes[0];
+  for ( SizeValueType i = PageSize - firstPageOffset; i < numberOfBytes; i += PageSize )
+    {
+    bytes[i] = bytes[i];
+    }
+  bytes[numberOfBytes - 1] = bytes[numberOfBytes - 1];
+}
+} // end namespace itk
@@ -0,0 +1,308 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferPool.h"
+#include "itkImageBufferAllocator.h"
+#include "itkMutexLockHolder.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace itk
+{
+ImageBufferPool::Pointer ImageBufferPool::m_ImageBufferPoolInstance;
+SimpleFastMutexLock      ImageBufferPool::m_ImageBufferPoolInstanceMutex;
+
+ImageBufferPool::Pointer
+ImageBufferPool
+::GetInstance()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_ImageBufferPoolInstanceMutex);
+  if ( m_ImageBufferPoolInstance.IsNull() )
+    {
+    // The pool is a process-wide resource, so it is not created through
+    // the object factory.
+    m_ImageBufferPoolInstance = new ImageBufferPool;
+    m_ImageBufferPoolInstance->UnRegister();
+    }
+  return m_ImageBufferPoolInstance;
+}
+
+ImageBufferPool
+::ImageBufferPool()
+{
+  m_MaximumNumberOfCachedBytes = 0;
+  m_MinimumBufferSize = 1024 * 1024;
+  m_NumberOfCachedBytes = 0;
+  m_NumberOfBytesInUse = 0;
+
+  m_NumberOfRequests = 0;
+  m_NumberOfHits = 0;
+  m_NumberOfEvictions = 0;
+  m_PeakNumberOfBytes = 0;
+
+  itksys_stl::string poolSizeEnv;
+  if ( itksys::SystemTools::GetEnv("ITK_IMAGE_BUFFER_POOL_SIZE", poolSizeEnv) )
+    {
+    m_MaximumNumberOfCachedBytes = static_cast< SizeValueType >( atof( poolSizeEnv.c_str() ) );
+    }
+}
+
+ImageBufferPool
+::~ImageBufferPool()
+{
+  this->ReleaseCachedBuffers();
+}
+
+void
+ImageBufferPool
+::SetMaximumNumberOfCachedBytes(SizeValueType numberOfBytes)
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  m_MaximumNumberOfCachedBytes = numberOfBytes;
+  this->ShrinkCache(numberOfBytes);
+}
+
+SizeValueType
+ImageBufferPool
+::GetMaximumNumberOfCachedBytes() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_MaximumNumberOfCachedBytes;
+}
+
+void
+ImageBufferPool
+::SetMinimumBufferSize(SizeValueType numberOfBytes)
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  m_MinimumBufferSize = numberOfBytes;
+}
+
+SizeValueType
+ImageBufferPool
+::GetMinimumBufferSize() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_MinimumBufferSize;
+}
+
+SizeValueType
+ImageBufferPool
+::GetBucketSize(SizeValueType numberOfBytes)
+{
+  // Highest power of two not larger than numberOfBytes.
+  SizeValueType octave = 1;
+  while ( octave <= numberOfBytes / 2 )
+    {
+    octave *= 2;
+    }
+
+  const SizeValueType step = octave / BucketsPerOctave;
+  if ( step <= 1 )
+    {
+    return numberOfBytes;
+    }
+  return ( ( numberOfBytes + step - 1 ) / step ) * step;
+}
+
+void *
+ImageBufferPool
+::Allocate(SizeValueType numberOfBytes)
+{
+  m_Mutex.Lock();
+  if ( m_MaximumNumberOfCachedBytes == 0 || numberOfBytes < m_MinimumBufferSize )
+    {
+    m_Mutex.Unlock();
+    return ImageBufferAllocator::AllocateFromSystem(numberOfBytes);
+    }
+
+  const SizeValueType bucketSize = GetBucketSize(numberOfBytes);
+  void *              buffer = NULL;
+
+  ++m_NumberOfRequests;
+  CachedBuffersType::iterator bucket = m_CachedBuffers.find(bucketSize);
+  if ( bucket != m_CachedBuffers.end() && !bucket->second.empty() )
+    {
+    buffer = bucket->second.back();
+    bucket->second.pop_back();
+    m_NumberOfCachedBytes -= bucketSize;
+    ++m_NumberOfHits;
+    }
+  m_Mutex.Unlock();
+
+  if ( buffer == NULL )
+    {
+    buffer = ImageBufferAllocator::AllocateFromSystem(bucketSize);
+    if ( buffer == NULL )
+      {
+      // The cached buffers may be what prevents the allocation.
+      this->ReleaseCachedBuffers();
+      buffer = ImageBufferAllocator::AllocateFromSystem(bucketSize);
+      if ( buffer == NULL )
+        {
+        return NULL;
+        }
+      }
+    }
+
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  m_BuffersInUse[buffer] = bucketSize;
+  m_NumberOfBytesInUse += bucketSize;
+  m_PeakNumberOfBytes = std::max( m_PeakNumberOfBytes, m_NumberOfBytesInUse + m_NumberOfCachedBytes );
+  return buffer;
+}
+
+void
+ImageBufferPool
+::Free(void *buffer)
+{
+  if ( buffer == NULL )
+    {
+    return;
+    }
+
+  m_Mutex.Lock();
+  BuffersInUseType::iterator inUse = m_BuffersInUse.find(buffer);
+  if ( inUse == m_BuffersInUse.end() )
+    {
+    // Not allocated through the pool.
+    m_Mutex.Unlock();
+    ImageBufferAllocator::FreeToSystem(buffer);
+    return;
+    }
+
+  const SizeValueType bucketSize = inUse->second;
+  m_BuffersInUse.erase(inUse);
+  m_NumberOfBytesInUse -= bucketSize;
+
+  if ( m_NumberOfCachedBytes + bucketSize <= m_MaximumNumberOfCachedBytes )
+    {
+    m_CachedBuffers[bucketSize].push_back(buffer);
+    m_NumberOfCachedBytes += bucketSize;
+    m_Mutex.Unlock();
+    return;
+    }
+  ++m_NumberOfEvictions;
+  m_Mutex.Unlock();
+
+  ImageBufferAllocator::FreeToSystem(buffer);
+}
+
+void
+ImageBufferPool
+::ReleaseCachedBuffers()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  this->ShrinkCache(0);
+}
+
+void
+ImageBufferPool
+::ShrinkCache(SizeValueType numberOfBytes)
+{
+  // Release the largest buffers first.
+  CachedBuffersType::reverse_iterator bucket = m_CachedBuffers.rbegin();
+  while ( m_NumberOfCachedBytes > numberOfBytes && bucket != m_CachedBuffers.rend() )
+    {
+    while ( m_NumberOfCachedBytes > numberOfBytes && !bucket->second.empty() )
+      {
+      ImageBufferAllocator::FreeToSystem( bucket->second.back() );
+      bucket->second.pop_back();
+      m_NumberOfCachedBytes -= bucket->first;
+      }
+    ++bucket;
+    }
+}
+
+SizeValueType
+ImageBufferPool
+::GetNumberOfRequests() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_NumberOfRequests;
+}
+
+SizeValueType
+ImageBufferPool
+::GetNumberOfHits() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_NumberOfHits;
+}
+
+SizeValueType
+ImageBufferPool
+::GetNumberOfEvictions() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_NumberOfEvictions;
+}
+
+SizeValueType
+ImageBufferPool
+::GetPeakNumberOfBytes() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_PeakNumberOfBytes;
+}
+
+SizeValueType
+ImageBufferPool
+::GetNumberOfBytesInUse() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_NumberOfBytesInUse;
+}
+
+SizeValueType
+ImageBufferPool
+::GetNumberOfCachedBytes() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_NumberOfCachedBytes;
+}
+
+void
+ImageBufferPool
+::ResetStatistics()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  m_NumberOfRequests = 0;
+  m_NumberOfHits = 0;
+  m_NumberOfEvictions = 0;
+  m_PeakNumberOfBytes = m_NumberOfBytesInUse + m_NumberOfCachedBytes;
+}
+
+void
+ImageBufferPool
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  os << indent << "MaximumNumberOfCachedBytes: " << m_MaximumNumberOfCachedBytes << std::endl;
+  os << indent << "MinimumBufferSize: " << m_MinimumBufferSize << std::endl;
+  os << indent << "NumberOfCachedBytes: " << m_NumberOfCachedBytes << std::endl;
+  os << indent << "NumberOfBytesInUse: " << m_NumberOfBytesInUse << std::endl;
+  os << indent << "NumberOfRequests: " << m_NumberOfRequests << std::endl;
+  os << indent << "NumberOfHits: " << m_NumberOfHits << std::endl;
+  os << indent << "NumberOfEvictions: " << m_NumberOfEvictions << std::endl;
+  os << indent << "PeakNumberOfBytes: " << m_PeakNumberOfBytes << std::endl;
+}
+} // end namespace itk
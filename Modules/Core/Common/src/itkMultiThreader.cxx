@@ -26,6 +26,8 @@
  *
  *=========================================================================*/
 #include "itkMultiThreader.h"
+#include "itkThreadPool.h"
+#include "itkPipelineTracer.h"
 #include "itkNumericTraits.h"
 #include <iostream>
 
@@ -48,6 +50,61 @@ ThreadIdType MultiThreader:: m_GlobalMaximumNumberOfThreads = ITK_MAX_THREADS;
 // => Not initialized.
 ThreadIdType MultiThreader:: m_GlobalDefaultNumberOfThreads = 0;
 
+// Initialize static members that control the default use of the thread
+// pool : not initialized, the environment is checked on first use.
+bool MultiThreader:: m_GlobalDefaultUseThreadPool = false;
+bool MultiThreader:: m_GlobalDefaultUseThreadPoolIsInitialized = false;
+bool MultiThreader:: m_GlobalDefaultUseThreadAffinity = false;
+bool MultiThreader:: m_GlobalDefaultUseThreadAffinityIsInitialized = false;
+
+void MultiThreader::SetGlobalDefaultUseThreadPool(bool flag)
+{
+  m_GlobalDefaultUseThreadPool = flag;
+  m_GlobalDefaultUseThreadPoolIsInitialized = true;
+}
+
+bool MultiThreader::GetGlobalDefaultUseThreadPool()
+{
+  if ( !m_GlobalDefaultUseThreadPoolIsInitialized )
+    {
+    itksys_stl::string useThreadPoolEnv;
+    if ( itksys::SystemTools::GetEnv("ITK_USE_THREADPOOL", useThreadPoolEnv) )
+      {
+      useThreadPoolEnv = itksys::SystemTools::UpperCase(useThreadPoolEnv);
+      m_GlobalDefaultUseThreadPool = ( useThreadPoolEnv == "ON"
+                                       || useThreadPoolEnv == "TRUE"
+                                       || useThreadPoolEnv == "YES"
+                                       || atoi( useThreadPoolEnv.c_str() ) != 0 );
+      }
+    m_GlobalDefaultUseThreadPoolIsInitialized = true;
+    }
+  return m_GlobalDefaultUseThreadPool;
+}
+
+void MultiThreader::SetGlobalDefaultUseThreadAffinity(bool flag)
+{
+  m_GlobalDefaultUseThreadAffinity = flag;
+  m_GlobalDefaultUseThreadAffinityIsInitialized = true;
+}
+
+bool MultiThreader::GetGlobalDefaultUseThreadAffinity()
+{
+  if ( !m_GlobalDefaultUseThreadAffinityIsInitialized )
+    {
+    itksys_stl::string useThreadAffinityEnv;
+    if ( itksys::SystemTools::GetEnv("ITK_USE_THREAD_AFFINITY", useThreadAffinityEnv) )
+      {
+      useThreadAffinityEnv = itksys::SystemTools::UpperCase(useThreadAffinityEnv);
+      m_GlobalDefaultUseThreadAffinity = ( useThreadAffinityEnv == "ON"
+                                           || useThreadAffinityEnv == "TRUE"
+                                           || useThreadAffinityEnv == "YES"
+                                           || atoi( useThreadAffinityEnv.c_str() ) != 0 );
+      }
+    m_GlobalDefaultUseThreadAffinityIsInitialized = true;
+    }
+  return m_GlobalDefaultUseThreadAffinity;
+}
+
 void MultiThreader::SetGlobalMaximumNumberOfThreads(ThreadIdType val)
 {
   m_GlobalMaximumNumberOfThreads = val;
@@ -201,6 +258,8 @@ MultiThreader::MultiThreader()
   m_SingleMethod = 0;
   m_SingleData = 0;
   m_NumberOfThreads = this->GetGlobalDefaultNumberOfThreads();
+  m_UseThreadPool = this->GetGlobalDefaultUseThreadPool();
+  m_UseThreadAffinity = this->GetGlobalDefaultUseThreadAffinity();
 }
 
 MultiThreader::~MultiThreader()
@@ -256,14 +315,38 @@ void MultiThreader::SingleMethodExecute()
   // exceptions thrown by threads.
   bool        exceptionOccurred = false;
   std::string exceptionDetails;
-  try
+
+  for ( thread_loop = 1; thread_loop < m_NumberOfThreads; thread_loop++ )
     {
+    m_ThreadInfoArray[thread_loop].UserData    = m_SingleData;
+    m_ThreadInfoArray[thread_loop].NumberOfThreads = m_NumberOfThreads;
+    m_ThreadInfoArray[thread_loop].ThreadFunction = m_SingleMethod;
+    }
+
+  // When requested, run the other threads on the persistent workers of
+  // the thread pool.  If the pool cannot run all of them at once, fall
+  // back to creating threads.
+  ThreadPool::Pointer  threadPool;
+  ThreadPool::JobGroup threadPoolJobs;
+  if ( m_UseThreadPool && m_NumberOfThreads > 1 )
+    {
+    std::vector< void * > userData;
     for ( thread_loop = 1; thread_loop < m_NumberOfThreads; thread_loop++ )
       {
-      m_ThreadInfoArray[thread_loop].UserData    = m_SingleData;
-      m_ThreadInfoArray[thread_loop].NumberOfThreads = m_NumberOfThreads;
-      m_ThreadInfoArray[thread_loop].ThreadFunction = m_SingleMethod;
+      userData.push_back( &m_ThreadInfoArray[thread_loop] );
+      }
+    threadPool = ThreadPool::GetInstance();
+    if ( !threadPool->AddWork(m_UseThreadAffinity ? this->SingleMethodAffinityProxy : this->SingleMethodProxy,
+                              userData, threadPoolJobs) )
+      {
+      threadPool = 0;
+      }
+    }
 
+  try
+    {
+    for ( thread_loop = 1; threadPool.IsNull() && thread_loop < m_NumberOfThreads; thread_loop++ )
+      {
       process_id[thread_loop] =
         this->DispatchSingleMethodThread(&m_ThreadInfoArray[thread_loop]);
       }
@@ -290,13 +373,18 @@ void MultiThreader::SingleMethodExecute()
     {
     m_ThreadInfoArray[0].UserData = m_SingleData;
     m_ThreadInfoArray[0].NumberOfThreads = m_NumberOfThreads;
+    PipelineTracer::Scope traceScope("MultiThreader::SingleMethod", "thread");
     m_SingleMethod( (void *)( &m_ThreadInfoArray[0] ) );
     }
   catch ( ProcessAborted & excp )
     {
     // Need cleanup and rethrow ProcessAborted
     // close down other threads
-    for ( thread_loop = 1; thread_loop < m_NumberOfThreads; thread_loop++ )
+    if ( threadPool.IsNotNull() )
+      {
+      threadPool->WaitForWork(threadPoolJobs);
+      }
+    for ( thread_loop = 1; threadPool.IsNull() && thread_loop < m_NumberOfThreads; thread_loop++ )
       {
       try
         {
@@ -325,11 +413,18 @@ void MultiThreader::SingleMethodExecute()
 
   // The parent thread has finished this->SingleMethod() - so now it
   // waits for each of the other processes to exit
+  if ( threadPool.IsNotNull() )
+    {
+    threadPool->WaitForWork(threadPoolJobs);
+    }
   for ( thread_loop = 1; thread_loop < m_NumberOfThreads; thread_loop++ )
     {
     try
       {
-      this->WaitForSingleMethodThread(process_id[thread_loop]);
+      if ( threadPool.IsNull() )
+        {
+        this->WaitForSingleMethodThread(process_id[thread_loop]);
+        }
       if ( m_ThreadInfoArray[thread_loop].ThreadExitCode
            != ThreadInfoStruct::SUCCESS )
         {
@@ -372,6 +467,7 @@ MultiThreader
   // execute the user specified threader callback, catching any exceptions
   try
     {
+    PipelineTracer::Scope traceScope("MultiThreader::SingleMethod", "thread");
     ( *threadInfoStruct->ThreadFunction )(threadInfoStruct);
     threadInfoStruct->ThreadExitCode = MultiThreader::ThreadInfoStruct::SUCCESS;
     }
@@ -397,6 +493,16 @@ MultiThreader
 
   return ITK_THREAD_RETURN_VALUE;
 }
+
+ITK_THREAD_RETURN_TYPE
+MultiThreader
+::SingleMethodAffinityProxy(void *arg)
+{
+  MultiThreader::SetCurrentThreadAffinity(
+    reinterpret_cast< MultiThreader::ThreadInfoStruct * >( arg )->ThreadID );
+  return MultiThreader::SingleMethodProxy(arg);
+}
+
 // Print method for the multithreader
 void MultiThreader::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -407,6 +513,12 @@ void MultiThreader::PrintSelf(std::ostream & os, Indent indent) const
      << m_GlobalMaximumNumberOfThreads << std::endl;
   os << indent << "Global Default Number Of Threads: "
      << m_GlobalDefaultNumberOfThreads << std::endl;
+  os << indent << "Use Thread Pool: " << m_UseThreadPool << std::endl;
+  os << indent << "Global Default Use Thread Pool: "
+     << m_GlobalDefaultUseThreadPool << std::endl;
+  os << indent << "Use Thread Affinity: " << m_UseThreadAffinity << std::endl;
+  os << indent << "Global Default Use Thread Affinity: "
+     << m_GlobalDefaultUseThreadAffinity << std::endl;
 }
 
 
@@ -141,4 +141,12 @@ MultiThreader
   // No threading library specified.  Do nothing.  The computation
   // will be run by the main execution thread.
 }
+
+void
+MultiThreader
+::SetCurrentThreadAffinity(ThreadIdType)
+{
+  // No threading library specified.  There is only the main thread,
+  // which is never pinned.
+}
 } // end namespace itk
@@ -30,6 +30,11 @@
 #include "itksys/SystemTools.hxx"
 #include <stdlib.h>
 
+#if defined( ITK_HAVE_PTHREAD_SETAFFINITY_NP )
+#include <sched.h>
+#include <unistd.h>
+#endif
+
 #ifdef __APPLE__
 #include <sys/types.h>
 #include <sys/sysctl.h>
@@ -238,7 +243,9 @@ MultiThreader
 
   int threadError;
   threadError =
-    pthread_create( &threadHandle, &attr, reinterpret_cast< c_void_cast >( this->SingleMethodProxy ),
+    pthread_create( &threadHandle, &attr,
+                    reinterpret_cast< c_void_cast >( m_UseThreadAffinity ? this->SingleMethodAffinityProxy
+                                                                         : this->SingleMethodProxy ),
                     reinterpret_cast< void * >( threadInfo ) );
   if ( threadError != 0 )
     {
@@ -247,4 +254,40 @@ MultiThreader
     }
   return threadHandle;
 }
+
+void
+MultiThreader
+::SetCurrentThreadAffinity(ThreadIdType threadId)
+{
+#if defined( ITK_HAVE_PTHREAD_SETAFFINITY_NP ) && defined( CPU_SET )
+  // Spread the threads over the processors the process may run on.  The
+  // affinity of the main thread, which is never pinned, gives that set.
+  cpu_set_t available;
+  CPU_ZERO(&available);
+  if ( sched_getaffinity(getpid(), sizeof( available ), &available) != 0 )
+    {
+    return;
+    }
+  const int numberOfProcessors = CPU_COUNT(&available);
+  if ( numberOfProcessors <= 0 )
+    {
+    return;
+    }
+
+  int remaining = static_cast< int >( threadId % numberOfProcessors );
+  for ( int cpu = 0; cpu < CPU_SETSIZE; ++cpu )
+    {
+    if ( CPU_ISSET(cpu, &available) && remaining-- == 0 )
+      {
+      cpu_set_t processor;
+      CPU_ZERO(&processor);
+      CPU_SET(cpu, &processor);
+      pthread_setaffinity_np(pthread_self(), sizeof( processor ), &processor);
+      return;
+      }
+    }
+#else
+  (void)threadId;
+#endif
+}
 } // end namespace itk
@@ -194,7 +194,9 @@ MultiThreader
   // Using _beginthreadex on a PC
   DWORD  threadId;
   HANDLE threadHandle =  (HANDLE)_beginthreadex(0, 0,
-                                                ( unsigned int (__stdcall *)(void *) ) this->SingleMethodProxy,
+                                                ( unsigned int (__stdcall *)(void *) )
+                                                ( m_UseThreadAffinity ? this->SingleMethodAffinityProxy
+                                                                      : this->SingleMethodProxy ),
                                                 ( (void *)threadInfo ), 0, (unsigned int *)&threadId);
   if ( threadHandle == NULL )
     {
@@ -202,4 +204,38 @@ MultiThreader
     }
   return threadHandle;
 }
+
+void
+MultiThreader
+::SetCurrentThreadAffinity(ThreadIdType threadId)
+{
+  // Spread the threads over the processors the process may run on.
+  DWORD_PTR processMask;
+  DWORD_PTR systemMask;
+  if ( !GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask) )
+    {
+    return;
+    }
+
+  unsigned int numberOfProcessors = 0;
+  for ( DWORD_PTR mask = processMask; mask; mask >>= 1 )
+    {
+    numberOfProcessors += static_cast< unsigned int >( mask & 1 );
+    }
+  if ( numberOfProcessors == 0 )
+    {
+    return;
+    }
+
+  unsigned int remaining = threadId % numberOfProcessors;
+  for ( unsigned int cpu = 0; cpu < 8 * sizeof( DWORD_PTR ); ++cpu )
+    {
+    const DWORD_PTR processor = static_cast< DWORD_PTR >( 1 ) << cpu;
+    if ( ( processMask & processor ) && remaining-- == 0 )
+      {
+      SetThreadAffinityMask(GetCurrentThread(), processor);
+      return;
+      }
+    }
+}
 } // end namespace itk
@@ -0,0 +1,275 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineTracer.h"
+#include "itkMutexLockHolder.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+
+#if defined( ITK_USE_PTHREADS )
+#include <pthread.h>
+#elif defined( ITK_USE_WIN32_THREADS )
+#include "itkWindows.h"
+#endif
+
+namespace
+{
+// Write a string as a JSON string literal.
+void WriteJSONString(std::ostream & os, const std::string & value)
+{
+  os << '"';
+  for ( std::string::const_iterator it = value.begin(); it != value.end(); ++it )
+    {
+    if ( *it == '"' || *it == '\\' )
+      {
+      os << '\\';
+      }
+    if ( static_cast< unsigned char >( *it ) >= 0x20 )
+      {
+      os << *it;
+      }
+    }
+  os << '"';
+}
+}
+
+namespace itk
+{
+PipelineTracer::Pointer PipelineTracer::m_PipelineTracerInstance;
+SimpleFastMutexLock     PipelineTracer::m_PipelineTracerInstanceMutex;
+
+// Initialize static members that control the recording: not
+// initialized, the environment is checked on first use.
+bool PipelineTracer:: m_Enabled = false;
+bool PipelineTracer:: m_EnabledIsInitialized = false;
+
+PipelineTracer::Pointer
+PipelineTracer
+::GetInstance()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_PipelineTracerInstanceMutex);
+  if ( m_PipelineTracerInstance.IsNull() )
+    {
+    // The tracer is a process-wide resource, so it is not created
+    // through the object factory.
+    m_PipelineTracerInstance = new PipelineTracer;
+    m_PipelineTracerInstance->UnRegister();
+    }
+  return m_PipelineTracerInstance;
+}
+
+void
+PipelineTracer
+::SetEnabled(bool flag)
+{
+  m_Enabled = flag;
+  m_EnabledIsInitialized = true;
+}
+
+void
+PipelineTracer
+::InitializeFromEnvironment()
+{
+  itksys_stl::string fileName;
+  m_EnabledIsInitialized = true;
+  if ( itksys::SystemTools::GetEnv("ITK_PIPELINE_TRACE", fileName) && !fileName.empty() )
+    {
+    // The instance keeps the file name, and writes the trace when it is
+    // destroyed.
+    GetInstance();
+    m_Enabled = true;
+    }
+}
+
+PipelineTracer
+::PipelineTracer()
+{
+  m_Clock = RealTimeClock::New();
+  m_Origin = m_Clock->GetTimeInSeconds();
+
+  itksys_stl::string fileName;
+  if ( itksys::SystemTools::GetEnv("ITK_PIPELINE_TRACE", fileName) )
+    {
+    m_FileName = fileName;
+    }
+}
+
+PipelineTracer
+::~PipelineTracer()
+{
+  if ( !m_FileName.empty() )
+    {
+    try
+      {
+      this->WriteChromeTrace(m_FileName);
+      }
+    catch ( ExceptionObject & excp )
+      {
+      std::cerr << excp << std::endl;
+      }
+    }
+}
+
+double
+PipelineTracer
+::GetTime() const
+{
+  return ( m_Clock->GetTimeInSeconds() - m_Origin ) * 1e6;
+}
+
+unsigned int
+PipelineTracer
+::GetCurrentThreadIndex()
+{
+#if defined( ITK_USE_PTHREADS )
+  const unsigned long threadId = (unsigned long)pthread_self();
+#elif defined( ITK_USE_WIN32_THREADS )
+  const unsigned long threadId = GetCurrentThreadId();
+#else
+  const unsigned long threadId = 0;
+#endif
+
+  std::map< unsigned long, unsigned int >::const_iterator it = m_ThreadIndices.find(threadId);
+  if ( it != m_ThreadIndices.end() )
+    {
+    return it->second;
+    }
+  const unsigned int index = static_cast< unsigned int >( m_ThreadIndices.size() );
+  m_ThreadIndices[threadId] = index;
+  return index;
+}
+
+void
+PipelineTracer
+::AddSpan(const std::string & name, const char *category,
+          double start, double duration, SizeValueType numberOfBytes)
+{
+  Span span;
+  span.Name = name;
+  span.Category = category;
+  span.Start = start;
+  span.Duration = duration;
+  span.NumberOfBytes = numberOfBytes;
+
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  span.ThreadIndex = this->GetCurrentThreadIndex();
+  m_Spans.push_back(span);
+}
+
+SizeValueType
+PipelineTracer
+::GetNumberOfSpans() const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  return m_Spans.size();
+}
+
+void
+PipelineTracer
+::Clear()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+  m_Spans.clear();
+}
+
+void
+PipelineTracer
+::WriteChromeTrace(std::ostream & os) const
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_Mutex);
+
+  // Keep the sub-microsecond digits of long traces.
+  const std::streamsize precision = os.precision(15);
+
+  os << "{\"traceEvents\":[";
+  for ( std::vector< Span >::const_iterator it = m_Spans.begin(); it != m_Spans.end(); ++it )
+    {
+    os << ( it == m_Spans.begin() ? "\n" : ",\n" );
+    os << "{\"name\":";
+    WriteJSONString(os, it->Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, it->Category);
+    os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << it->ThreadIndex
+       << ",\"ts\":" << it->Start << ",\"dur\":" << it->Duration;
+    if ( it->NumberOfBytes > 0 )
+      {
+      os << ",\"args\":{\"bytes\":" << it->NumberOfBytes << "}";
+      }
+    os << "}";
+    }
+  os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+  os.precision(precision);
+}
+
+void
+PipelineTracer
+::WriteChromeTrace(const std::string & fileName) const
+{
+  std::ofstream file( fileName.c_str() );
+  if ( !file )
+    {
+    itkExceptionMacro(<< "Cannot open " << fileName << " for writing");
+    }
+  this->WriteChromeTrace(file);
+  if ( !file )
+    {
+    itkExceptionMacro(<< "Cannot write the trace to " << fileName);
+    }
+}
+
+void
+PipelineTracer
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Enabled: " << ( m_Enabled ? "On" : "Off" ) << std::endl;
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "NumberOfSpans: " << this->GetNumberOfSpans() << std::endl;
+}
+
+PipelineTracer::Scope
+::Scope(const char *phase, const char *category, const Object *object):
+  m_Category(category),
+  m_Start(0),
+  m_NumberOfBytes(0)
+{
+  if ( !PipelineTracer::GetEnabled() )
+    {
+    return;
+    }
+
+  m_Tracer = PipelineTracer::GetInstance();
+  if ( object )
+    {
+    m_Name = object->GetNameOfClass();
+    m_Name += "::";
+    }
+  m_Name += phase;
+  m_Start = m_Tracer->GetTime();
+}
+
+PipelineTracer::Scope
+::~Scope()
+{
+  if ( m_Tracer.IsNotNull() )
+    {
+    m_Tracer->AddSpan(m_Name, m_Category, m_Start, m_Tracer->GetTime() - m_Start, m_NumberOfBytes);
+    }
+}
+} // end namespace itk
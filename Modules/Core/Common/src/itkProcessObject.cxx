@@ -26,11 +26,158 @@
  *
  *=========================================================================*/
 #include "itkProcessObject.h"
+#include "itkPipelineTracer.h"
+#include "itkThreadPool.h"
+#include "itkUpdateFuture.h"
+#include "itksys/SystemTools.hxx"
 
 #include <stdio.h>
+#include <stdlib.h>
+
+namespace
+{
+// The update of one input branch by ProcessObject::UpdateInputsConcurrently(),
+// and the exception that ended it.
+struct InputBranchUpdate
+{
+  itk::DataObject *     Input;
+  bool                  Failed;
+  bool                  Aborted;
+  itk::ExceptionObject  Exception;
+};
+
+ITK_THREAD_RETURN_TYPE UpdateInputBranch(void *arg)
+{
+  InputBranchUpdate *branch = static_cast< InputBranchUpdate * >( arg );
+
+  try
+    {
+    branch->Input->UpdateOutputData();
+    }
+  catch ( itk::ProcessAborted & excp )
+    {
+    branch->Failed = true;
+    branch->Aborted = true;
+    branch->Exception = excp;
+    }
+  catch ( itk::ExceptionObject & excp )
+    {
+    branch->Failed = true;
+    branch->Exception = excp;
+    }
+  catch ( std::exception & excp )
+    {
+    branch->Failed = true;
+    branch->Exception = itk::ExceptionObject(__FILE__, __LINE__, excp.what(), "UpdateInputBranch");
+    }
+  catch ( ... )
+    {
+    branch->Failed = true;
+    branch->Exception = itk::ExceptionObject(__FILE__, __LINE__, "Unknown exception", "UpdateInputBranch");
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+// Add to branch the ProcessObjects upstream of data.  Returns false when
+// one of them is already in others, i.e. the branches are not independent.
+bool CollectInputBranch(itk::DataObject *data,
+                        const std::set< const itk::ProcessObject * > & others,
+                        std::set< const itk::ProcessObject * > & branch)
+{
+  std::vector< itk::DataObject * > pending(1, data);
+  while ( !pending.empty() )
+    {
+    itk::ProcessObject *source = pending.back()->GetSource().GetPointer();
+    pending.pop_back();
+    if ( !source || !branch.insert(source).second )
+      {
+      continue;
+      }
+    if ( others.count(source) )
+      {
+      return false;
+      }
+    itk::ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+    for ( itk::ProcessObject::DataObjectPointerArraySizeType i = 0; i < inputs.size(); ++i )
+      {
+      if ( inputs[i] )
+        {
+        pending.push_back(inputs[i]);
+        }
+      }
+    }
+  return true;
+}
+}
 
 namespace itk
 {
+// Initialize static members that control the automatic in-place
+// planning: not initialized, the environment is checked on first use.
+bool ProcessObject:: m_GlobalDefaultAutomaticInPlace = false;
+bool ProcessObject:: m_GlobalDefaultAutomaticInPlaceIsInitialized = false;
+
+void
+ProcessObject
+::SetGlobalDefaultAutomaticInPlace(bool flag)
+{
+  m_GlobalDefaultAutomaticInPlace = flag;
+  m_GlobalDefaultAutomaticInPlaceIsInitialized = true;
+}
+
+bool
+ProcessObject
+::GetGlobalDefaultAutomaticInPlace()
+{
+  if ( !m_GlobalDefaultAutomaticInPlaceIsInitialized )
+    {
+    itksys_stl::string automaticInPlaceEnv;
+    if ( itksys::SystemTools::GetEnv("ITK_AUTOMATIC_IN_PLACE", automaticInPlaceEnv) )
+      {
+      automaticInPlaceEnv = itksys::SystemTools::UpperCase(automaticInPlaceEnv);
+      m_GlobalDefaultAutomaticInPlace = ( automaticInPlaceEnv == "ON"
+                                          || automaticInPlaceEnv == "TRUE"
+                                          || automaticInPlaceEnv == "YES"
+                                          || atoi( automaticInPlaceEnv.c_str() ) != 0 );
+      }
+    m_GlobalDefaultAutomaticInPlaceIsInitialized = true;
+    }
+  return m_GlobalDefaultAutomaticInPlace;
+}
+
+// Initialize static members that control the concurrent update of
+// the inputs: not initialized, the environment is checked on first use.
+bool ProcessObject:: m_GlobalDefaultConcurrentInputUpdate = false;
+bool ProcessObject:: m_GlobalDefaultConcurrentInputUpdateIsInitialized = false;
+
+void
+ProcessObject
+::SetGlobalDefaultConcurrentInputUpdate(bool flag)
+{
+  m_GlobalDefaultConcurrentInputUpdate = flag;
+  m_GlobalDefaultConcurrentInputUpdateIsInitialized = true;
+}
+
+bool
+ProcessObject
+::GetGlobalDefaultConcurrentInputUpdate()
+{
+  if ( !m_GlobalDefaultConcurrentInputUpdateIsInitialized )
+    {
+    itksys_stl::string concurrentInputUpdateEnv;
+    if ( itksys::SystemTools::GetEnv("ITK_CONCURRENT_INPUT_UPDATE", concurrentInputUpdateEnv) )
+      {
+      concurrentInputUpdateEnv = itksys::SystemTools::UpperCase(concurrentInputUpdateEnv);
+      m_GlobalDefaultConcurrentInputUpdate = ( concurrentInputUpdateEnv == "ON"
+                                               || concurrentInputUpdateEnv == "TRUE"
+                                               || concurrentInputUpdateEnv == "YES"
+                                               || atoi( concurrentInputUpdateEnv.c_str() ) != 0 );
+      }
+    m_GlobalDefaultConcurrentInputUpdateIsInitialized = true;
+    }
+  return m_GlobalDefaultConcurrentInputUpdate;
+}
+
 /**
  * Instantiate object with no start, end, or progress methods.
  */
@@ -54,6 +201,9 @@ ProcessObject
   m_NumberOfThreads = m_Threader->GetNumberOfThreads();
 
   m_ReleaseDataBeforeUpdateFlag = true;
+  m_AutomaticInPlace = GetGlobalDefaultAutomaticInPlace();
+  m_ConcurrentInputUpdate = GetGlobalDefaultConcurrentInputUpdate();
+  m_UpdateCanceled = false;
 
   m_NumberOfIndexedInputs = 0;
   m_NumberOfIndexedOutputs = 0;
@@ -1106,6 +1256,21 @@ ProcessObject
   os << indent << "ReleaseDataBeforeUpdateFlag: "
      << ( m_ReleaseDataBeforeUpdateFlag ? "On" : "Off" ) << std::endl;
 
+  os << indent << "AutomaticInPlace: "
+     << ( m_AutomaticInPlace ? "On" : "Off" ) << std::endl;
+  if ( !m_ReleasableInputNames.empty() )
+    {
+    os << indent << "ReleasableInputs:";
+    for ( NameSet::const_iterator it = m_ReleasableInputNames.begin(); it != m_ReleasableInputNames.end(); ++it )
+      {
+      os << " " << *it;
+      }
+    os << std::endl;
+    }
+
+  os << indent << "ConcurrentInputUpdate: "
+     << ( m_ConcurrentInputUpdate ? "On" : "Off" ) << std::endl;
+
   os << indent << "AbortGenerateData: " << ( m_AbortGenerateData ? "On" : "Off" ) << std::endl;
   os << indent << "Progress: " << m_Progress << std::endl;
 
@@ -1131,6 +1296,16 @@ ProcessObject
     }
 }
 
+UpdateFuture::Pointer
+ProcessObject
+::UpdateAsync()
+{
+  UpdateFuture::Pointer future = new UpdateFuture(this);
+  future->UnRegister();
+  future->Start();
+  return future;
+}
+
 void
 ProcessObject
 ::ResetPipeline()
@@ -1294,6 +1469,12 @@ ProcessObject
       }
     }
 
+  /**
+   * Now that the upstream pipeline is connected, find the inputs that
+   * nothing but this ProcessObject will read.
+   */
+  this->PlanInPlaceExecution();
+
   /**
    * Call GenerateOutputInformation for subclass specific information.
    * Since UpdateOutputInformation propagates all the way up the pipeline,
@@ -1322,7 +1503,10 @@ ProcessObject
     /**
      * Finally, generate the output information.
      */
+    {
+    PipelineTracer::Scope traceScope("GenerateOutputInformation", "pipeline", this);
     this->GenerateOutputInformation();
+    }
 
     /**
      * Keep track of the last time GenerateOutputInformation() was called
@@ -1331,6 +1515,164 @@ ProcessObject
     }
 }
 
+/**
+ *
+ */
+void
+ProcessObject
+::PlanInPlaceExecution()
+{
+  m_ReleasableInputNames.clear();
+  if ( !m_AutomaticInPlace )
+    {
+    return;
+    }
+
+  for ( DataObjectPointerMap::const_iterator it = m_Inputs.begin(); it != m_Inputs.end(); ++it )
+    {
+    const DataObject *input = it->second.GetPointer();
+    if ( !input || !input->GetSource() )
+      {
+      continue;
+      }
+
+    // An intermediate data object is referenced once by its source. Any
+    // other reference than the one of this input, e.g. another consumer,
+    // this ProcessObject through another input, or the application,
+    // means that its bulk data may be read after this ProcessObject has
+    // executed.
+    unsigned int numberOfSlots = 0;
+    for ( DataObjectPointerMap::const_iterator other = m_Inputs.begin(); other != m_Inputs.end(); ++other )
+      {
+      if ( other->second.GetPointer() == input )
+        {
+        ++numberOfSlots;
+        }
+      }
+
+    if ( numberOfSlots == 1 && input->GetReferenceCount() == 2 )
+      {
+      itkDebugMacro("Input " << it->first << " has no other consumer: its bulk data may be reused");
+      m_ReleasableInputNames.insert(it->first);
+      }
+    else
+      {
+      itkDebugMacro("Input " << it->first << " is shared: " << input->GetReferenceCount()
+                    << " references");
+      }
+    }
+}
+
+bool
+ProcessObject
+::UpdateInputsConcurrently()
+{
+  if ( !m_ConcurrentInputUpdate )
+    {
+    return false;
+    }
+
+  // Find the inputs produced by a pipeline branch, and make sure that no
+  // ProcessObject takes part in two branches: it would be executed by two
+  // threads at once.
+  std::set< const ProcessObject * > upstream;
+  std::vector< InputBranchUpdate >  branches;
+  for ( DataObjectPointerMap::iterator it = m_Inputs.begin(); it != m_Inputs.end(); ++it )
+    {
+    if ( !it->second || !it->second->GetSource() )
+      {
+      continue;
+      }
+    std::set< const ProcessObject * > branch;
+    if ( !CollectInputBranch(it->second, upstream, branch) )
+      {
+      itkDebugMacro("Input " << it->first << " shares a ProcessObject with another input: "
+                    << "updating the inputs one after the other");
+      return false;
+      }
+    upstream.insert( branch.begin(), branch.end() );
+
+    InputBranchUpdate update;
+    update.Input = it->second;
+    update.Failed = false;
+    update.Aborted = false;
+    branches.push_back(update);
+    }
+  if ( branches.size() < 2 )
+    {
+    return false;
+    }
+
+  // The inputs without a source are up to date once their requested
+  // region is propagated.
+  for ( DataObjectPointerMap::iterator it = m_Inputs.begin(); it != m_Inputs.end(); ++it )
+    {
+    if ( it->second )
+      {
+      it->second->PropagateRequestedRegion();
+      if ( !it->second->GetSource() )
+        {
+        it->second->UpdateOutputData();
+        }
+      }
+    }
+
+  // This thread updates the first branch while the pool updates the
+  // others.
+  std::vector< void * > userData;
+  for ( unsigned int i = 1; i < branches.size(); ++i )
+    {
+    userData.push_back(&branches[i]);
+    }
+  ThreadPool::Pointer  pool = ThreadPool::GetInstance();
+  ThreadPool::JobGroup group;
+  const bool           queued = pool->AddWork(UpdateInputBranch, userData, group);
+  itkDebugMacro("Updating " << branches.size() << " input branches "
+                << ( queued ? "concurrently" : "one after the other" ) );
+
+  UpdateInputBranch(&branches[0]);
+  if ( queued )
+    {
+    pool->WaitForWork(group);
+    }
+  else
+    {
+    for ( unsigned int i = 1; i < branches.size(); ++i )
+      {
+      UpdateInputBranch(&branches[i]);
+      }
+    }
+
+  for ( unsigned int i = 0; i < branches.size(); ++i )
+    {
+    if ( branches[i].Aborted )
+      {
+      ProcessAborted e(branches[i].Exception.GetFile(), branches[i].Exception.GetLine());
+      e.SetDescription( branches[i].Exception.GetDescription() );
+      throw e;
+      }
+    if ( branches[i].Failed )
+      {
+      throw branches[i].Exception;
+      }
+    }
+  return true;
+}
+
+bool
+ProcessObject
+::IsInputReleasable(const DataObjectIdentifierType & key) const
+{
+  return m_ReleasableInputNames.find(key) != m_ReleasableInputNames.end();
+}
+
+bool
+ProcessObject
+::IsInputReleasable(DataObjectPointerArraySizeType idx) const
+{
+  return this->IsInputReleasable( this->MakeNameFromInputIndex(idx) );
+}
+
 /**
  *
  */
@@ -1346,6 +1688,9 @@ ProcessObject
     return;
     }
 
+  {
+  PipelineTracer::Scope traceScope("PropagateRequestedRegion", "pipeline", this);
+
   /**
    * Give the subclass a chance to indicate that it will provide
    * more data then required for the output. This can happen, for
@@ -1373,6 +1718,7 @@ ProcessObject
    * neighborhood of surrounding original values.
    */
   this->GenerateInputRequestedRegion();
+  }
 
   /**
    * Now that we know the input requested region, propagate this
@@ -1495,7 +1841,7 @@ ProcessObject
       this->GetPrimaryInput()->UpdateOutputData();
       }
     }
-  else
+  else if ( !this->UpdateInputsConcurrently() )
     {
     for ( DataObjectPointerMap::iterator it=m_Inputs.begin(); it != m_Inputs.end(); it++ )
       {
@@ -1531,8 +1877,26 @@ ProcessObject
 
   try
     {
+    // A canceled update must not execute the ProcessObjects that have
+    // not started, nor report success for the one that stopped early
+    // without throwing.
+    if ( m_UpdateCanceled )
+      {
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Object " + std::string( this->GetNameOfClass() ) + ": update canceled");
+      throw e;
+      }
+    {
+    PipelineTracer::Scope traceScope("GenerateData", "pipeline", this);
     this->GenerateData();
     }
+    if ( m_UpdateCanceled )
+      {
+      ProcessAborted e(__FILE__, __LINE__);
+      e.SetDescription("Object " + std::string( this->GetNameOfClass() ) + ": update canceled");
+      throw e;
+      }
+    }
   catch ( ProcessAborted & excp )
     {
     this->InvokeEvent( AbortEvent() );
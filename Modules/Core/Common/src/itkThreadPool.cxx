@@ -0,0 +1,255 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkThreadPool.h"
+#include "itkMutexLockHolder.h"
+
+namespace itk
+{
+ThreadPool::Pointer ThreadPool::m_ThreadPoolInstance;
+SimpleFastMutexLock ThreadPool::m_ThreadPoolInstanceMutex;
+
+ThreadPool::Pointer
+ThreadPool
+::GetInstance()
+{
+  MutexLockHolder< SimpleFastMutexLock > holder(m_ThreadPoolInstanceMutex);
+  if ( m_ThreadPoolInstance.IsNull() )
+    {
+    // The pool is a process-wide resource, so it is not created through
+    // the object factory.
+    m_ThreadPoolInstance = new ThreadPool;
+    m_ThreadPoolInstance->UnRegister();
+    }
+  return m_ThreadPoolInstance;
+}
+
+ThreadIdType
+ThreadPool
+::GetMaximumNumberOfWorkers()
+{
+  // The spawner can track at most ITK_MAX_THREADS threads, and the thread
+  // that queues the work always takes part in it.
+  return ITK_MAX_THREADS - 1;
+}
+
+ThreadPool
+::ThreadPool()
+{
+  m_Spawner = MultiThreader::New();
+  m_NextQueue = 0;
+  m_NumberOfQueuedJobs = 0;
+  m_NumberOfBusyWorkers = 0;
+  m_Terminate = false;
+  m_WorkAvailable = ConditionVariable::New();
+  m_WorkCompleted = ConditionVariable::New();
+}
+
+ThreadPool
+::~ThreadPool()
+{
+  m_Mutex.Lock();
+  m_Terminate = true;
+  m_WorkAvailable->Broadcast();
+  const ThreadIdType numberOfWorkers = static_cast< ThreadIdType >( m_Queues.size() );
+  m_Mutex.Unlock();
+
+  for ( ThreadIdType i = 0; i < numberOfWorkers; ++i )
+    {
+    m_Spawner->TerminateThread(i);
+    }
+}
+
+ThreadIdType
+ThreadPool
+::GetNumberOfWorkers() const
+{
+  MutexLockHolder< SimpleMutexLock > holder(m_Mutex);
+  return static_cast< ThreadIdType >( m_Queues.size() );
+}
+
+bool
+ThreadPool
+::AddWork(ThreadFunctionType function,
+          const std::vector< void * > & userData,
+          JobGroup & group)
+{
+  const unsigned int numberOfJobs = static_cast< unsigned int >( userData.size() );
+
+  if ( numberOfJobs == 0 )
+    {
+    return true;
+    }
+
+  MutexLockHolder< SimpleMutexLock > holder(m_Mutex);
+
+  // Every queued job must be able to start right away, so make sure there
+  // is an idle worker for each of them.
+  const unsigned int requiredWorkers =
+    m_NumberOfBusyWorkers + m_NumberOfQueuedJobs + numberOfJobs;
+  if ( requiredWorkers > GetMaximumNumberOfWorkers() )
+    {
+    return false;
+    }
+  while ( m_Queues.size() < requiredWorkers )
+    {
+    // The new worker uses its spawned thread id as its queue index; it
+    // cannot look at its queue before m_Mutex is released.
+    m_Queues.push_back( JobQueueType() );
+    try
+      {
+      m_Spawner->SpawnThread(WorkerThread, this);
+      }
+    catch ( ... )
+      {
+      m_Queues.pop_back();
+      return false;
+      }
+    }
+
+  ThreadJob job;
+  job.Function = function;
+  job.Group = &group;
+  for ( unsigned int i = 0; i < numberOfJobs; ++i )
+    {
+    job.UserData = userData[i];
+    m_Queues[m_NextQueue].push_back(job);
+    m_NextQueue = ( m_NextQueue + 1 ) % static_cast< unsigned int >( m_Queues.size() );
+    }
+  m_NumberOfQueuedJobs += numberOfJobs;
+  group.m_NumberOfPendingJobs += numberOfJobs;
+
+  m_WorkAvailable->Broadcast();
+  return true;
+}
+
+void
+ThreadPool
+::WaitForWork(JobGroup & group)
+{
+  m_Mutex.Lock();
+  while ( group.m_NumberOfPendingJobs > 0 )
+    {
+    ThreadJob job;
+    // The waiting thread owns no queue, so it only steals.
+    if ( this->PopJob(static_cast< unsigned int >( m_Queues.size() ), job) )
+      {
+      this->RunJob(job);
+      }
+    else
+      {
+      m_WorkCompleted->Wait(&m_Mutex);
+      }
+    }
+  m_Mutex.Unlock();
+}
+
+bool
+ThreadPool
+::PopJob(unsigned int owner, ThreadJob & job)
+{
+  if ( m_NumberOfQueuedJobs == 0 )
+    {
+    return false;
+    }
+
+  const unsigned int numberOfQueues = static_cast< unsigned int >( m_Queues.size() );
+  if ( owner < numberOfQueues && !m_Queues[owner].empty() )
+    {
+    job = m_Queues[owner].back();
+    m_Queues[owner].pop_back();
+    --m_NumberOfQueuedJobs;
+    return true;
+    }
+
+  for ( unsigned int i = 1; i <= numberOfQueues; ++i )
+    {
+    JobQueueType & victim = m_Queues[( owner + i ) % numberOfQueues];
+    if ( !victim.empty() )
+      {
+      job = victim.front();
+      victim.pop_front();
+      --m_NumberOfQueuedJobs;
+      return true;
+      }
+    }
+  return false;
+}
+
+void
+ThreadPool
+::RunJob(const ThreadJob & job)
+{
+  m_Mutex.Unlock();
+  try
+    {
+    ( *job.Function )( job.UserData );
+    }
+  catch ( ... )
+    {
+    // Jobs report their own failures (see MultiThreader::SingleMethodProxy);
+    // an escaping exception must not take the worker down.
+    }
+  m_Mutex.Lock();
+
+  if ( --job.Group->m_NumberOfPendingJobs == 0 )
+    {
+    m_WorkCompleted->Broadcast();
+    }
+}
+
+ITK_THREAD_RETURN_TYPE
+ThreadPool
+::WorkerThread(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *threadInfo =
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  ThreadPool *       pool = static_cast< ThreadPool * >( threadInfo->UserData );
+  const unsigned int queue = threadInfo->ThreadID;
+
+  pool->m_Mutex.Lock();
+  while ( !pool->m_Terminate )
+    {
+    ThreadJob job;
+    if ( pool->PopJob(queue, job) )
+      {
+      ++pool->m_NumberOfBusyWorkers;
+      pool->RunJob(job);
+      --pool->m_NumberOfBusyWorkers;
+      }
+    else
+      {
+      pool->m_WorkAvailable->Wait(&pool->m_Mutex);
+      }
+    }
+  pool->m_Mutex.Unlock();
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+void
+ThreadPool
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  MutexLockHolder< SimpleMutexLock > holder(m_Mutex);
+  os << indent << "NumberOfWorkers: " << m_Queues.size() << std::endl;
+  os << indent << "NumberOfBusyWorkers: " << m_NumberOfBusyWorkers << std::endl;
+  os << indent << "NumberOfQueuedJobs: " << m_NumberOfQueuedJobs << std::endl;
+}
+} // end namespace itk
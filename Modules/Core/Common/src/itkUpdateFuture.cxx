@@ -0,0 +1,225 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkUpdateFuture.h"
+#include "itkMutexLockHolder.h"
+
+namespace itk
+{
+SimpleMutexLock            UpdateFuture::m_CompletionMutex;
+ConditionVariable::Pointer UpdateFuture::m_Completion;
+
+UpdateFuture
+::UpdateFuture(ProcessObject *processObject):
+  m_ProcessObject(processObject),
+  m_Status(Completed),
+  m_Queued(false)
+{}
+
+UpdateFuture
+::~UpdateFuture()
+{
+  // The job refers to this object until the pool accounts for its
+  // completion.
+  if ( m_Queued )
+    {
+    ThreadPool::GetInstance()->WaitForWork(m_JobGroup);
+    }
+}
+
+void
+UpdateFuture
+::Start()
+{
+  // Record the ProcessObjects of the pipeline, which Cancel() must reach
+  // even before they start executing.
+  std::set< ProcessObject * > visited;
+  std::vector< ProcessObject * > pending(1, m_ProcessObject.GetPointer());
+  while ( !pending.empty() )
+    {
+    ProcessObject *object = pending.back();
+    pending.pop_back();
+    if ( !visited.insert(object).second )
+      {
+      continue;
+      }
+    m_Pipeline.push_back(object);
+    ProcessObject::DataObjectPointerArray inputs = object->GetInputs();
+    for ( ProcessObject::DataObjectPointerArraySizeType i = 0; i < inputs.size(); ++i )
+      {
+      if ( inputs[i] && inputs[i]->GetSource() )
+        {
+        pending.push_back( inputs[i]->GetSource().GetPointer() );
+        }
+      }
+    }
+
+  {
+  MutexLockHolder< SimpleMutexLock > holder(m_CompletionMutex);
+  if ( m_Completion.IsNull() )
+    {
+    m_Completion = ConditionVariable::New();
+    }
+  m_Status = Running;
+  }
+
+  const std::vector< void * > userData(1, this);
+  m_Queued = ThreadPool::GetInstance()->AddWork(UpdateCallback, userData, m_JobGroup);
+  if ( !m_Queued )
+    {
+    itkDebugMacro("The thread pool is full: updating " << m_ProcessObject->GetNameOfClass()
+                  << " synchronously");
+    UpdateCallback(this);
+    }
+}
+
+ITK_THREAD_RETURN_TYPE
+UpdateFuture
+::UpdateCallback(void *arg)
+{
+  UpdateFuture *  future = static_cast< UpdateFuture * >( arg );
+  StatusType      status = Completed;
+  ExceptionObject exception;
+
+  try
+    {
+    future->m_ProcessObject->Update();
+    }
+  catch ( ProcessAborted & excp )
+    {
+    status = Canceled;
+    exception = excp;
+    }
+  catch ( ExceptionObject & excp )
+    {
+    status = Failed;
+    exception = excp;
+    }
+  catch ( std::exception & excp )
+    {
+    status = Failed;
+    exception = ExceptionObject(__FILE__, __LINE__, excp.what(), "UpdateFuture::UpdateCallback");
+    }
+  catch ( ... )
+    {
+    status = Failed;
+    exception = ExceptionObject(__FILE__, __LINE__, "Unknown exception", "UpdateFuture::UpdateCallback");
+    }
+
+  MutexLockHolder< SimpleMutexLock > holder(m_CompletionMutex);
+  future->SetPipelineCanceled(false);
+  future->m_Exception = exception;
+  future->m_Status = status;
+  m_Completion->Broadcast();
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+UpdateFuture::StatusType
+UpdateFuture
+::GetStatus() const
+{
+  MutexLockHolder< SimpleMutexLock > holder(m_CompletionMutex);
+  return m_Status;
+}
+
+void
+UpdateFuture
+::Wait()
+{
+  m_CompletionMutex.Lock();
+  while ( m_Status == Running )
+    {
+    m_Completion->Wait(&m_CompletionMutex);
+    }
+  const StatusType      status = m_Status;
+  const ExceptionObject exception = m_Exception;
+  m_CompletionMutex.Unlock();
+
+  if ( status == Canceled )
+    {
+    ProcessAborted e( exception.GetFile(), exception.GetLine() );
+    e.SetDescription( exception.GetDescription() );
+    throw e;
+    }
+  if ( status == Failed )
+    {
+    throw exception;
+    }
+}
+
+void
+UpdateFuture
+::Cancel()
+{
+  MutexLockHolder< SimpleMutexLock > holder(m_CompletionMutex);
+  if ( m_Status == Running )
+    {
+    this->SetPipelineCanceled(true);
+    }
+}
+
+void
+UpdateFuture
+::SetPipelineCanceled(bool flag)
+{
+  for ( std::vector< ProcessObject::Pointer >::iterator it = m_Pipeline.begin(); it != m_Pipeline.end(); ++it )
+    {
+    if ( flag || ( *it )->m_UpdateCanceled )
+      {
+      ( *it )->m_UpdateCanceled = flag;
+      ( *it )->SetAbortGenerateData(flag);
+      }
+    }
+}
+
+unsigned int
+UpdateFuture
+::WaitForAny(const std::vector< Pointer > & futures)
+{
+  const unsigned int numberOfFutures = static_cast< unsigned int >( futures.size() );
+  if ( numberOfFutures == 0 )
+    {
+    return numberOfFutures;
+    }
+
+  MutexLockHolder< SimpleMutexLock > holder(m_CompletionMutex);
+  while ( true )
+    {
+    for ( unsigned int i = 0; i < numberOfFutures; ++i )
+      {
+      if ( futures[i]->m_Status != Running )
+        {
+        return i;
+        }
+      }
+    m_Completion->Wait(&m_CompletionMutex);
+    }
+}
+
+void
+UpdateFuture
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const char *statusNames[] = { "Running", "Completed", "Canceled", "Failed" };
+  os << indent << "ProcessObject: " << m_ProcessObject.GetPointer() << std::endl;
+  os << indent << "Status: " << statusNames[this->GetStatus()] << std::endl;
+  os << indent << "NumberOfProcessObjects: " << m_Pipeline.size() << std::endl;
+}
+} // end namespace itk
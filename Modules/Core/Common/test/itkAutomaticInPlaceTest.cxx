@@ -0,0 +1,208 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSource.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+namespace itk
+{
+/** Sets each pixel to a function of its index. */
+template< class TOutputImage >
+class AutomaticInPlaceTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef AutomaticInPlaceTestSource  Self;
+  typedef ImageSource< TOutputImage > Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(AutomaticInPlaceTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  static int Value(const typename TOutputImage::IndexType & index)
+  {
+    return static_cast< int >( index[0] + 10 * index[1] );
+  }
+
+protected:
+  AutomaticInPlaceTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size.Fill(10);
+    typename TOutputImage::RegionType region;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    for ( ImageRegionIteratorWithIndex< TOutputImage > it(this->GetOutput(), region); !it.IsAtEnd(); ++it )
+      {
+      it.Set( Value( it.GetIndex() ) );
+      }
+  }
+};
+
+namespace Functor
+{
+template< class TPixel >
+class AutomaticInPlaceTestPlusOne
+{
+public:
+  bool operator!=(const AutomaticInPlaceTestPlusOne &) const { return false; }
+  bool operator==(const AutomaticInPlaceTestPlusOne & other) const { return !( *this != other ); }
+  TPixel operator()(const TPixel & value) const { return value + 1; }
+};
+}
+}
+
+namespace
+{
+typedef itk::Image< int, 2 >                                              ImageType;
+typedef itk::AutomaticInPlaceTestSource< ImageType >                      SourceType;
+typedef itk::Functor::AutomaticInPlaceTestPlusOne< int >                  FunctorType;
+typedef itk::UnaryFunctorImageFilter< ImageType, ImageType, FunctorType > FilterType;
+
+bool CheckOutput(const ImageType *image, int offset)
+{
+  for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it(image, image->GetBufferedRegion());
+        !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != SourceType::Value( it.GetIndex() ) + offset )
+      {
+      std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of "
+                << SourceType::Value( it.GetIndex() ) + offset << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkAutomaticInPlaceTest(int, char* [])
+{
+  itk::ProcessObject::SetGlobalDefaultAutomaticInPlace(true);
+
+  // A linear pipeline: every filter reuses the buffer of the source,
+  // although the functor filters have InPlace off by default.
+  SourceType::Pointer source = SourceType::New();
+  FilterType::Pointer filter1 = FilterType::New();
+  FilterType::Pointer filter2 = FilterType::New();
+  FilterType::Pointer filter3 = FilterType::New();
+  filter1->SetInput( source->GetOutput() );
+  filter2->SetInput( filter1->GetOutput() );
+  filter3->SetInput( filter2->GetOutput() );
+
+  source->Update();
+  const int *sourceBuffer = source->GetOutput()->GetBufferPointer();
+  filter3->Update();
+
+  if ( !filter1->IsInputReleasable(0) || !filter2->IsInputReleasable(0) || !filter3->IsInputReleasable(0) )
+    {
+    std::cerr << "Intermediate images of a linear pipeline are not releasable" << std::endl;
+    filter2->Print(std::cerr);
+    return EXIT_FAILURE;
+    }
+  if ( filter3->GetOutput()->GetBufferPointer() != sourceBuffer
+       || source->GetOutput()->GetBufferPointer() != NULL )
+    {
+    std::cerr << "The buffer of the source was not reused" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( !CheckOutput( filter3->GetOutput(), 3 ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A second consumer of the output of filter1: filter2 must not
+  // overwrite it.
+  FilterType::Pointer branch = FilterType::New();
+  branch->SetInput( filter1->GetOutput() );
+  filter1->Modified();
+  filter3->Update();
+  if ( !filter1->IsInputReleasable(0) || filter2->IsInputReleasable(0) )
+    {
+    std::cerr << "Wrong releasable inputs with two consumers" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( filter1->GetOutput()->GetBufferPointer() == NULL
+       || filter1->GetOutput()->GetBufferPointer() == filter3->GetOutput()->GetBufferPointer() )
+    {
+    std::cerr << "A shared image was overwritten" << std::endl;
+    return EXIT_FAILURE;
+    }
+  branch->Update();
+  if ( !CheckOutput( filter3->GetOutput(), 3 ) || !CheckOutput( branch->GetOutput(), 2 )
+       || !CheckOutput( filter1->GetOutput(), 1 ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // An image held by the application is not overwritten either.
+  branch = NULL;
+  ImageType::Pointer held = filter2->GetOutput();
+  filter1->Modified();
+  filter3->Update();
+  if ( filter3->IsInputReleasable(0) || held->GetBufferPointer() == filter3->GetOutput()->GetBufferPointer() )
+    {
+    std::cerr << "An image held by the application was overwritten" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( !CheckOutput( held, 2 ) || !CheckOutput( filter3->GetOutput(), 3 ) )
+    {
+    return EXIT_FAILURE;
+    }
+  held = NULL;
+
+  // Without the planning, the InPlace flags decide.
+  filter1->AutomaticInPlaceOff();
+  filter2->AutomaticInPlaceOff();
+  filter3->AutomaticInPlaceOff();
+  filter3->InPlaceOn();
+  filter1->Modified();
+  filter3->Update();
+  if ( filter3->IsInputReleasable(0) )
+    {
+    std::cerr << "Releasable input without AutomaticInPlace" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( filter1->GetOutput()->GetBufferPointer() == NULL
+       || filter2->GetOutput()->GetBufferPointer() != NULL
+       || !CheckOutput( filter3->GetOutput(), 3 ) )
+    {
+    std::cerr << "InPlace flags not honored" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  itk::ProcessObject::SetGlobalDefaultAutomaticInPlace(false);
+  FilterType::Pointer filter4 = FilterType::New();
+  if ( filter4->GetAutomaticInPlace() )
+    {
+    std::cerr << "AutomaticInPlace does not follow the global default" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  filter1->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
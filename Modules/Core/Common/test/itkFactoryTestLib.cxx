@@ -56,7 +56,7 @@ public:
     {
     }
 protected:
-  TElement* AllocateElements(ElementIdentifier size) const
+  TElement* AllocateElements(ElementIdentifier size, bool UseDefaultConstructor = false) const
     {
     std::cout << "TestImportImageContainer: Allocating "
               << size << " elements of type "
@@ -71,7 +71,11 @@ protected:
       // a null pointer which means no allocation hint
       // Sun cc compiler needs a cast to assign a void pointer to another pointer
       data = static_cast<TElement*>(m_Allocator.allocate(size,0));
-      if (data)
+      if (data && UseDefaultConstructor)
+        {
+        new (data) Element[size]();
+        }
+      else if (data)
         {
         new (data) Element[size];
         }
@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImage.h"
+#include "itkVectorImage.h"
+#include <complex>
+#include <cstring>
+
+namespace
+{
+bool IsAligned(const void *buffer, size_t alignment)
+{
+  return reinterpret_cast< size_t >( buffer ) % alignment == 0;
+}
+
+template< class TImage >
+bool CheckAllocation(const char *name, unsigned int vectorLength = 0)
+{
+  typename TImage::Pointer image = TImage::New();
+  typename TImage::SizeType size;
+  size.Fill(13);
+  image->SetRegions(size);
+  if ( vectorLength > 0 )
+    {
+    image->SetNumberOfComponentsPerPixel(vectorLength);
+    }
+
+  image->Allocate();
+  if ( !IsAligned( image->GetBufferPointer(), itk::ImageBufferAllocator::Alignment ) )
+    {
+    std::cerr << name << ": buffer " << static_cast< void * >( image->GetBufferPointer() )
+              << " is not aligned" << std::endl;
+    return false;
+    }
+
+  // Dirty the buffer, then ask for initialized pixels on the reused
+  // buffer and on a larger one.
+  for ( unsigned int pass = 0; pass < 2; ++pass )
+    {
+    const size_t numberOfBytes = image->GetPixelContainer()->Size()
+                                 * sizeof( *image->GetBufferPointer() );
+    memset(image->GetBufferPointer(), 0xff, numberOfBytes);
+
+    if ( pass == 1 )
+      {
+      size.Fill(17);
+      image->SetRegions(size);
+      }
+    image->Allocate(true);
+
+    const unsigned char *bytes =
+      reinterpret_cast< const unsigned char * >( image->GetBufferPointer() );
+    const size_t numberOfAllocatedBytes = image->GetPixelContainer()->Size()
+                                          * sizeof( *image->GetBufferPointer() );
+    for ( size_t i = 0; i < numberOfAllocatedBytes; ++i )
+      {
+      if ( bytes[i] != 0 )
+        {
+        std::cerr << name << ": byte " << i << " of the buffer is not zero" << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkImageBufferAllocatorTest(int, char* [])
+{
+  typedef itk::Image< float, 3 >                         FloatImageType;
+  typedef itk::Image< std::complex< double >, 2 >        ComplexImageType;
+  typedef itk::VectorImage< short, 2 >                   VectorImageType;
+
+  if ( !CheckAllocation< FloatImageType >("Image<float,3>")
+       || !CheckAllocation< ComplexImageType >("Image<complex<double>,2>")
+       || !CheckAllocation< VectorImageType >("VectorImage<short,2>", 3) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Growing the container keeps the contents of the buffer.
+  typedef FloatImageType::PixelContainer PixelContainerType;
+  PixelContainerType::Pointer container = PixelContainerType::New();
+  container->Reserve(100);
+  for ( unsigned int i = 0; i < 100; ++i )
+    {
+    ( *container )[i] = static_cast< float >( i );
+    }
+  container->Reserve(1000);
+  for ( unsigned int i = 0; i < 100; ++i )
+    {
+    if ( ( *container )[i] != static_cast< float >( i ) )
+      {
+      std::cerr << "Element " << i << " is " << ( *container )[i]
+                << " after Reserve()" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  container->Squeeze();
+  if ( !IsAligned( container->GetBufferPointer(), itk::ImageBufferAllocator::Alignment ) )
+    {
+    std::cerr << "Squeezed buffer is not aligned" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // A buffer allocated by the application is released with delete[].
+  container->SetImportPointer(new float[10], 10, true);
+  container->Reserve(20);
+  container->SetImportPointer(new float[10], 10, true);
+  container->Initialize();
+
+  // Huge page allocations are aligned on the huge page size.
+  const itk::SizeValueType threshold = itk::ImageBufferAllocator::GetGlobalHugePageThreshold();
+  itk::ImageBufferAllocator::SetGlobalHugePageThreshold(1024 * 1024);
+  FloatImageType::Pointer hugeImage = FloatImageType::New();
+  FloatImageType::SizeType hugeSize;
+  hugeSize.Fill(128);
+  hugeImage->SetRegions(hugeSize);
+  hugeImage->Allocate();
+  if ( !IsAligned( hugeImage->GetBufferPointer(), 2 * 1024 * 1024 ) )
+    {
+    std::cerr << "Huge page buffer " << static_cast< void * >( hugeImage->GetBufferPointer() )
+              << " is not aligned" << std::endl;
+    return EXIT_FAILURE;
+    }
+  hugeImage->FillBuffer(1.0f);
+  itk::ImageBufferAllocator::SetGlobalHugePageThreshold(threshold);
+
+  hugeImage->GetPixelContainer()->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
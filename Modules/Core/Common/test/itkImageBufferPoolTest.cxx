@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageBufferPool.h"
+#include "itkImageSource.h"
+#include "itkImageRegionIterator.h"
+
+namespace itk
+{
+/** Produces a constant image of 64x64x64 floats, i.e. 1 MiB. */
+template< class TOutputImage >
+class ImageBufferPoolTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef ImageBufferPoolTestSource   Self;
+  typedef ImageSource< TOutputImage > Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ImageBufferPoolTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+protected:
+  ImageBufferPoolTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size.Fill(64);
+    typename TOutputImage::RegionType region;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    for ( ImageRegionIterator< TOutputImage > it(this->GetOutput(), region); !it.IsAtEnd(); ++it )
+      {
+      it.Set(3);
+      }
+  }
+};
+}
+
+#define CHECK_POOL(expression)                                          \
+  if ( !( expression ) )                                                \
+    {                                                                   \
+    std::cerr << "Failed: " #expression << std::endl;                   \
+    pool->Print(std::cerr);                                             \
+    return EXIT_FAILURE;                                                \
+    }
+
+int itkImageBufferPoolTest(int, char* [])
+{
+  typedef itk::Image< float, 3 >                         ImageType;
+  typedef itk::ImageBufferPoolTestSource< ImageType >    SourceType;
+
+  itk::ImageBufferPool::Pointer pool = itk::ImageBufferPool::GetInstance();
+  CHECK_POOL( pool == itk::ImageBufferPool::GetInstance() );
+
+  // Bucket sizes.
+  CHECK_POOL( itk::ImageBufferPool::GetBucketSize(7) == 7 );
+  CHECK_POOL( itk::ImageBufferPool::GetBucketSize(1024) == 1024 );
+  CHECK_POOL( itk::ImageBufferPool::GetBucketSize(1025) == 1152 );
+  CHECK_POOL( itk::ImageBufferPool::GetBucketSize(2047) == 2048 );
+  CHECK_POOL( itk::ImageBufferPool::GetBucketSize(1000000) >= 1000000 );
+  CHECK_POOL( itk::ImageBufferPool::GetBucketSize(1000000) < 1000000 + 1000000 / 8 );
+
+  const itk::SizeValueType MiB = 1024 * 1024;
+  pool->SetMinimumBufferSize(MiB);
+
+  // A disabled pool neither caches nor counts.
+  pool->SetMaximumNumberOfCachedBytes(0);
+  pool->ResetStatistics();
+  void *buffer = pool->Allocate(2 * MiB);
+  CHECK_POOL( buffer != NULL );
+  pool->Free(buffer);
+  CHECK_POOL( pool->GetNumberOfRequests() == 0 );
+  CHECK_POOL( pool->GetNumberOfCachedBytes() == 0 );
+
+  // A released buffer is reused for a request of the same bucket.
+  pool->SetMaximumNumberOfCachedBytes(8 * MiB);
+  buffer = pool->Allocate(2 * MiB);
+  CHECK_POOL( pool->GetNumberOfBytesInUse() == 2 * MiB );
+  pool->Free(buffer);
+  CHECK_POOL( pool->GetNumberOfBytesInUse() == 0 );
+  CHECK_POOL( pool->GetNumberOfCachedBytes() == 2 * MiB );
+  void *reused = pool->Allocate(2 * MiB - 100);
+  CHECK_POOL( reused == buffer );
+  CHECK_POOL( pool->GetNumberOfHits() == 1 );
+  CHECK_POOL( pool->GetNumberOfCachedBytes() == 0 );
+
+  // Small buffers are not pooled.
+  void *small = pool->Allocate(1000);
+  CHECK_POOL( small != NULL );
+  pool->Free(small);
+  CHECK_POOL( pool->GetNumberOfRequests() == 2 );
+
+  // The high-water mark bounds the cached bytes.
+  void *others[4];
+  for ( unsigned int i = 0; i < 4; ++i )
+    {
+    others[i] = pool->Allocate(3 * MiB);
+    }
+  pool->Free(reused);
+  for ( unsigned int i = 0; i < 4; ++i )
+    {
+    pool->Free(others[i]);
+    }
+  CHECK_POOL( pool->GetNumberOfCachedBytes() <= 8 * MiB );
+  CHECK_POOL( pool->GetNumberOfEvictions() == 2 );
+  CHECK_POOL( pool->GetPeakNumberOfBytes() == 14 * MiB );
+
+  // Lowering the high-water mark releases the excess.
+  pool->SetMaximumNumberOfCachedBytes(3 * MiB);
+  CHECK_POOL( pool->GetNumberOfCachedBytes() <= 3 * MiB );
+  pool->ReleaseCachedBuffers();
+  CHECK_POOL( pool->GetNumberOfCachedBytes() == 0 );
+
+  pool->ResetStatistics();
+  CHECK_POOL( pool->GetNumberOfRequests() == 0 );
+  CHECK_POOL( pool->GetNumberOfHits() == 0 );
+  CHECK_POOL( pool->GetNumberOfEvictions() == 0 );
+
+  // Intermediate images released by the pipeline are recycled.
+  pool->SetMaximumNumberOfCachedBytes(16 * MiB);
+  SourceType::Pointer source = SourceType::New();
+  source->GetOutput()->ReleaseDataFlagOn();
+  for ( unsigned int i = 0; i < 4; ++i )
+    {
+    source->Modified();
+    source->Update();
+    ImageType::IndexType index;
+    index.Fill(63);
+    if ( source->GetOutput()->GetPixel(index) != 3 )
+      {
+      std::cerr << "Wrong pixel value " << source->GetOutput()->GetPixel(index) << std::endl;
+      return EXIT_FAILURE;
+      }
+    source->GetOutput()->ReleaseData();
+    }
+  CHECK_POOL( pool->GetNumberOfRequests() == 4 );
+  CHECK_POOL( pool->GetNumberOfHits() == 3 );
+  CHECK_POOL( pool->GetNumberOfCachedBytes() == MiB );
+
+  pool->Print(std::cout);
+
+  pool->ReleaseCachedBuffers();
+  pool->SetMaximumNumberOfCachedBytes(0);
+
+  return EXIT_SUCCESS;
+}
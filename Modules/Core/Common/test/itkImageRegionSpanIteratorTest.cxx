@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionSpanIterator.h"
+#include "itkUnaryFunctorImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+namespace
+{
+typedef itk::Image< short, 3 > ImageType;
+typedef itk::Image< float, 3 > FloatImageType;
+
+// Per-pixel functor.
+struct Scale
+{
+  float operator()(const short & value) const { return 0.5f * value; }
+  bool operator!=(const Scale &) const { return false; }
+};
+
+// Functor with a batch operator, which counts the spans it is given.
+struct BatchScale
+{
+  BatchScale():m_NumberOfSpans(0) {}
+  float operator()(const short & value) const { return 0.5f * value; }
+  void operator()(const short *input, float *output, itk::SizeValueType length) const
+  {
+    ++m_NumberOfSpans;
+    for ( itk::SizeValueType i = 0; i < length; ++i )
+      {
+      output[i] = 0.5f * input[i];
+      }
+  }
+  bool operator!=(const BatchScale &) const { return false; }
+  mutable unsigned int m_NumberOfSpans;
+};
+
+// Check that the spans of region cover each of its pixels exactly once.
+bool CheckSpans(const ImageType::RegionType & region, const ImageType::RegionType & buffered,
+                itk::SizeValueType expectedSpanLength)
+{
+  itk::ImageRegionSpanIterator< 3 > sit(region);
+  sit.AddBufferedRegion(buffered);
+  if ( sit.GetSpanLength() != expectedSpanLength )
+    {
+    std::cerr << "Span length " << sit.GetSpanLength() << " instead of " << expectedSpanLength
+              << " for " << region << std::endl;
+    return false;
+    }
+
+  ImageType::Pointer count = ImageType::New();
+  count->SetRegions(buffered);
+  count->Allocate();
+  count->FillBuffer(0);
+
+  itk::SizeValueType numberOfSpans = 0;
+  for ( sit.GoToBegin(); !sit.IsAtEnd(); ++sit, ++numberOfSpans )
+    {
+    short *span = count->GetBufferPointer() + count->ComputeOffset( sit.GetIndex() );
+    for ( itk::SizeValueType i = 0; i < sit.GetSpanLength(); ++i )
+      {
+      ++span[i];
+      }
+    }
+  if ( numberOfSpans != sit.GetNumberOfSpans() )
+    {
+    std::cerr << numberOfSpans << " spans walked instead of " << sit.GetNumberOfSpans() << std::endl;
+    return false;
+    }
+
+  for ( itk::ImageRegionIterator< ImageType > it(count, buffered); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != ( region.IsInside( it.GetIndex() ) ? 1 : 0 ) )
+      {
+      std::cerr << "Pixel " << it.GetIndex() << " walked " << it.Get() << " times" << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkImageRegionSpanIteratorTest(int, char* [] )
+{
+  ImageType::RegionType buffered;
+  buffered.SetIndex(0, -3);
+  buffered.SetIndex(1, 2);
+  buffered.SetIndex(2, 0);
+  buffered.SetSize(0, 11);
+  buffered.SetSize(1, 7);
+  buffered.SetSize(2, 5);
+
+  // Whole buffer: a single span.
+  if ( !CheckSpans(buffered, buffered, 11 * 7 * 5) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Whole lines and a part of the slices: spans of slabs.
+  ImageType::RegionType region = buffered;
+  region.SetIndex(1, 3);
+  region.SetSize(1, 4);
+  region.SetIndex(2, 1);
+  region.SetSize(2, 3);
+  if ( !CheckSpans(region, buffered, 11 * 4) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Part of the lines: one span per line.
+  region.SetIndex(0, -1);
+  region.SetSize(0, 6);
+  if ( !CheckSpans(region, buffered, 6) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Empty region.
+  region.SetSize(1, 0);
+  itk::ImageRegionSpanIterator< 3 > empty(region);
+  empty.GoToBegin();
+  if ( !empty.IsAtEnd() || empty.GetNumberOfSpans() != 0 )
+    {
+    std::cerr << "An empty region has spans" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The functor filters walk the spans, and use the batch operator when
+  // there is one.
+  if ( itk::HasUnarySpanOperator< Scale, short, float >::Value
+       || !itk::HasUnarySpanOperator< BatchScale, short, float >::Value )
+    {
+    std::cerr << "Wrong batch operator detection" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  ImageType::Pointer input = ImageType::New();
+  input->SetRegions(buffered);
+  input->Allocate();
+  short value = 0;
+  for ( itk::ImageRegionIterator< ImageType > it(input, buffered); !it.IsAtEnd(); ++it )
+    {
+    it.Set(value++);
+    }
+
+  typedef itk::UnaryFunctorImageFilter< ImageType, FloatImageType, Scale >      FilterType;
+  typedef itk::UnaryFunctorImageFilter< ImageType, FloatImageType, BatchScale > BatchFilterType;
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetNumberOfThreads(1);
+  BatchFilterType::Pointer batchFilter = BatchFilterType::New();
+  batchFilter->SetInput(input);
+  batchFilter->SetNumberOfThreads(1);
+
+  // A requested region made of parts of lines.
+  region = buffered;
+  region.SetIndex(0, 0);
+  region.SetSize(0, 5);
+  filter->GetOutput()->SetRequestedRegion(region);
+  filter->Update();
+  batchFilter->GetOutput()->SetRequestedRegion(region);
+  batchFilter->Update();
+
+  for ( itk::ImageRegionIterator< FloatImageType > it(filter->GetOutput(), region); !it.IsAtEnd(); ++it )
+    {
+    const float expected = 0.5f * input->GetPixel( it.GetIndex() );
+    if ( it.Get() != expected || batchFilter->GetOutput()->GetPixel( it.GetIndex() ) != expected )
+      {
+      std::cerr << "Wrong value at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  if ( batchFilter->GetFunctor().m_NumberOfSpans != 7 * 5 )
+    {
+    std::cerr << "Batch operator called " << batchFilter->GetFunctor().m_NumberOfSpans
+              << " times instead of " << 7 * 5 << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageScanlineIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+namespace
+{
+typedef itk::Image< int, 3 > ImageType;
+
+// Walk region line by line, checking the index of each pixel against the
+// one of ImageRegionConstIteratorWithIndex, and mark the pixels walked.
+bool CheckScanlines(ImageType *image, const ImageType::RegionType & region)
+{
+  itk::ImageScanlineIterator< ImageType >              sit(image, region);
+  itk::ImageRegionConstIteratorWithIndex< ImageType > wit(image, region);
+
+  itk::SizeValueType numberOfLines = 0;
+  while ( !sit.IsAtEnd() )
+    {
+    itk::SizeValueType length = 0;
+    while ( !sit.IsAtEndOfLine() )
+      {
+      if ( wit.IsAtEnd() || sit.GetIndex() != wit.GetIndex() )
+        {
+        std::cerr << "Index " << sit.GetIndex() << " walked instead of "
+                  << wit.GetIndex() << " in " << region << std::endl;
+        return false;
+        }
+      ++sit.Value();
+      ++sit;
+      ++wit;
+      ++length;
+      }
+    if ( length != region.GetSize(0) )
+      {
+      std::cerr << "Line of " << length << " pixels instead of " << region.GetSize(0) << std::endl;
+      return false;
+      }
+    sit.NextLine();
+    ++numberOfLines;
+    }
+  if ( !wit.IsAtEnd() || numberOfLines != region.GetNumberOfPixels() / region.GetSize(0) )
+    {
+    std::cerr << numberOfLines << " lines walked in " << region << std::endl;
+    return false;
+    }
+  return true;
+}
+}
+
+int itkImageScanlineIteratorTest(int, char* [] )
+{
+  ImageType::RegionType buffered;
+  buffered.SetIndex(0, -3);
+  buffered.SetIndex(1, 2);
+  buffered.SetIndex(2, 0);
+  buffered.SetSize(0, 11);
+  buffered.SetSize(1, 7);
+  buffered.SetSize(2, 5);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(buffered);
+  image->Allocate();
+  image->FillBuffer(0);
+
+  if ( !CheckScanlines(image, buffered) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  ImageType::RegionType region = buffered;
+  region.SetIndex(0, -1);
+  region.SetSize(0, 6);
+  region.SetIndex(1, 3);
+  region.SetSize(1, 4);
+  region.SetIndex(2, 1);
+  region.SetSize(2, 3);
+  if ( !CheckScanlines(image, region) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Each pixel of the sub-region is walked twice, the others once.
+  for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it(image, buffered); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != ( region.IsInside( it.GetIndex() ) ? 2 : 1 ) )
+      {
+      std::cerr << "Pixel " << it.GetIndex() << " walked " << it.Get() << " times" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // SetIndex() moves within a line, and NextLine() goes on from there.
+  itk::ImageScanlineIterator< ImageType > sit(image, region);
+  ImageType::IndexType                    index = region.GetIndex();
+  index[0] += 2;
+  index[1] += 1;
+  sit.SetIndex(index);
+  sit.NextLine();
+  index[0] -= 2;
+  index[1] += 1;
+  if ( sit.GetIndex() != index || sit.Get() != 2 )
+    {
+    std::cerr << "NextLine() after SetIndex() moved to " << sit.GetIndex() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Empty region.
+  region.SetSize(1, 0);
+  itk::ImageScanlineIterator< ImageType > empty(image, region);
+  if ( !empty.IsAtEnd() || !empty.IsAtEndOfLine() )
+    {
+    std::cerr << "An empty region has pixels" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // 1-D images are a single line.
+  typedef itk::Image< int, 1 > LineImageType;
+  LineImageType::Pointer line = LineImageType::New();
+  LineImageType::RegionType lineRegion;
+  lineRegion.SetSize(0, 9);
+  line->SetRegions(lineRegion);
+  line->Allocate();
+  itk::ImageScanlineIterator< LineImageType > lit(line, lineRegion);
+  unsigned int length = 0;
+  for ( ; !lit.IsAtEndOfLine(); ++lit )
+    {
+    ++length;
+    }
+  lit.NextLine();
+  if ( length != 9 || !lit.IsAtEnd() )
+    {
+    std::cerr << "Wrong walk of a 1-D image" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
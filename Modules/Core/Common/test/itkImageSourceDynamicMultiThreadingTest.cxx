@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSource.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIterator.h"
+
+namespace itk
+{
+/** Fills its output with ones, counting the pixels and the calls to
+ * ThreadedGenerateData() of every thread. */
+template< class TOutputImage >
+class DynamicMultiThreadingTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef DynamicMultiThreadingTestSource Self;
+  typedef ImageSource< TOutputImage >     Superclass;
+  typedef SmartPointer< Self >            Pointer;
+  typedef SmartPointer< const Self >      ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(DynamicMultiThreadingTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  SizeValueType m_NumberOfPixels[ITK_MAX_THREADS];
+  unsigned int  m_NumberOfCalls[ITK_MAX_THREADS];
+
+protected:
+  DynamicMultiThreadingTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size.Fill(64);
+    typename TOutputImage::RegionType region;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void BeforeThreadedGenerateData()
+  {
+    this->GetOutput()->FillBuffer(0);
+    for ( unsigned int i = 0; i < ITK_MAX_THREADS; i++ )
+      {
+      m_NumberOfPixels[i] = 0;
+      m_NumberOfCalls[i] = 0;
+      }
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType threadId)
+  {
+    // Per-thread results are accumulated, as required by dynamic scheduling.
+    m_NumberOfCalls[threadId]++;
+    for ( ImageRegionIterator< TOutputImage > it(this->GetOutput(), region); !it.IsAtEnd(); ++it )
+      {
+      it.Set( it.Get() + 1 );
+      m_NumberOfPixels[threadId]++;
+      }
+  }
+};
+}
+
+int itkImageSourceDynamicMultiThreadingTest(int, char* [])
+{
+  typedef itk::Image< unsigned int, 3 >                          ImageType;
+  typedef itk::DynamicMultiThreadingTestSource< ImageType >      SourceType;
+
+  SourceType::Pointer source = SourceType::New();
+  source->SetNumberOfThreads( 4 );
+
+  if ( source->GetDynamicMultiThreading() || source->GetGrainSize() != 0 )
+    {
+    std::cerr << "Dynamic multi-threading is not off by default" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const itk::SizeValueType grainSizes[] = { 0, 1000, 100000000 };
+  for ( unsigned int g = 0; g < 3; g++ )
+    {
+    source->DynamicMultiThreadingOn();
+    source->SetGrainSize( grainSizes[g] );
+    source->Modified();
+    source->Update();
+
+    ImageType::ConstPointer output = source->GetOutput();
+
+    // Every pixel is processed exactly once.
+    for ( itk::ImageRegionConstIterator< ImageType > it(output, output->GetBufferedRegion()); !it.IsAtEnd(); ++it )
+      {
+      if ( it.Get() != 1 )
+        {
+        std::cerr << "Pixel " << it.GetIndex() << " was processed " << it.Get() << " times" << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+
+    itk::SizeValueType numberOfPixels = 0;
+    unsigned int       numberOfCalls = 0;
+    for ( unsigned int i = 0; i < ITK_MAX_THREADS; i++ )
+      {
+      if ( i >= source->GetMultiThreader()->GetNumberOfThreads()
+           && source->m_NumberOfCalls[i] != 0 )
+        {
+        std::cerr << "Invalid thread id " << i << " was used" << std::endl;
+        return EXIT_FAILURE;
+        }
+      numberOfPixels += source->m_NumberOfPixels[i];
+      numberOfCalls += source->m_NumberOfCalls[i];
+      }
+    if ( numberOfPixels != output->GetBufferedRegion().GetNumberOfPixels() )
+      {
+      std::cerr << "The threads processed " << numberOfPixels << " pixels instead of "
+                << output->GetBufferedRegion().GetNumberOfPixels() << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    // The region is over-decomposed unless the grain size prevents it.
+    std::cout << "GrainSize " << grainSizes[g] << ": " << numberOfCalls << " pieces" << std::endl;
+    const unsigned int expectedMinimumNumberOfCalls = ( g == 2 ) ? 1 : 5;
+    if ( numberOfCalls < expectedMinimumNumberOfCalls )
+      {
+      std::cerr << "Expected at least " << expectedMinimumNumberOfCalls << " pieces" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  source->Print( std::cout );
+
+  return EXIT_SUCCESS;
+}
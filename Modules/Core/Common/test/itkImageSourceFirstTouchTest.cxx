@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSource.h"
+#include "itkVectorImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+namespace itk
+{
+/** Sets each pixel to a function of its index. */
+template< class TOutputImage >
+class FirstTouchTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef FirstTouchTestSource        Self;
+  typedef ImageSource< TOutputImage > Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(FirstTouchTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  static short Value(const typename TOutputImage::IndexType & index)
+  {
+    return static_cast< short >( index[0] + 7 * index[1] - 5 * index[2] );
+  }
+
+protected:
+  FirstTouchTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size[0] = 1031;
+    size[1] = 17;
+    size[2] = 9;
+    typename TOutputImage::RegionType region;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    for ( ImageRegionIteratorWithIndex< TOutputImage > it(this->GetOutput(), region); !it.IsAtEnd(); ++it )
+      {
+      it.Set( Value( it.GetIndex() ) );
+      }
+  }
+};
+}
+
+int itkImageSourceFirstTouchTest(int, char* [])
+{
+  typedef itk::Image< short, 3 >                    ImageType;
+  typedef itk::FirstTouchTestSource< ImageType >    SourceType;
+
+  SourceType::Pointer source = SourceType::New();
+  if ( source->GetFirstTouchOutputs() )
+    {
+    std::cerr << "FirstTouchOutputs is not off by default" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // First touch with and without pinned threads, on new threads and on
+  // the thread pool.
+  for ( unsigned int i = 0; i < 4; ++i )
+    {
+    source->FirstTouchOutputsOn();
+    source->SetNumberOfThreads( 3 );
+    source->GetMultiThreader()->SetUseThreadAffinity( i % 2 == 1 );
+    source->GetMultiThreader()->SetUseThreadPool( i >= 2 );
+    source->Modified();
+    source->Update();
+
+    ImageType::ConstPointer output = source->GetOutput();
+    for ( itk::ImageRegionConstIteratorWithIndex< ImageType > it(output, output->GetBufferedRegion());
+          !it.IsAtEnd(); ++it )
+      {
+      if ( it.Get() != SourceType::Value( it.GetIndex() ) )
+        {
+        std::cerr << "Pixel " << it.GetIndex() << " is " << it.Get() << " instead of "
+                  << SourceType::Value( it.GetIndex() ) << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Touching the pages does not change the pixels, whatever the pixel
+  // size and the region.
+  typedef itk::VectorImage< short, 3 > VectorImageType;
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  vectorImage->SetRegions( source->GetOutput()->GetBufferedRegion() );
+  vectorImage->SetNumberOfComponentsPerPixel( 3 );
+  vectorImage->Allocate();
+  const itk::SizeValueType numberOfValues = vectorImage->GetPixelContainer()->Size();
+  short *                  buffer = vectorImage->GetBufferPointer();
+  for ( itk::SizeValueType j = 0; j < numberOfValues; ++j )
+    {
+    buffer[j] = static_cast< short >( j % 1021 );
+    }
+
+  VectorImageType::RegionType region = vectorImage->GetBufferedRegion();
+  region.ShrinkByRadius( 2 );
+  vectorImage->FirstTouch( region );
+  vectorImage->FirstTouch( vectorImage->GetBufferedRegion() );
+  source->GetOutput()->FirstTouch( region );
+
+  for ( itk::SizeValueType j = 0; j < numberOfValues; ++j )
+    {
+    if ( buffer[j] != static_cast< short >( j % 1021 ) )
+      {
+      std::cerr << "Value " << j << " changed to " << buffer[j] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  source->Print( std::cout );
+
+  return EXIT_SUCCESS;
+}
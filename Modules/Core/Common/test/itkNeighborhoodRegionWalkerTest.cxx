@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNeighborhoodRegionWalker.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageToImageFilter.h"
+
+namespace
+{
+typedef itk::Image< short, 3 >                        ImageType;
+typedef itk::NeighborhoodRegionWalker< ImageType >    WalkerType;
+
+// Sum of the neighborhood, weighted by the position of the neighbors so
+// that the order of the values is checked too.
+struct WeightedSum
+{
+  short operator()(std::vector< short > & values) const
+  {
+    long sum = 0;
+    for ( unsigned int i = 0; i < values.size(); ++i )
+      {
+      sum += ( i % 7 + 1 ) * values[i];
+      }
+    return static_cast< short >( sum );
+  }
+};
+
+// Process object driving the ProgressReporter.
+class WalkerTestFilter:public itk::ImageToImageFilter< ImageType, ImageType >
+{
+public:
+  typedef WalkerTestFilter         Self;
+  typedef itk::SmartPointer< Self > Pointer;
+  itkNewMacro(Self);
+};
+
+struct SumAccumulator
+{
+  void Reset() { m_Sum = 0; }
+  void Add(short value) { m_Sum += value; }
+  void Remove(short value) { m_Sum -= value; }
+  short GetValue(short center) const { return static_cast< short >( m_Sum - center ); }
+  long m_Sum;
+};
+
+// Compare the output of the walker with ConstNeighborhoodIterator over
+// the whole region.
+bool CheckWalker(const ImageType *image, const ImageType::RegionType & region,
+                 const ImageType::SizeType & radius)
+{
+  WalkerTestFilter::Pointer filter = WalkerTestFilter::New();
+  itk::ProgressReporter progress(filter, 0, region.GetNumberOfPixels() * 2);
+
+  ImageType::Pointer gathered = ImageType::New();
+  gathered->SetRegions(region);
+  gathered->Allocate();
+  ImageType::Pointer slid = ImageType::New();
+  slid->SetRegions(region);
+  slid->Allocate();
+
+  WalkerType     walker(image, radius);
+  WeightedSum    function;
+  SumAccumulator accumulator;
+  walker.ComputeFromNeighborhoods(gathered.GetPointer(), region, function, progress);
+  walker.ComputeFromSlidingWindow(slid.GetPointer(), region, accumulator, progress);
+
+  itk::ConstNeighborhoodIterator< ImageType > bit(radius, image, region);
+  if ( walker.GetNeighborhoodSize() != bit.Size() )
+    {
+    std::cerr << "Neighborhood size " << walker.GetNeighborhoodSize() << " instead of " << bit.Size() << std::endl;
+    return false;
+    }
+  itk::ImageRegionConstIterator< ImageType > git(gathered, region);
+  itk::ImageRegionConstIterator< ImageType > sit(slid, region);
+  for ( bit.GoToBegin(); !bit.IsAtEnd(); ++bit, ++git, ++sit )
+    {
+    std::vector< short > values( bit.Size() );
+    long                 sum = 0;
+    for ( unsigned int i = 0; i < bit.Size(); ++i )
+      {
+      values[i] = bit.GetPixel(i);
+      sum += values[i];
+      }
+    if ( git.Get() != function(values) || sit.Get() != static_cast< short >( sum - bit.GetCenterPixel() ) )
+      {
+      std::cerr << "Wrong value at " << bit.GetIndex() << " for radius " << radius
+                << " over " << region << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkNeighborhoodRegionWalkerTest(int, char *[])
+{
+  ImageType::IndexType start;
+  start[0] = 2;
+  start[1] = -3;
+  start[2] = 0;
+  ImageType::SizeType size;
+  size[0] = 17;
+  size[1] = 11;
+  size[2] = 6;
+  ImageType::RegionType region(start, size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  short value = 0;
+  for ( itk::ImageRegionIterator< ImageType > it(image, region); !it.IsAtEnd(); ++it )
+    {
+    value = static_cast< short >( ( value * 31 + 17 ) % 101 );
+    it.Set(value);
+    }
+
+  ImageType::SizeType radius;
+  radius[0] = 2;
+  radius[1] = 1;
+  radius[2] = 1;
+
+  // The whole image, and a region touching a single side.
+  ImageType::RegionType inside = region;
+  inside.SetIndex(0, start[0] + 3);
+  inside.SetSize(0, 9);
+  inside.SetSize(2, 4);
+  if ( !CheckWalker(image, region, radius) || !CheckWalker(image, inside, radius) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A radius larger than the image along the last dimension: there is
+  // no interior face.
+  radius[2] = 4;
+  if ( !CheckWalker(image, region, radius) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // No neighbor along the first dimension.
+  radius[0] = 0;
+  radius[2] = 1;
+  if ( !CheckWalker(image, region, radius) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
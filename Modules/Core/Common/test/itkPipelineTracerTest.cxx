@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPipelineTracer.h"
+#include "itkImageSource.h"
+#include "itkImageRegionIterator.h"
+#include <fstream>
+#include <sstream>
+
+namespace itk
+{
+/** Fills its 128x64 output with a constant. */
+template< class TOutputImage >
+class PipelineTracerTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef PipelineTracerTestSource    Self;
+  typedef ImageSource< TOutputImage > Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(PipelineTracerTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+protected:
+  PipelineTracerTestSource() {}
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size[0] = 128;
+    size[1] = 64;
+    typename TOutputImage::RegionType region;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    for ( ImageRegionIterator< TOutputImage > it(this->GetOutput(), region); !it.IsAtEnd(); ++it )
+      {
+      it.Set(1);
+      }
+  }
+};
+}
+
+int itkPipelineTracerTest(int argc, char *argv[])
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " traceFile" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef itk::Image< double, 2 >                      ImageType;
+  typedef itk::PipelineTracerTestSource< ImageType >   SourceType;
+
+  itk::PipelineTracer::Pointer tracer = itk::PipelineTracer::GetInstance();
+
+  // Nothing is recorded while tracing is off.
+  itk::PipelineTracer::SetEnabled(false);
+  tracer->Clear();
+  SourceType::Pointer source = SourceType::New();
+  source->SetNumberOfThreads(2);
+  source->Update();
+  if ( tracer->GetNumberOfSpans() != 0 )
+    {
+    std::cerr << "Spans recorded while tracing is off" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Release the output so that the traced update allocates it again.
+  itk::PipelineTracer::SetEnabled(true);
+  source->GetOutput()->ReleaseData();
+  source->Modified();
+  source->Update();
+  itk::PipelineTracer::SetEnabled(false);
+
+  std::ostringstream trace;
+  tracer->WriteChromeTrace(trace);
+  const std::string json = trace.str();
+
+  const char *expected[] = {
+    "{\"traceEvents\":[",
+    "\"name\":\"PipelineTracerTestSource::GenerateOutputInformation\",\"cat\":\"pipeline\"",
+    "\"name\":\"PipelineTracerTestSource::PropagateRequestedRegion\",\"cat\":\"pipeline\"",
+    "\"name\":\"PipelineTracerTestSource::GenerateData\",\"cat\":\"pipeline\"",
+    "\"name\":\"PipelineTracerTestSource::AllocateOutputs\",\"cat\":\"memory\"",
+    "\"name\":\"ImageBufferAllocator::Allocate\",\"cat\":\"memory\"",
+    "\"args\":{\"bytes\":65536}",
+    "\"name\":\"PipelineTracerTestSource::ThreadedGenerateData\",\"cat\":\"thread\"",
+    "\"name\":\"MultiThreader::SingleMethod\",\"cat\":\"thread\"",
+    "\"ph\":\"X\"",
+    "],\"displayTimeUnit\":\"ms\"}"
+  };
+  for ( unsigned int i = 0; i < sizeof( expected ) / sizeof( expected[0] ); ++i )
+    {
+    if ( json.find(expected[i]) == std::string::npos )
+      {
+      std::cerr << "Missing " << expected[i] << " in the trace:" << std::endl << json << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Each thread running the filter is traced on its own row.
+  const itk::SizeValueType numberOfSpans = tracer->GetNumberOfSpans();
+  if ( source->GetMultiThreader()->GetNumberOfThreads() > 1 && json.find("\"tid\":1") == std::string::npos )
+    {
+    std::cerr << "Missing the second thread in the trace:" << std::endl << json << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  tracer->WriteChromeTrace( std::string( argv[1] ) );
+  std::ifstream file( argv[1] );
+  std::string   firstLine;
+  std::getline(file, firstLine);
+  if ( firstLine != "{\"traceEvents\":[" )
+    {
+    std::cerr << "Unexpected trace file content " << firstLine << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  tracer->Clear();
+  if ( tracer->GetNumberOfSpans() != 0 || numberOfSpans == 0 )
+    {
+    std::cerr << "Clear() did not remove the spans" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  tracer->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
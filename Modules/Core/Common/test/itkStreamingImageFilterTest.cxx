@@ -148,6 +148,43 @@ int itkStreamingImageFilterTest(int, char* [] )
       }
     }
 
+  //
+  // With a memory budget of four output rows, the output must be the
+  // same, streamed in as many pieces as the rows allow and copied by
+  // several threads.
+  //
+  ShortImage::Pointer dividedOutput = streamer->GetOutput();
+  dividedOutput->DisconnectPipeline();
+
+  const itk::SizeValueType rowSize = requestedRegion.GetSize()[0] * sizeof( short );
+  streamer->SetMemoryBudget( 4 * rowSize );
+  streamer->SetNumberOfThreads( 3 );
+  monitor->Modified();
+  streamer->Update();
+
+  const unsigned int budgetDivisions = ( requestedRegion.GetSize()[1] + 3 ) / 4;
+  std::cout << "streamer->GetMemoryBudget(): " << streamer->GetMemoryBudget() << std::endl;
+  if ( monitor->GetNumberOfUpdates() != budgetDivisions )
+    {
+    std::cout << monitor;
+    std::cout << "Expected " << budgetDivisions << " pieces within the memory budget." << std::endl;
+    passed = false;
+    }
+
+  itk::ImageRegionIterator<ShortImage> iterator3(streamer->GetOutput(), requestedRegion);
+  itk::ImageRegionIterator<ShortImage> iterator4(dividedOutput, requestedRegion);
+  for (; !iterator3.IsAtEnd(); ++iterator3, ++iterator4)
+    {
+    if ( iterator3.Get() != iterator4.Get() )
+      {
+      passed = false;
+      std::cout << "Pixel " << iterator3.GetIndex()
+                << " streamed within the memory budget is " << iterator3.Get()
+                << " instead of " << iterator4.Get()
+                << std::endl;
+      }
+    }
+
   if (passed)
     {
     std::cout << "ImageStreamingFilter test passed." << std::endl;
@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSummedAreaTable.h"
+#include "itkImageToImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkConstNeighborhoodIterator.h"
+
+namespace
+{
+typedef itk::Image< float, 3 >                     ImageType;
+typedef itk::Image< double, 3 >                    RealImageType;
+typedef itk::SummedAreaTable< ImageType >          TableType;
+typedef TableType::BoxStatistics                   BoxType;
+
+// Process object driving the ProgressReporter.
+class SummedAreaTableTestFilter:public itk::ImageToImageFilter< ImageType, ImageType >
+{
+public:
+  typedef SummedAreaTableTestFilter Self;
+  typedef itk::SmartPointer< Self > Pointer;
+  itkNewMacro(Self);
+};
+
+// Return one of the statistics of the box, selected by m_Statistic.
+struct StatisticFunction
+{
+  int m_Statistic;
+  double operator()(const BoxType & box) const
+  {
+    switch ( m_Statistic )
+      {
+      case 0:
+        return box.Sum;
+      case 1:
+        return box.GetVariance();
+      case 2:
+        return static_cast< double >( box.NumberOfPixels );
+      default:
+        return box.GetCorrelation();
+      }
+  }
+};
+
+// Compare the statistics of the table with the ones of the neighborhoods
+// walked by ConstNeighborhoodIterator, within the buffered region when
+// crop is true.
+bool CheckTable(const ImageType *image, const ImageType *second, const ImageType::RegionType & region,
+                const ImageType::SizeType & radius, bool crop, itk::SizeValueType maximumNumberOfEntries)
+{
+  SummedAreaTableTestFilter::Pointer filter = SummedAreaTableTestFilter::New();
+  itk::ProgressReporter progress(filter, 0, 4 * region.GetNumberOfPixels());
+
+  TableType table(image, radius);
+  table.SetComputeSumOfSquares(true);
+  table.SetSecondInput(second);
+  table.SetCropBoxes(crop);
+  table.SetMaximumNumberOfTableEntries(maximumNumberOfEntries);
+
+  std::vector< RealImageType::Pointer > results;
+  for ( int statistic = 0; statistic < 4; ++statistic )
+    {
+    RealImageType::Pointer result = RealImageType::New();
+    result->SetRegions(region);
+    result->Allocate();
+    StatisticFunction function;
+    function.m_Statistic = statistic;
+    table.ComputeFromBoxes(result.GetPointer(), region, function, progress);
+    results.push_back(result);
+    }
+
+  itk::ConstNeighborhoodIterator< ImageType > xit(radius, image, region);
+  itk::ConstNeighborhoodIterator< ImageType > yit(radius, second, region);
+  for ( ; !xit.IsAtEnd(); ++xit, ++yit )
+    {
+    double sx = 0, sxx = 0, sy = 0, syy = 0, sxy = 0, n = 0;
+    for ( unsigned int i = 0; i < xit.Size(); ++i )
+      {
+      bool inBounds = true;
+      const double x = xit.GetPixel(i, inBounds);
+      const double y = yit.GetPixel(i);
+      if ( inBounds || !crop )
+        {
+        sx += x;
+        sxx += x * x;
+        sy += y;
+        syy += y * y;
+        sxy += x * y;
+        n += 1;
+        }
+      }
+    const double variance = ( sxx - sx * sx / n ) / ( n - 1 );
+    const double correlation = ( sxy - sx * sy / n ) / vcl_sqrt( ( sxx - sx * sx / n ) * ( syy - sy * sy / n ) );
+    const double expected[4] = { sx, variance, n, correlation };
+    for ( int statistic = 0; statistic < 4; ++statistic )
+      {
+      const double value = results[statistic]->GetPixel( xit.GetIndex() );
+      if ( vcl_abs(value - expected[statistic]) > 1e-9 * ( 1 + vcl_abs(expected[statistic]) ) )
+        {
+        std::cerr << "Statistic " << statistic << " is " << value << " instead of " << expected[statistic]
+                  << " at " << xit.GetIndex() << " for radius " << radius << ( crop ? " (cropped)" : "" )
+                  << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkSummedAreaTableTest(int, char *[])
+{
+  ImageType::IndexType start;
+  start[0] = -4;
+  start[1] = 3;
+  start[2] = 1;
+  ImageType::SizeType size;
+  size[0] = 19;
+  size[1] = 13;
+  size[2] = 11;
+  ImageType::RegionType region(start, size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  ImageType::Pointer second = ImageType::New();
+  second->SetRegions(region);
+  second->Allocate();
+
+  // Large values of small variations, so that the variances come from
+  // the difference of close sums.
+  unsigned int value = 1;
+  itk::ImageRegionIterator< ImageType > sit(second, region);
+  for ( itk::ImageRegionIterator< ImageType > it(image, region); !it.IsAtEnd(); ++it, ++sit )
+    {
+    value = ( value * 1103515245u + 12345u ) % 2147483648u;
+    it.Set( 10000.0f + static_cast< float >( value % 97 ) / 8.0f );
+    sit.Set( static_cast< float >( value % 89 ) - 3.0f * it.Get() / 10000.0f );
+    }
+
+  ImageType::SizeType radius;
+  radius[0] = 2;
+  radius[1] = 1;
+  radius[2] = 3;
+
+  // A sub-region touching two sides of the image.
+  ImageType::RegionType inside = region;
+  inside.SetIndex(1, start[1] + 4);
+  inside.SetSize(1, 9);
+  inside.SetSize(2, 5);
+
+  for ( int crop = 0; crop < 2; ++crop )
+    {
+    // The default tables, and small tables for slabs of a few planes or
+    // of a single one.
+    if ( !CheckTable(image, second, region, radius, crop != 0, 1 << 21)
+         || !CheckTable(image, second, inside, radius, crop != 0, 1 << 21)
+         || !CheckTable(image, second, region, radius, crop != 0, 4000)
+         || !CheckTable(image, second, region, radius, crop != 0, 1) )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A radius larger than the image.
+  radius[2] = 15;
+  if ( !CheckTable(image, second, region, radius, false, 1 << 21)
+       || !CheckTable(image, second, region, radius, true, 1 << 21) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // Mismatched second input.
+  ImageType::Pointer other = ImageType::New();
+  other->SetRegions(inside);
+  other->Allocate();
+  try
+    {
+    CheckTable(image, other, inside, radius, false, 1 << 21);
+    std::cerr << "A second input of another region was accepted" << std::endl;
+    return EXIT_FAILURE;
+    }
+  catch ( itk::ExceptionObject & excp )
+    {
+    std::cout << "Caught expected exception: " << excp.GetDescription() << std::endl;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkThreadPool.h"
+#include "itkBarrier.h"
+#include "itkMutexLockHolder.h"
+
+namespace
+{
+class ThreadPoolTestUserData
+{
+public:
+  itk::SimpleFastMutexLock m_Mutex;
+  unsigned int             m_Visits[ITK_MAX_THREADS];
+  itk::ThreadIdType        m_NumberOfThreadsSeen;
+  itk::Barrier::Pointer    m_Barrier;
+  bool                     m_Nested;
+
+  ThreadPoolTestUserData()
+  {
+    for ( unsigned int i = 0; i < ITK_MAX_THREADS; i++ )
+      {
+      m_Visits[i] = 0;
+      }
+    m_NumberOfThreadsSeen = 0;
+    m_Nested = false;
+  }
+};
+
+ITK_THREAD_RETURN_TYPE ThreadPoolTestCallback( void *ptr )
+{
+  itk::MultiThreader::ThreadInfoStruct *info =
+    static_cast< itk::MultiThreader::ThreadInfoStruct * >( ptr );
+  ThreadPoolTestUserData *data = static_cast< ThreadPoolTestUserData * >( info->UserData );
+
+  if ( data->m_Barrier.IsNotNull() )
+    {
+    // All the threads must be running at the same time to get past this.
+    data->m_Barrier->Wait();
+    }
+
+  if ( data->m_Nested )
+    {
+    ThreadPoolTestUserData nestedData;
+    itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+    threader->UseThreadPoolOn();
+    threader->SetNumberOfThreads( 3 );
+    threader->SetSingleMethod( ThreadPoolTestCallback, &nestedData );
+    threader->SingleMethodExecute();
+    }
+
+  itk::MutexLockHolder< itk::SimpleFastMutexLock > holder( data->m_Mutex );
+  data->m_Visits[info->ThreadID]++;
+  data->m_NumberOfThreadsSeen = info->NumberOfThreads;
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+bool CheckVisits( const ThreadPoolTestUserData & data, itk::ThreadIdType numberOfThreads )
+{
+  if ( data.m_NumberOfThreadsSeen != numberOfThreads )
+    {
+    std::cerr << "Expected NumberOfThreads " << numberOfThreads
+              << " but got " << data.m_NumberOfThreadsSeen << std::endl;
+    return false;
+    }
+  for ( itk::ThreadIdType i = 0; i < ITK_MAX_THREADS; i++ )
+    {
+    const unsigned int expected = ( i < numberOfThreads ) ? 1 : 0;
+    if ( data.m_Visits[i] != expected )
+      {
+      std::cerr << "Thread id " << i << " ran " << data.m_Visits[i]
+                << " times instead of " << expected << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkThreadPoolTest(int, char* [])
+{
+  const itk::ThreadIdType numberOfThreads = 4;
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->UseThreadPoolOn();
+  threader->SetNumberOfThreads( numberOfThreads );
+  if ( !threader->GetUseThreadPool() )
+    {
+    std::cerr << "UseThreadPool was not set" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Every thread id runs exactly once, and the workers are reused.
+  itk::ThreadIdType numberOfWorkers = 0;
+  for ( unsigned int run = 0; run < 20; run++ )
+    {
+    ThreadPoolTestUserData data;
+    threader->SetSingleMethod( ThreadPoolTestCallback, &data );
+    threader->SingleMethodExecute();
+    if ( !CheckVisits( data, threader->GetNumberOfThreads() ) )
+      {
+      return EXIT_FAILURE;
+      }
+    if ( run == 0 )
+      {
+      numberOfWorkers = itk::ThreadPool::GetInstance()->GetNumberOfWorkers();
+      }
+    }
+  if ( itk::ThreadPool::GetInstance()->GetNumberOfWorkers() != numberOfWorkers )
+    {
+    std::cerr << "The pool grew from " << numberOfWorkers << " to "
+              << itk::ThreadPool::GetInstance()->GetNumberOfWorkers()
+              << " workers while running the same work" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The threads of one execution run concurrently.
+  {
+  ThreadPoolTestUserData data;
+  data.m_Barrier = itk::Barrier::New();
+  data.m_Barrier->Initialize( threader->GetNumberOfThreads() );
+  threader->SetSingleMethod( ThreadPoolTestCallback, &data );
+  threader->SingleMethodExecute();
+  if ( !CheckVisits( data, threader->GetNumberOfThreads() ) )
+    {
+    return EXIT_FAILURE;
+    }
+  }
+
+  // Executions nested in a pool thread complete.
+  {
+  ThreadPoolTestUserData data;
+  data.m_Nested = true;
+  threader->SetSingleMethod( ThreadPoolTestCallback, &data );
+  threader->SingleMethodExecute();
+  if ( !CheckVisits( data, threader->GetNumberOfThreads() ) )
+    {
+    return EXIT_FAILURE;
+    }
+  }
+
+  itk::ThreadPool::GetInstance()->Print( std::cout );
+
+  return EXIT_SUCCESS;
+}
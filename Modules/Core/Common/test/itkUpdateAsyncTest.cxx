@@ -0,0 +1,322 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkUpdateFuture.h"
+#include "itkImageToImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+#include "itksys/SystemTools.hxx"
+
+namespace itk
+{
+/** Fills its output with a value, optionally waiting at each line, and
+ * counts its executions.  When Rendezvous is on, the first line waits
+ * up to two seconds for another source to start executing. */
+template< class TOutputImage >
+class UpdateAsyncTestSource:public ImageSource< TOutputImage >
+{
+public:
+  typedef UpdateAsyncTestSource       Self;
+  typedef ImageSource< TOutputImage > Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(UpdateAsyncTestSource, ImageSource);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename TOutputImage::PixelType           PixelType;
+
+  itkSetMacro(Value, PixelType);
+  itkSetMacro(LineDelay, unsigned int);
+  itkSetMacro(Rendezvous, bool);
+  itkGetConstMacro(NumberOfExecutions, unsigned int);
+  itkGetConstMacro(MetPartner, bool);
+
+  static volatile unsigned int m_NumberOfStartedSources;
+
+protected:
+  UpdateAsyncTestSource():
+    m_Value(0), m_LineDelay(0), m_Rendezvous(false), m_NumberOfExecutions(0), m_MetPartner(false)
+  {
+    this->SetNumberOfThreads(1);
+  }
+
+  void GenerateOutputInformation()
+  {
+    typename TOutputImage::SizeType size;
+    size.Fill(20);
+    typename TOutputImage::RegionType region;
+    region.SetSize(size);
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void BeforeThreadedGenerateData()
+  {
+    ++m_NumberOfExecutions;
+    m_MetPartner = false;
+    if ( m_Rendezvous )
+      {
+      // Sources meet by pairs: the first of a pair waits for the second.
+      const unsigned int ticket = ++m_NumberOfStartedSources;
+      const unsigned int pair = ticket + ticket % 2;
+      for ( unsigned int i = 0; i < 2000 && m_NumberOfStartedSources < pair; ++i )
+        {
+        itksys::SystemTools::Delay(1);
+        }
+      m_MetPartner = ( m_NumberOfStartedSources >= pair );
+      }
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType threadId)
+  {
+    const SizeValueType numberOfLines = region.GetNumberOfPixels() / region.GetSize(0);
+    ProgressReporter    progress(this, threadId, numberOfLines, numberOfLines);
+
+    ImageRegionIterator< TOutputImage > it(this->GetOutput(), region);
+    while ( !it.IsAtEnd() )
+      {
+      for ( SizeValueType i = 0; i < region.GetSize(0); ++i, ++it )
+        {
+        it.Set(m_Value);
+        }
+      if ( m_LineDelay )
+        {
+        itksys::SystemTools::Delay(m_LineDelay);
+        }
+      progress.CompletedPixel();
+      }
+  }
+
+private:
+  PixelType    m_Value;
+  unsigned int m_LineDelay;
+  bool         m_Rendezvous;
+  unsigned int m_NumberOfExecutions;
+  bool         m_MetPartner;
+};
+
+template< class TOutputImage >
+volatile unsigned int UpdateAsyncTestSource< TOutputImage >::m_NumberOfStartedSources = 0;
+
+/** Sums its two inputs, or throws when Fail is on. */
+template< class TImage >
+class UpdateAsyncTestSum:public ImageToImageFilter< TImage, TImage >
+{
+public:
+  typedef UpdateAsyncTestSum                    Self;
+  typedef ImageToImageFilter< TImage, TImage >  Superclass;
+  typedef SmartPointer< Self >                  Pointer;
+  typedef SmartPointer< const Self >            ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(UpdateAsyncTestSum, ImageToImageFilter);
+
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  void SetInput2(const TImage *image)
+  {
+    this->SetNthInput( 1, const_cast< TImage * >( image ) );
+  }
+
+  itkSetMacro(Fail, bool);
+
+protected:
+  UpdateAsyncTestSum():m_Fail(false) {}
+
+  void ThreadedGenerateData(const OutputImageRegionType & region, ThreadIdType)
+  {
+    if ( m_Fail )
+      {
+      itkExceptionMacro(<< "Failing on purpose");
+      }
+    ImageRegionConstIterator< TImage > it1(this->GetInput(0), region);
+    ImageRegionConstIterator< TImage > it2(this->GetInput(1), region);
+    for ( ImageRegionIterator< TImage > ot(this->GetOutput(), region); !ot.IsAtEnd(); ++ot, ++it1, ++it2 )
+      {
+      ot.Set( it1.Get() + it2.Get() );
+      }
+  }
+
+private:
+  bool m_Fail;
+};
+}
+
+namespace
+{
+typedef itk::Image< int, 2 >                    ImageType;
+typedef itk::UpdateAsyncTestSource< ImageType > SourceType;
+typedef itk::UpdateAsyncTestSum< ImageType >    SumType;
+
+bool CheckOutput(const ImageType *image, int value)
+{
+  for ( itk::ImageRegionConstIterator< ImageType > it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() != value )
+      {
+      std::cerr << "Pixel is " << it.Get() << " instead of " << value << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+SumType::Pointer MakePipeline(SourceType::Pointer & source1, SourceType::Pointer & source2)
+{
+  source1 = SourceType::New();
+  source1->SetValue(1);
+  source2 = SourceType::New();
+  source2->SetValue(2);
+  SumType::Pointer sum = SumType::New();
+  sum->SetInput( source1->GetOutput() );
+  sum->SetInput2( source2->GetOutput() );
+  return sum;
+}
+}
+
+int itkUpdateAsyncTest(int, char* [])
+{
+  SourceType::Pointer source1;
+  SourceType::Pointer source2;
+
+  // A successful update.
+  SumType::Pointer sum = MakePipeline(source1, source2);
+  itk::UpdateFuture::Pointer future = sum->UpdateAsync();
+  future->Wait();
+  if ( future->GetStatus() != itk::UpdateFuture::Completed || !CheckOutput( sum->GetOutput(), 3 ) )
+    {
+    std::cerr << "The asynchronous update did not complete" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Independent pipelines, consumed in the order they complete.
+  std::vector< SumType::Pointer >           sums;
+  std::vector< itk::UpdateFuture::Pointer > futures;
+  for ( unsigned int i = 0; i < 4; ++i )
+    {
+    sums.push_back( MakePipeline(source1, source2) );
+    source1->SetLineDelay(4 - i);
+    futures.push_back( sums.back()->UpdateAsync() );
+    }
+  while ( !futures.empty() )
+    {
+    const unsigned int done = itk::UpdateFuture::WaitForAny(futures);
+    if ( done >= futures.size() || !futures[done]->IsDone() )
+      {
+      std::cerr << "WaitForAny returned a running update" << std::endl;
+      return EXIT_FAILURE;
+      }
+    futures[done]->Wait();
+    SumType *doneSum = dynamic_cast< SumType * >( futures[done]->GetProcessObject() );
+    if ( !CheckOutput( doneSum->GetOutput(), 3 ) )
+      {
+      return EXIT_FAILURE;
+      }
+    futures.erase( futures.begin() + done );
+    }
+
+  // A failing update reports the exception.
+  sum = MakePipeline(source1, source2);
+  sum->SetFail(true);
+  future = sum->UpdateAsync();
+  bool caught = false;
+  try
+    {
+    future->Wait();
+    }
+  catch ( itk::ExceptionObject & excp )
+    {
+    std::cout << "Expected exception: " << excp.GetDescription() << std::endl;
+    caught = true;
+    }
+  if ( !caught || future->GetStatus() != itk::UpdateFuture::Failed )
+    {
+    std::cerr << "The failure of the update was not reported" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Cancel a slow update: either the running source stops at its next
+  // line, or the sources that have not started do not execute.
+  sum = MakePipeline(source1, source2);
+  sum->ConcurrentInputUpdateOff();
+  source1->SetLineDelay(50);
+  source2->SetLineDelay(50);
+  future = sum->UpdateAsync();
+  itksys::SystemTools::Delay(20);
+  future->Cancel();
+  caught = false;
+  try
+    {
+    future->Wait();
+    }
+  catch ( itk::ProcessAborted & excp )
+    {
+    std::cout << "Expected exception: " << excp.GetDescription() << std::endl;
+    caught = true;
+    }
+  if ( !caught || future->GetStatus() != itk::UpdateFuture::Canceled )
+    {
+    std::cerr << "The update was not canceled" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( source1->GetNumberOfExecutions() + source2->GetNumberOfExecutions() > 1 )
+    {
+    std::cerr << "The pipeline went on after the cancellation" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The cancellation does not outlive the canceled update.
+  source1->SetLineDelay(0);
+  source2->SetLineDelay(0);
+  sum->Update();
+  if ( !CheckOutput( sum->GetOutput(), 3 ) )
+    {
+    return EXIT_FAILURE;
+    }
+  future->Print(std::cout);
+
+  // Independent inputs are updated concurrently: each source waits for
+  // the other one to start.
+  sum = MakePipeline(source1, source2);
+  source1->SetRendezvous(true);
+  source2->SetRendezvous(true);
+  sum->ConcurrentInputUpdateOn();
+  sum->Update();
+  if ( !source1->GetMetPartner() || !source2->GetMetPartner() || !CheckOutput( sum->GetOutput(), 3 ) )
+    {
+    std::cerr << "The inputs were not updated concurrently" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Branches sharing a ProcessObject are updated one after the other.
+  SourceType::Pointer shared = SourceType::New();
+  shared->SetValue(5);
+  sum = SumType::New();
+  sum->SetInput( shared->GetOutput() );
+  sum->SetInput2( shared->GetOutput() );
+  sum->ConcurrentInputUpdateOn();
+  sum->Update();
+  if ( shared->GetNumberOfExecutions() != 1 || !CheckOutput( sum->GetOutput(), 10 ) )
+    {
+    std::cerr << "A shared input was not updated once" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -76,7 +76,7 @@ public:
   //
   // Allocate CPU and GPU memory space
   //
-  void Allocate();
+  void Allocate(bool initializePixels = false);
 
   virtual void Initialize();
 
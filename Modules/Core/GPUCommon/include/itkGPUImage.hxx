@@ -39,10 +39,10 @@ GPUImage< TPixel, VImageDimension >::~GPUImage()
 }
 
 template <class TPixel, unsigned int VImageDimension>
-void GPUImage< TPixel, VImageDimension >::Allocate()
+void GPUImage< TPixel, VImageDimension >::Allocate(bool initializePixels)
 {
   // allocate CPU memory - calling Allocate() in superclass
-  Superclass::Allocate();
+  Superclass::Allocate(initializePixels);
 
   // allocate GPU memory
   this->ComputeOffsetTable();
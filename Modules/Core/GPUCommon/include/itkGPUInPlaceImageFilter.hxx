@@ -58,7 +58,7 @@ GPUInPlaceImageFilter< TInputImage, TOutputImage, TParentImageFilter >
   if( this->GetGPUEnabled() )
     {
     // if told to run in place and the types support it,
-    if ( this->GetInPlace() && this->CanRunInPlace() )
+    if ( this->WillRunInPlace() )
       {
       // Graft this first input to the output.  Later, we'll need to
       // remove the input's hold on the bulk data.
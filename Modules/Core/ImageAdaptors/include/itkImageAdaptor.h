@@ -187,9 +187,9 @@ public:
   virtual const RegionType & GetBufferedRegion() const;
 
   /** Allocate the image memory. Dimension and Size must be set a priori. */
-  inline void Allocate()
+  inline void Allocate(bool initializePixels = false)
   {
-    m_Image->Allocate();
+    m_Image->Allocate(initializePixels);
   }
 
   /** Restore the data object to its initial state. This means releasing
@@ -180,6 +180,16 @@ public:
                                                index,
                                                ThreadIdType threadID) const;
 
+  /** Evaluate the function at an array of ContinuousIndex positions.
+   *
+   * Gives the same values as EvaluateAtContinuousIndex().  The working
+   * space is made on the stack once for the whole array, and the
+   * coefficients of the region of support are read at buffer offsets
+   * instead of through their indices. */
+  virtual void EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                                           OutputType *values,
+                                           SizeValueType numberOfIndices) const;
+
   CovariantVectorType EvaluateDerivative(const PointType & point) const
   {
     ContinuousIndexType index;
@@ -209,6 +209,63 @@ BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
 #endif
 }
 
+template< class TImageType, class TCoordRep, class TCoefficientType >
+void
+BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
+::EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                              OutputType *values,
+                              SizeValueType numberOfIndices) const
+{
+  vnl_matrix< long >   evaluateIndex( ImageDimension, ( m_SplineOrder + 1 ) );
+  vnl_matrix< double > weights( ImageDimension, ( m_SplineOrder + 1 ) );
+
+  // The offset of a coefficient is the sum of the offsets of its index
+  // along each dimension.
+  const CoefficientDataType *buffer = m_Coefficients->GetBufferPointer();
+  const OffsetValueType *    offsetTable = m_Coefficients->GetOffsetTable();
+  const IndexType &          bufferStart = m_Coefficients->GetBufferedRegion().GetIndex();
+  vnl_matrix< OffsetValueType > evaluateOffset( ImageDimension, ( m_SplineOrder + 1 ) );
+
+  for ( SizeValueType i = 0; i < numberOfIndices; ++i )
+    {
+    const ContinuousIndexType & x = indices[i];
+
+    // compute the interpolation indexes
+    this->DetermineRegionOfSupport( ( evaluateIndex ), x, m_SplineOrder );
+
+    // Determine weights
+    SetInterpolationWeights(x, ( evaluateIndex ), ( weights ), m_SplineOrder);
+
+    // Modify evaluateIndex at the boundaries using mirror boundary conditions
+    this->ApplyMirrorBoundaryConditions( ( evaluateIndex ), m_SplineOrder );
+
+    for ( unsigned int n = 0; n < ImageDimension; n++ )
+      {
+      for ( unsigned int k = 0; k <= m_SplineOrder; k++ )
+        {
+        evaluateOffset[n][k] = ( evaluateIndex[n][k] - bufferStart[n] ) * offsetTable[n];
+        }
+      }
+
+    // perform interpolation, in the order of EvaluateAtContinuousIndexInternal()
+    double interpolated = 0.0;
+    for ( unsigned int p = 0; p < m_MaxNumberInterpolationPoints; p++ )
+      {
+      double          w = 1.0;
+      OffsetValueType offset = 0;
+      for ( unsigned int n = 0; n < ImageDimension; n++ )
+        {
+        unsigned int indx = m_PointsToIndex[p][n];
+        w *= ( weights )[n][indx];
+        offset += evaluateOffset[n][indx];
+        }
+      interpolated += w * buffer[offset];
+      }
+
+    values[i] = interpolated;
+    }
+}
+
 template< class TImageType, class TCoordRep, class TCoefficientType >
 typename
 BSplineInterpolateImageFunction< TImageType, TCoordRep, TCoefficientType >
@@ -110,6 +110,23 @@ public:
   virtual OutputType EvaluateAtContinuousIndex(
     const ContinuousIndexType & index) const = 0;
 
+  /** Interpolate the image at an array of continuous index positions
+   *
+   * Writes to values[i] the interpolated image intensity at indices[i],
+   * for i in [0, numberOfIndices).  As for EvaluateAtContinuousIndex(),
+   * no bounds checking is done.  The default implementation evaluates
+   * the indices one at a time; subclasses override it to amortize the
+   * per call set up over the whole array.  It must be thread safe. */
+  virtual void EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                                           OutputType *values,
+                                           SizeValueType numberOfIndices) const
+  {
+    for ( SizeValueType i = 0; i < numberOfIndices; ++i )
+      {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+      }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
@@ -97,6 +97,16 @@ public:
     return this->EvaluateOptimized(Dispatch< ImageDimension >(), index);
   }
 
+  /** Evaluate the function at an array of ContinuousIndex positions
+   *
+   * Gives the same values as EvaluateAtContinuousIndex().  Up to three
+   * dimensions, the neighbors of the indices whose neighborhoods lie
+   * inside the buffer are read at offsets computed once for the whole
+   * array. */
+  virtual void EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                                           OutputType *values,
+                                           SizeValueType numberOfIndices) const;
+
 protected:
   LinearInterpolateImageFunction();
   ~LinearInterpolateImageFunction();
@@ -56,6 +56,102 @@ LinearInterpolateImageFunction< TInputImage, TCoordRep >
   this->Superclass::PrintSelf(os, indent);
 }
 
+/**
+ * Evaluate at an array of image index positions
+ */
+template< class TInputImage, class TCoordRep >
+void
+LinearInterpolateImageFunction< TInputImage, TCoordRep >
+::EvaluateAtContinuousIndices(const ContinuousIndexType *indices,
+                              OutputType *values,
+                              SizeValueType numberOfIndices) const
+{
+  // Beyond three dimensions all the neighbors are weighted at once by
+  // EvaluateUnoptimized(), which has nothing to share between indices.
+  if ( ImageDimension > 3 )
+    {
+    this->Superclass::EvaluateAtContinuousIndices(indices, values, numberOfIndices);
+    return;
+    }
+
+  typedef typename InputImageType::InternalPixelType   InternalPixelType;
+  typedef typename InputImageType::AccessorType        AccessorType;
+  typedef typename InputImageType::AccessorFunctorType AccessorFunctorType;
+
+  const InputImageType *    image = this->GetInputImage();
+  const InternalPixelType * buffer = image->GetBufferPointer();
+  const OffsetValueType *   offsetTable = image->GetOffsetTable();
+
+  // The pixels are read as by the image iterators.
+  AccessorType        pixelAccessor = image->GetPixelAccessor();
+  AccessorFunctorType accessor;
+  accessor.SetPixelAccessor(pixelAccessor);
+  accessor.SetBegin(buffer);
+
+  // Bit dim of the neighbor number selects the upper neighbor along dim.
+  OffsetValueType neighborOffsets[1 << ImageDimension];
+  for ( unsigned int counter = 0; counter < m_Neighbors; counter++ )
+    {
+    neighborOffsets[counter] = 0;
+    for ( unsigned int dim = 0; dim < ImageDimension; dim++ )
+      {
+      if ( counter & ( 1 << dim ) )
+        {
+        neighborOffsets[counter] += offsetTable[dim];
+        }
+      }
+    }
+
+  RealType neighbors[1 << ImageDimension];
+
+  for ( SizeValueType i = 0; i < numberOfIndices; ++i )
+    {
+    const ContinuousIndexType & index = indices[i];
+
+    IndexType basei;
+    double    distance[ImageDimension];
+    bool      interior = true;
+    for ( unsigned int dim = 0; dim < ImageDimension; dim++ )
+      {
+      basei[dim] = Math::Floor< IndexValueType >(index[dim]);
+      if ( basei[dim] < this->m_StartIndex[dim] )
+        {
+        basei[dim] = this->m_StartIndex[dim];
+        }
+      distance[dim] = index[dim] - static_cast< double >( basei[dim] );
+      interior = interior && distance[dim] > 0. && basei[dim] < this->m_EndIndex[dim];
+      }
+
+    // On the border of the buffer, or on the grid along some dimension,
+    // fewer neighbors are involved.
+    if ( !interior )
+      {
+      values[i] = this->EvaluateOptimized(Dispatch< ImageDimension >(), index);
+      continue;
+      }
+
+    const InternalPixelType *base = buffer + image->ComputeOffset(basei);
+    for ( unsigned int counter = 0; counter < m_Neighbors; counter++ )
+      {
+      neighbors[counter] = static_cast< RealType >( accessor.Get( *( base + neighborOffsets[counter] ) ) );
+      }
+
+    // Interpolate across "x" first, then "y", then "z", in the order of
+    // EvaluateOptimized() so that the values are the same.
+    unsigned int remaining = m_Neighbors;
+    for ( unsigned int dim = 0; dim < ImageDimension; dim++ )
+      {
+      remaining >>= 1;
+      for ( unsigned int k = 0; k < remaining; k++ )
+        {
+        neighbors[k] = neighbors[2 * k] + ( neighbors[2 * k + 1] - neighbors[2 * k] ) * distance[dim];
+        }
+      }
+
+    values[i] = static_cast< OutputType >( neighbors[0] );
+    }
+}
+
 /**
  * Evaluate at image index position
  */
@@ -183,6 +183,14 @@ double trueValue )
       std::cout << "*** Error: value should be " << trueValue << std::endl;
       return false;
       }
+
+    typename TInterpolator::OutputType values[1];
+    interp->EvaluateAtContinuousIndices( &index, values, 1 );
+    if( values[0] != value )
+      {
+      std::cout << "*** Error: value evaluated at once is " << values[0] << std::endl;
+      return false;
+      }
     }
 
   std::cout << std::endl;
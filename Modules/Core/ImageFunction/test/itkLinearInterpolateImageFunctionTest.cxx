@@ -17,6 +17,7 @@
  *=========================================================================*/
 
 #include <iostream>
+#include <vector>
 
 #include "itkImage.h"
 #include "itkVectorImage.h"
@@ -168,6 +169,9 @@ int RunTest( void )
 
  const double tolerance = 1e-6;
 
+ // The indices inside the buffer, evaluated at once below
+ std::vector< typename InterpolatorType::ContinuousIndexType > insideIndices;
+
  PointType point;
  unsigned int testLengths[4] = {1,1,1,1};
  for( unsigned int ind = 0; ind < Dimensions; ind++ )
@@ -202,6 +206,10 @@ int RunTest( void )
 
                  if( interpolator->IsInsideBuffer( point ) )
                    {
+                   typename InterpolatorType::ContinuousIndexType cindex;
+                   image->TransformPhysicalPointToContinuousIndex( point, cindex );
+                   insideIndices.push_back( cindex );
+
                    const double computedValue = interpolator->Evaluate( point );
                    const double difference = expectedValue - computedValue;
 
@@ -275,6 +283,33 @@ int RunTest( void )
        }
      }
    } //for dims[3]...
+
+ //
+ // The values evaluated at once must be those evaluated one at a time
+ //
+ const itk::SizeValueType numberOfIndices = insideIndices.size();
+ std::vector< typename InterpolatorType::OutputType > values( numberOfIndices );
+ std::vector< InterpolatedVectorType >                vectorValues( numberOfIndices );
+ std::vector< InterpolatedVariableVectorType >        variableVectorValues( numberOfIndices );
+ interpolator->EvaluateAtContinuousIndices(
+   &insideIndices[0], &values[0], numberOfIndices );
+ vectorinterpolator->EvaluateAtContinuousIndices(
+   &insideIndices[0], &vectorValues[0], numberOfIndices );
+ variablevectorinterpolator->EvaluateAtContinuousIndices(
+   &insideIndices[0], &variableVectorValues[0], numberOfIndices );
+ for( itk::SizeValueType i = 0; i < numberOfIndices; i++ )
+   {
+   if( values[i] != interpolator->EvaluateAtContinuousIndex( insideIndices[i] )
+       || vectorValues[i] != vectorinterpolator->EvaluateAtContinuousIndex( insideIndices[i] )
+       || variableVectorValues[i] != variablevectorinterpolator->EvaluateAtContinuousIndex( insideIndices[i] ) )
+     {
+     std::cerr << "Error found while evaluating the indices at once" << std::endl;
+     std::cerr << "Index = " << insideIndices[i] << std::endl;
+     std::cerr << "Value = " << values[i] << ", " << vectorValues[i]
+               << ", " << variableVectorValues[i] << std::endl;
+     return EXIT_FAILURE;
+     }
+   }
  return EXIT_SUCCESS;
  }// RunTest()
 
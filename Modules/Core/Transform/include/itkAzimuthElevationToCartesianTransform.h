@@ -134,6 +134,18 @@ public:
   /** Transform from azimuth-elevation to cartesian. */
   OutputPointType     TransformPoint(const InputPointType  & point) const;
 
+  /** Transform an array of points with TransformPoint(), which does not
+   * use the matrix of the superclass. */
+  void TransformPoints(const InputPointType *inputPoints,
+                       OutputPointType *outputPoints,
+                       SizeValueType numberOfPoints) const
+  {
+    for ( SizeValueType i = 0; i < numberOfPoints; ++i )
+      {
+      outputPoints[i] = this->TransformPoint(inputPoints[i]);
+      }
+  }
+
   /** Back transform from cartesian to azimuth-elevation.  */
   inline InputPointType  BackTransform(const OutputPointType  & point) const
   {
@@ -215,6 +215,12 @@ public:
   /** Transform points by a BSpline deformable transformation. */
   OutputPointType  TransformPoint( const InputPointType & point ) const;
 
+  /** Transform an array of points by a BSpline deformable transformation.
+   * The weights and indices arrays are allocated once for all the
+   * points. */
+  virtual void TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+    SizeValueType numberOfPoints ) const;
+
   /** Interpolation weights function type. */
   typedef BSplineInterpolationWeightFunction<ScalarType,
     itkGetStaticConstMacro( SpaceDimension ),
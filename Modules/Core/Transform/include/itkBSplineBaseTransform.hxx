@@ -345,5 +345,23 @@ BSplineBaseTransform<TScalarType, NDimensions, VSplineOrder>
   return outputPoint;
 }
 
+template <class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder>
+void
+BSplineBaseTransform<TScalarType, NDimensions, VSplineOrder>
+::TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+  SizeValueType numberOfPoints ) const
+{
+  WeightsType             weights( this->m_WeightsFunction->GetNumberOfWeights() );
+  ParameterIndexArrayType indices( this->m_WeightsFunction->GetNumberOfWeights() );
+  OutputPointType         outputPoint;
+  bool                    inside;
+
+  for( SizeValueType i = 0; i < numberOfPoints; ++i )
+    {
+    this->TransformPoint( inputPoints[i], outputPoint, weights, indices, inside );
+    outputPoints[i] = outputPoint;
+    }
+}
+
 } // namespace
 #endif
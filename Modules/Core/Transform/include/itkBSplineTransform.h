@@ -231,6 +231,12 @@ public:
   virtual void TransformPoint( const InputPointType & inputPoint, OutputPointType & outputPoint,
     WeightsType & weights, ParameterIndexArrayType & indices, bool & inside ) const;
 
+  /** Transform an array of points.  The coefficients of the support
+   * region of each point are read at offsets computed once for all the
+   * points, instead of through image iterators. */
+  virtual void TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+    SizeValueType numberOfPoints ) const;
+
   virtual void ComputeJacobianWithRespectToParameters( const InputPointType &, JacobianType & ) const;
 
   /** Return the number of parameters that completely define the Transfom */
@@ -24,6 +24,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -576,6 +578,87 @@ BSplineTransform<TScalarType, NDimensions, VSplineOrder>
     }
 }
 
+template <class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder>
+void
+BSplineTransform<TScalarType, NDimensions, VSplineOrder>
+::TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+  SizeValueType numberOfPoints ) const
+{
+  if( !this->m_CoefficientImages[0]->GetBufferPointer() )
+    {
+    Superclass::TransformPoints( inputPoints, outputPoints, numberOfPoints );
+    return;
+    }
+
+  const unsigned long numberOfWeights = this->m_WeightsFunction->GetNumberOfWeights();
+  WeightsType         weights( numberOfWeights );
+
+  // Offsets of the coefficients of a support region from its first one,
+  // in the order they are visited by an ImageRegionConstIterator.
+  std::vector<OffsetValueType> supportOffsets( numberOfWeights );
+  const OffsetValueType *      offsetTable = this->m_CoefficientImages[0]->GetOffsetTable();
+  IndexType                    supportPosition;
+  supportPosition.Fill( 0 );
+  for( unsigned long k = 0; k < numberOfWeights; k++ )
+    {
+    supportOffsets[k] = 0;
+    for( unsigned int d = 0; d < SpaceDimension; d++ )
+      {
+      supportOffsets[k] += supportPosition[d] * offsetTable[d];
+      }
+    for( unsigned int d = 0; d < SpaceDimension; d++ )
+      {
+      if( ++supportPosition[d] <= static_cast<IndexValueType>( SplineOrder ) )
+        {
+        break;
+        }
+      supportPosition[d] = 0;
+      }
+    }
+
+  const ParametersValueType *coefficients[SpaceDimension];
+  for( unsigned int j = 0; j < SpaceDimension; j++ )
+    {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+    }
+
+  ContinuousIndexType index;
+  IndexType           supportIndex;
+  OutputPointType     outputPoint;
+  for( SizeValueType i = 0; i < numberOfPoints; i++ )
+    {
+    this->m_CoefficientImages[0]->TransformPhysicalPointToContinuousIndex( inputPoints[i], index );
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if( !this->InsideValidRegion( index ) )
+      {
+      outputPoints[i] = inputPoints[i];
+      continue;
+      }
+
+    // Compute interpolation weights, and correlate them with the
+    // coefficients in the same order as TransformPoint()
+    this->m_WeightsFunction->Evaluate( index, weights, supportIndex );
+    const OffsetValueType supportOffset = this->m_CoefficientImages[0]->ComputeOffset( supportIndex );
+
+    outputPoint.Fill( NumericTraits<ScalarType>::Zero );
+    for( unsigned long k = 0; k < numberOfWeights; k++ )
+      {
+      const OffsetValueType offset = supportOffset + supportOffsets[k];
+      for( unsigned int j = 0; j < SpaceDimension; j++ )
+        {
+        outputPoint[j] += static_cast<ScalarType>( weights[k] * coefficients[j][offset] );
+        }
+      }
+    for( unsigned int j = 0; j < SpaceDimension; j++ )
+      {
+      outputPoint[j] += inputPoints[i][j];
+      }
+    outputPoints[i] = outputPoint;
+    }
+}
+
 // Compute the Jacobian in one position
 template <class TScalarType, unsigned int NDimensions, unsigned int VSplineOrder>
 void
@@ -319,6 +319,11 @@ public:
   */
   virtual OutputPointType TransformPoint( const InputPointType & inputPoint ) const;
 
+  /** Transform an array of points, applying each transform of the queue,
+   * in the same order as TransformPoint(), to all the points at once. */
+  virtual void TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+                                SizeValueType numberOfPoints ) const;
+
   /* Note: why was the 'isInsideTransformRegion' flag used below?
   {
     bool isInside = true;
@@ -353,6 +353,12 @@ public:
 
   OutputPointType       TransformPoint(const InputPointType & point) const;
 
+  /** Transform an array of points by the affine transformation, without
+   * a virtual call per point. */
+  virtual void TransformPoints(const InputPointType *inputPoints,
+                               OutputPointType *outputPoints,
+                               SizeValueType numberOfPoints) const;
+
   using Superclass::TransformVector;
 
   OutputVectorType      TransformVector(const InputVectorType & vector) const;
@@ -185,6 +185,21 @@ MatrixOffsetTransformBase<TScalarType, NInputDimensions, NOutputDimensions>
   return m_Matrix * point + m_Offset;
 }
 
+// Transform an array of points
+template <class TScalarType, unsigned int NInputDimensions,
+          unsigned int NOutputDimensions>
+void
+MatrixOffsetTransformBase<TScalarType, NInputDimensions, NOutputDimensions>
+::TransformPoints(const InputPointType *inputPoints,
+                  OutputPointType *outputPoints,
+                  SizeValueType numberOfPoints) const
+{
+  for ( SizeValueType i = 0; i < numberOfPoints; ++i )
+    {
+    outputPoints[i] = m_Matrix * inputPoints[i] + m_Offset;
+    }
+}
+
 // Transform a vector
 template <class TScalarType, unsigned int NInputDimensions,
           unsigned int NOutputDimensions>
@@ -160,6 +160,18 @@ public:
    * vector. */
   OutputPointType     TransformPoint(const InputPointType  & point) const;
 
+  /** Transform an array of points with TransformPoint(), which does not
+   * use the matrix of the superclass. */
+  void TransformPoints(const InputPointType *inputPoints,
+                       OutputPointType *outputPoints,
+                       SizeValueType numberOfPoints) const
+  {
+    for ( SizeValueType i = 0; i < numberOfPoints; ++i )
+      {
+      outputPoints[i] = this->TransformPoint(inputPoints[i]);
+      }
+  }
+
   using Superclass::TransformVector;
   OutputVectorType    TransformVector(const InputVectorType & vector) const;
 
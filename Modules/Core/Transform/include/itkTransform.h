@@ -188,6 +188,18 @@ public:
    */
   virtual OutputPointType TransformPoint(const InputPointType  &) const = 0;
 
+  /** Method to transform an array of points, such as the points of a line
+   * of an image.  The default implementation calls TransformPoint() for
+   * each point; subclasses override it to set up the work that does not
+   * depend on the point once for the whole array.  The results are the
+   * same as those of TransformPoint().  outputPoints may be the same
+   * array as inputPoints.
+   * \warning This method must be thread-safe.
+   */
+  virtual void TransformPoints(const InputPointType *inputPoints,
+                               OutputPointType *outputPoints,
+                               SizeValueType numberOfPoints) const;
+
   /**  Method to transform a vector. */
   virtual OutputVectorType  TransformVector(const InputVectorType &) const
   {
@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkScaleTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include <vector>
+
+namespace
+{
+typedef itk::Transform<double, 3, 3> TransformType;
+typedef TransformType::InputPointType PointType;
+
+// TransformPoints() must give exactly the points of TransformPoint(),
+// in a separate array as well as in place.
+bool CheckTransformPoints( const TransformType * transform, const std::vector<PointType> & points )
+{
+  std::vector<PointType> transformed( points.size() );
+  transform->TransformPoints( &points[0], &transformed[0], points.size() );
+
+  std::vector<PointType> inPlace( points );
+  transform->TransformPoints( &inPlace[0], &inPlace[0], inPlace.size() );
+
+  for( size_t i = 0; i < points.size(); i++ )
+    {
+    const PointType expected = transform->TransformPoint( points[i] );
+    if( transformed[i] != expected || inPlace[i] != expected )
+      {
+      std::cerr << transform->GetNameOfClass() << ": " << points[i] << " transformed to "
+                << transformed[i] << " and " << inPlace[i] << " instead of " << expected << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkTransformPointsTest(int, char *[])
+{
+  // Points on a line of a grid, some of them outside the B-spline domain.
+  std::vector<PointType> points;
+  for( unsigned int i = 0; i < 40; i++ )
+    {
+    PointType point;
+    point[0] = -5.0 + 0.75 * i;
+    point[1] = 3.25;
+    point[2] = 7.0 - 0.1 * i;
+    points.push_back( point );
+    }
+
+  typedef itk::AffineTransform<double, 3> AffineTransformType;
+  AffineTransformType::Pointer affine = AffineTransformType::New();
+  AffineTransformType::OutputVectorType translation;
+  translation[0] = 1.5;
+  translation[1] = -2.0;
+  translation[2] = 0.25;
+  affine->Translate( translation );
+  affine->Rotate( 0, 2, 0.3 );
+  affine->Scale( 1.1 );
+  if( !CheckTransformPoints( affine, points ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  typedef itk::ScaleTransform<double, 3> ScaleTransformType;
+  ScaleTransformType::Pointer scale = ScaleTransformType::New();
+  ScaleTransformType::ScaleType factors;
+  factors[0] = 0.5;
+  factors[1] = 2.0;
+  factors[2] = 1.3;
+  scale->SetScale( factors );
+  ScaleTransformType::InputPointType center;
+  center.Fill( 1.0 );
+  scale->SetCenter( center );
+  if( !CheckTransformPoints( scale, points ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  typedef itk::BSplineTransform<double, 3, 3> BSplineTransformType;
+  BSplineTransformType::Pointer bspline = BSplineTransformType::New();
+  BSplineTransformType::OriginType origin;
+  origin.Fill( 0.0 );
+  BSplineTransformType::PhysicalDimensionsType dimensions;
+  dimensions.Fill( 20.0 );
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize.Fill( 4 );
+  bspline->SetTransformDomainOrigin( origin );
+  bspline->SetTransformDomainPhysicalDimensions( dimensions );
+  bspline->SetTransformDomainMeshSize( meshSize );
+  BSplineTransformType::ParametersType parameters( bspline->GetNumberOfParameters() );
+  for( unsigned int i = 0; i < parameters.size(); i++ )
+    {
+    parameters[i] = 0.01 * ( ( i * 37 ) % 101 ) - 0.5;
+    }
+  bspline->SetParameters( parameters );
+  if( !CheckTransformPoints( bspline, points ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  typedef itk::CompositeTransform<double, 3> CompositeTransformType;
+  CompositeTransformType::Pointer composite = CompositeTransformType::New();
+  composite->AddTransform( affine );
+  composite->AddTransform( bspline );
+  composite->AddTransform( scale );
+  if( !CheckTransformPoints( composite, points ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 #define __itkNormalizedCorrelationImageFilter_h
 
 #include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkSummedAreaTable.h"
 
 namespace itk
 {
@@ -34,6 +35,10 @@ namespace itk
  * and a mask, the normalized correlation is only calculated at those
  * pixels under the mask.
  *
+ * With UseSummedAreaTable on, the norms of the neighborhoods are read
+ * from summed area tables, which halves the work per pixel.  This only
+ * applies with the default ZeroFluxNeumannBoundaryCondition.
+ *
  * \ingroup ImageFilters
  *
  * \sa Image
@@ -119,6 +124,15 @@ public:
     this->SetOperator(t);
   }
 
+  /** Set/Get whether the sums of the values and of their squares over
+   * the neighborhoods, which normalize the correlation, are read from
+   * summed area tables instead of being computed with the correlation.
+   * Only used with the default boundary condition.  Off by default.
+   * \sa SummedAreaTable */
+  itkSetMacro(UseSummedAreaTable, bool);
+  itkGetConstMacro(UseSummedAreaTable, bool);
+  itkBooleanMacro(UseSummedAreaTable);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro( SameDimensionCheck,
@@ -133,7 +147,7 @@ public:
   /** End concept checking */
 #endif
 protected:
-  NormalizedCorrelationImageFilter() {}
+  NormalizedCorrelationImageFilter():m_UseSummedAreaTable(false) {}
   virtual ~NormalizedCorrelationImageFilter() {}
 
   /** NormalizedCorrelationImageFilter needs to request enough of an
@@ -160,10 +174,27 @@ protected:
 
   /** Standard PrintSelf method */
   void PrintSelf(std::ostream & os, Indent indent) const
-  {  Superclass::PrintSelf(os, indent); }
+  {
+    Superclass::PrintSelf(os, indent);
+    os << indent << "UseSummedAreaTable: " << ( m_UseSummedAreaTable ? "On" : "Off" ) << std::endl;
+  }
 private:
   NormalizedCorrelationImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);                   //purposely not implemented
+
+  /** Norm of the neighborhood centered on the values, read from the
+   * summed area tables. */
+  class NormFunction
+  {
+public:
+    typedef SummedAreaTable< InputImageType > TableType;
+    typename TableType::RealType operator()(const typename TableType::BoxStatistics & box) const
+    {
+      return vcl_sqrt( box.GetVariance() * static_cast< typename TableType::RealType >( box.NumberOfPixels - 1 ) );
+    }
+  };
+
+  bool m_UseSummedAreaTable;
 };
 } // end namespace itk
 
@@ -156,9 +156,29 @@ NormalizedCorrelationImageFilter< TInputImage, TMaskImage, TOutputImage, TOperat
   faceList = faceCalculator( input, outputRegionForThread,
                              this->GetOperator().GetRadius() );
 
+  // With the summed area tables, the norms of the neighborhoods are
+  // computed first, and the loops below only correlate the template.
+  // The tables replicate the edge of the image, as the default boundary
+  // condition does.
+  typedef Image< OutputPixelRealType, ImageDimension > NormImageType;
+  typename NormImageType::Pointer norms;
+  const bool useSummedAreaTable = m_UseSummedAreaTable
+    && dynamic_cast< ZeroFluxNeumannBoundaryCondition< InputImageType > * >( this->GetBoundaryCondition() ) != NULL;
+
   // support progress methods/callbacks
   ProgressReporter progress( this, threadId,
-                             outputRegionForThread.GetNumberOfPixels() );
+                             outputRegionForThread.GetNumberOfPixels() * ( useSummedAreaTable ? 2 : 1 ) );
+
+  if ( useSummedAreaTable )
+    {
+    norms = NormImageType::New();
+    norms->SetRegions(outputRegionForThread);
+    norms->Allocate();
+    SummedAreaTable< InputImageType > table( input, normalizedTemplate.GetRadius() );
+    table.SetComputeSumOfSquares(true);
+    NormFunction function;
+    table.ComputeFromBoxes(norms.GetPointer(), outputRegionForThread, function, progress);
+    }
 
   // Process non-boundary region and each of the boundary faces.
   // These are N-d regions which border the edge of the buffer.
@@ -166,6 +186,7 @@ NormalizedCorrelationImageFilter< TInputImage, TMaskImage, TOutputImage, TOperat
   typename FaceListType::iterator fit;
   ImageRegionIterator< OutputImageType >    it;
   ImageRegionConstIterator< MaskImageType > mit;
+  ImageRegionConstIterator< NormImageType > nit;
   unsigned int                              i;
   unsigned int                              templateSize = normalizedTemplate.Size();
   OutputPixelRealType                       realTemplateSize;
@@ -184,6 +205,10 @@ NormalizedCorrelationImageFilter< TInputImage, TMaskImage, TOutputImage, TOperat
     bit.GoToBegin();
 
     it = ImageRegionIterator< OutputImageType >(output, *fit);
+    if ( norms )
+      {
+      nit = ImageRegionConstIterator< NormImageType >(norms, *fit);
+      }
 
     if ( !mask )
       {
@@ -195,20 +220,32 @@ NormalizedCorrelationImageFilter< TInputImage, TMaskImage, TOutputImage, TOperat
         // This simplifies the calculation to being just the correlation
         // of the image neighborhod with the template, normalized by a
         // function of the image neighborhood.
-        sum = 0.0;
-        sumOfSquares = 0.0;
         numerator = 0.0;
-        for ( i = 0; i < templateSize; ++i )
+        if ( norms )
           {
-          value = static_cast< OutputPixelRealType >( bit.GetPixel(i) );
+          for ( i = 0; i < templateSize; ++i )
+            {
+            numerator += static_cast< OutputPixelRealType >( bit.GetPixel(i) ) * normalizedTemplate[i];
+            }
+          denominator = nit.Get();
+          ++nit;
+          }
+        else
+          {
+          sum = 0.0;
+          sumOfSquares = 0.0;
+          for ( i = 0; i < templateSize; ++i )
+            {
+            value = static_cast< OutputPixelRealType >( bit.GetPixel(i) );
 
-          numerator += ( value * normalizedTemplate[i] );
+            numerator += ( value * normalizedTemplate[i] );
 
-          // tally values for normalizing the result
-          sum += value;
-          sumOfSquares += ( value * value );
+            // tally values for normalizing the result
+            sum += value;
+            sumOfSquares += ( value * value );
+            }
+          denominator = vcl_sqrt( sumOfSquares - ( sum * sum / realTemplateSize ) );
           }
-        denominator = vcl_sqrt( sumOfSquares - ( sum * sum / realTemplateSize ) );
 
         it.Value() = numerator / denominator;
 
@@ -231,20 +268,31 @@ NormalizedCorrelationImageFilter< TInputImage, TMaskImage, TOutputImage, TOperat
           // This simplifies the calculation to being just the correlation
           // of the image neighborhod with the template, normalized by a
           // function of the image neighborhood.
-          sum = 0.0;
-          sumOfSquares = 0.0;
           numerator = 0.0;
-          for ( i = 0; i < templateSize; ++i )
+          if ( norms )
             {
-            value = static_cast< OutputPixelRealType >( bit.GetPixel(i) );
-
-            numerator += ( value * normalizedTemplate[i] );
-
-            // tally values for normalizing the result
-            sum += value;
-            sumOfSquares += ( value * value );
+            for ( i = 0; i < templateSize; ++i )
+              {
+              numerator += static_cast< OutputPixelRealType >( bit.GetPixel(i) ) * normalizedTemplate[i];
+              }
+            denominator = nit.Get();
+            }
+          else
+            {
+            sum = 0.0;
+            sumOfSquares = 0.0;
+            for ( i = 0; i < templateSize; ++i )
+              {
+              value = static_cast< OutputPixelRealType >( bit.GetPixel(i) );
+
+              numerator += ( value * normalizedTemplate[i] );
+
+              // tally values for normalizing the result
+              sum += value;
+              sumOfSquares += ( value * value );
+              }
+            denominator = vcl_sqrt( sumOfSquares - ( sum * sum / realTemplateSize ) );
             }
-          denominator = vcl_sqrt( sumOfSquares - ( sum * sum / realTemplateSize ) );
 
           it.Value() = numerator / denominator;
           }
@@ -253,6 +301,10 @@ NormalizedCorrelationImageFilter< TInputImage, TMaskImage, TOutputImage, TOperat
           // Not under the mask.  Set the normalized correlation to zero.
           it.Value() = zero;
           }
+        if ( norms )
+          {
+          ++nit;
+          }
         ++bit;
         ++it;
         ++mit;
@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNormalizedCorrelationImageFilter.h"
+#include "itkAnnulusOperator.h"
+#include "itkImageRegionIterator.h"
+
+int itkNormalizedCorrelationImageFilterSummedAreaTableTest(int, char* [] )
+{
+  const unsigned int Dimension = 2;
+  typedef unsigned char PixelType;
+  typedef float         CorrelationPixelType;
+
+  typedef itk::Image<PixelType, Dimension>            InputImageType;
+  typedef itk::Image<CorrelationPixelType, Dimension> CorrelationImageType;
+
+  // a textured image, with a masked disk
+  InputImageType::RegionType region;
+  region.SetSize(0, 61);
+  region.SetSize(1, 47);
+  InputImageType::Pointer input = InputImageType::New();
+  input->SetRegions(region);
+  input->Allocate();
+  InputImageType::Pointer mask = InputImageType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+
+  unsigned int seed = 12345;
+  itk::ImageRegionIterator<InputImageType> iit(input, region);
+  itk::ImageRegionIterator<InputImageType> mit(mask, region);
+  for (; !iit.IsAtEnd(); ++iit, ++mit)
+    {
+    seed = seed * 1103515245u + 12345u;
+    const InputImageType::IndexType index = iit.GetIndex();
+    iit.Set( static_cast<PixelType>( ( index[0] * 7 + index[1] * 3 ) % 64 + ( ( seed >> 16 ) % 128 ) ) );
+    const long dx = index[0] - 30;
+    const long dy = index[1] - 23;
+    mit.Set( dx * dx + dy * dy < 400 ? 1 : 0 );
+    }
+
+  typedef itk::AnnulusOperator<CorrelationPixelType, Dimension> AnnulusType;
+  AnnulusType annulus;
+  annulus.SetInnerRadius( 3 );
+  annulus.SetThickness( 2 );
+  annulus.NormalizeOn();
+  annulus.BrightCenterOn();
+  annulus.CreateOperator();
+
+  typedef itk::NormalizedCorrelationImageFilter<InputImageType, InputImageType, CorrelationImageType> FilterType;
+
+  // The correlations normalized with the summed area tables must match
+  // the ones normalized with the neighborhoods, with and without mask.
+  for ( unsigned int useMask = 0; useMask < 2; ++useMask )
+    {
+    FilterType::Pointer filter = FilterType::New();
+    filter->SetInput( input );
+    filter->SetTemplate( annulus );
+    FilterType::Pointer tableFilter = FilterType::New();
+    tableFilter->SetInput( input );
+    tableFilter->SetTemplate( annulus );
+    tableFilter->UseSummedAreaTableOn();
+    if ( useMask )
+      {
+      filter->SetMaskImage( mask );
+      tableFilter->SetMaskImage( mask );
+      }
+    filter->Update();
+    tableFilter->Update();
+    std::cout << tableFilter << std::endl;
+
+    itk::ImageRegionIterator<CorrelationImageType> it(filter->GetOutput(), region);
+    itk::ImageRegionIterator<CorrelationImageType> tit(tableFilter->GetOutput(), region);
+    for (; !it.IsAtEnd(); ++it, ++tit)
+      {
+      if ( vnl_math_abs( it.Get() - tit.Get() ) > 1e-4 )
+        {
+        std::cerr << "Correlation at " << it.GetIndex() << " is " << tit.Get()
+                  << " with the summed area tables instead of " << it.Get()
+                  << ( useMask ? " with mask" : "" ) << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
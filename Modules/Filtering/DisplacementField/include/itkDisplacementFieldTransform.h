@@ -209,6 +209,12 @@ public:
   virtual OutputPointType TransformPoint( const InputPointType& thisPoint )
   const;
 
+  /** Method to transform an array of points.  The displacement field and
+   * the interpolator are checked once for all the points, and the
+   * continuous index of each point is computed once instead of twice. */
+  virtual void TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+                                SizeValueType numberOfPoints ) const;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   virtual OutputVectorType TransformVector(const InputVectorType &) const
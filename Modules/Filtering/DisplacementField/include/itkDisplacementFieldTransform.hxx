@@ -114,6 +114,46 @@ DisplacementFieldTransform<TScalar, NDimensions>
   return outputPoint;
 }
 
+/**
+ * Transform an array of points
+ */
+template <class TScalar, unsigned int NDimensions>
+void
+DisplacementFieldTransform<TScalar, NDimensions>
+::TransformPoints( const InputPointType *inputPoints, OutputPointType *outputPoints,
+                   SizeValueType numberOfPoints ) const
+{
+  if( !this->m_DisplacementField )
+    {
+    itkExceptionMacro( "No displacement field is specified." );
+    }
+  if( !this->m_Interpolator )
+    {
+    itkExceptionMacro( "No interpolator is specified." );
+    }
+
+  typename InterpolatorType::ContinuousIndexType cidx;
+  typename InterpolatorType::PointType point;
+  OutputPointType outputPoint;
+
+  for( SizeValueType i = 0; i < numberOfPoints; ++i )
+    {
+    point.CastFrom( inputPoints[i] );
+    outputPoint.CastFrom( inputPoints[i] );
+
+    // The interpolator reads the displacement field, so that the index
+    // it would compute to check the buffer is the one used to evaluate.
+    this->m_DisplacementField->TransformPhysicalPointToContinuousIndex( point, cidx );
+    if( this->m_Interpolator->IsInsideBuffer( cidx ) )
+      {
+      typename InterpolatorType::OutputType displacement =
+        this->m_Interpolator->EvaluateAtContinuousIndex( cidx );
+      outputPoint += displacement;
+      }
+    outputPoints[i] = outputPoint;
+    }
+}
+
 /**
  * return an inverse transformation
  */
@@ -20,6 +20,8 @@
 
 #include "itkInPlaceImageFilter.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkFunctorFusionStage.h"
+#include "itkFunctorSpanEvaluator.h"
 
 namespace itk
 {
@@ -36,6 +38,16 @@ namespace itk
  * the pipeline. The SetConstant() and GetConstant() methods are provided as shortcuts
  * to set or get the constant value without manipulating the decorator.
  *
+ * When the inputs and the output are itk::Image of the same dimension, the
+ * functor is applied to the spans of pixels that are contiguous in all the
+ * buffers (see ImageRegionSpanIterator) in plain loops over the pixel
+ * buffers, which the compiler can vectorize.  A functor may also provide
+ * a batch operator() processing a whole span, see
+ * BinaryFunctorSpanEvaluator.
+ *
+ * The filter implements FunctorFusionStage, so it can be part of a chain
+ * executed in a single pass by FunctorFusionImageFilter.
+ *
  * \sa UnaryFunctorImageFilter TernaryFunctorImageFilter
  *
  * \ingroup IntensityImageFilters   MultiThreaded
@@ -49,7 +61,8 @@ namespace itk
 template< class TInputImage1, class TInputImage2,
           class TOutputImage, class TFunction    >
 class ITK_EXPORT BinaryFunctorImageFilter:
-  public InPlaceImageFilter< TInputImage1, TOutputImage >
+  public InPlaceImageFilter< TInputImage1, TOutputImage >,
+  public FunctorFusionStage< TOutputImage::ImageDimension >
 {
 public:
   /** Standard class typedefs. */
@@ -149,6 +162,26 @@ public:
       }
   }
 
+  /** FunctorFusionStage interface. */
+  typedef FunctorFusionStage< TOutputImage::ImageDimension > FusionStageType;
+  typedef typename FusionStageType::FusionIndexType          FusionIndexType;
+
+  virtual bool CanFuse() const;
+
+  virtual unsigned int GetNumberOfFusionInputs() const;
+
+  virtual const DataObject * GetFusionInput(unsigned int input) const;
+
+  virtual void BeforeFusedGenerateData();
+
+  virtual const void * GetFusionInputLine(unsigned int input, const FusionIndexType & index) const;
+
+  virtual void * AllocateFusionLine(SizeValueType length) const;
+
+  virtual void ReleaseFusionLine(void *line) const;
+
+  virtual void EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length);
+
   /** ImageDimension constants */
   itkStaticConstMacro(
     InputImage1Dimension, unsigned int, TInputImage1::ImageDimension);
@@ -192,6 +225,27 @@ private:
   BinaryFunctorImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);           //purposely not implemented
 
+  /** Whether the pixels of the inputs and of the output are stored in the
+   * buffers of itk::Image of the same dimension. */
+  typedef BoolType< IsSame< TInputImage1, Image< Input1ImagePixelType, TInputImage1::ImageDimension > >::Value
+                    && IsSame< TInputImage2, Image< Input2ImagePixelType, TInputImage2::ImageDimension > >::Value
+                    && IsSame< TOutputImage, Image< OutputImagePixelType, TOutputImage::ImageDimension > >::Value
+                    && static_cast< unsigned int >( TInputImage1::ImageDimension )
+                    == static_cast< unsigned int >( TOutputImage::ImageDimension )
+                    && static_cast< unsigned int >( TInputImage2::ImageDimension )
+                    == static_cast< unsigned int >( TOutputImage::ImageDimension ) > HasContiguousPixelsType;
+
+  typedef BinaryFunctorSpanEvaluator< FunctorType, Input1ImagePixelType, Input2ImagePixelType,
+                                      OutputImagePixelType > SpanEvaluatorType;
+
+  /** Apply the functor to the spans of contiguous pixels of the region. */
+  void DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                      ThreadIdType threadId, const TrueType &);
+
+  /** Apply the functor to the pixels of the region with image iterators. */
+  void DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                      ThreadIdType threadId, const FalseType &);
+
   FunctorType m_Functor;
 };
 } // end namespace itk
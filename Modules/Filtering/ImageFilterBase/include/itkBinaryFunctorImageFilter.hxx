@@ -20,6 +20,7 @@
 
 #include "itkBinaryFunctorImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSpanIterator.h"
 #include "itkProgressReporter.h"
 
 namespace itk
@@ -204,6 +205,69 @@ void
 BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
+{
+  this->DispatchedThreadedGenerateData( outputRegionForThread, threadId, HasContiguousPixelsType() );
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+void
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                 ThreadIdType threadId, const TrueType &)
+{
+  const TInputImage1 *inputPtr1 = dynamic_cast< const TInputImage1 * >( ProcessObject::GetInput(0) );
+  const TInputImage2 *inputPtr2 = dynamic_cast< const TInputImage2 * >( ProcessObject::GetInput(1) );
+  TOutputImage *      outputPtr = this->GetOutput(0);
+
+  if ( !inputPtr1 && !inputPtr2 )
+    {
+    itkGenericExceptionMacro(<<"At most one of the inputs can be a constant.");
+    }
+
+  ImageRegionSpanIterator< OutputImageDimension > sit(outputRegionForThread);
+  if ( inputPtr1 )
+    {
+    sit.AddBufferedRegion( inputPtr1->GetBufferedRegion() );
+    }
+  if ( inputPtr2 )
+    {
+    sit.AddBufferedRegion( inputPtr2->GetBufferedRegion() );
+    }
+  sit.AddBufferedRegion( outputPtr->GetBufferedRegion() );
+
+  ProgressReporter progress( this, threadId, sit.GetNumberOfSpans() );
+
+  for ( sit.GoToBegin(); !sit.IsAtEnd(); ++sit )
+    {
+    OutputImagePixelType *output = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset( sit.GetIndex() );
+    if ( inputPtr1 && inputPtr2 )
+      {
+      SpanEvaluatorType::Evaluate( m_Functor,
+                                   inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset( sit.GetIndex() ),
+                                   inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset( sit.GetIndex() ),
+                                   output, sit.GetSpanLength() );
+      }
+    else if ( inputPtr1 )
+      {
+      SpanEvaluatorType::EvaluateWithConstant2( m_Functor,
+                                                inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset( sit.GetIndex() ),
+                                                this->GetConstant2(), output, sit.GetSpanLength() );
+      }
+    else
+      {
+      SpanEvaluatorType::EvaluateWithConstant1( m_Functor, this->GetConstant1(),
+                                                inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset( sit.GetIndex() ),
+                                                output, sit.GetSpanLength() );
+      }
+    progress.CompletedPixel(); // potential exception thrown here
+    }
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+void
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::DispatchedThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                 ThreadIdType threadId, const FalseType &)
 {
   // We use dynamic_cast since inputs are stored as DataObjects.  The
   // ImageToImageFilter::GetInput(int) always returns a pointer to a
@@ -277,6 +341,120 @@ BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
     itkGenericExceptionMacro(<<"At most one of the inputs can be a constant.");
     }
 }
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+bool
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::CanFuse() const
+{
+  return this->GetNumberOfFusionInputs() > 0
+         && typeid( TInputImage1 ) == typeid( Image< Input1ImagePixelType, InputImage1Dimension > )
+         && typeid( TInputImage2 ) == typeid( Image< Input2ImagePixelType, InputImage2Dimension > )
+         && typeid( TOutputImage ) == typeid( Image< OutputImagePixelType, OutputImageDimension > )
+         && InputImage1Dimension == OutputImageDimension
+         && InputImage2Dimension == OutputImageDimension;
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+unsigned int
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::GetNumberOfFusionInputs() const
+{
+  unsigned int numberOfImages = 0;
+
+  if ( dynamic_cast< const TInputImage1 * >( ProcessObject::GetInput(0) ) )
+    {
+    ++numberOfImages;
+    }
+  if ( dynamic_cast< const TInputImage2 * >( ProcessObject::GetInput(1) ) )
+    {
+    ++numberOfImages;
+    }
+  return numberOfImages;
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+const DataObject *
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::GetFusionInput(unsigned int input) const
+{
+  // The image inputs are numbered after skipping a constant first operand.
+  if ( input == 0 && dynamic_cast< const TInputImage1 * >( ProcessObject::GetInput(0) ) )
+    {
+    return ProcessObject::GetInput(0);
+    }
+  return ProcessObject::GetInput(1);
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+void
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::BeforeFusedGenerateData()
+{
+  this->BeforeThreadedGenerateData();
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+const void *
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::GetFusionInputLine(unsigned int input, const FusionIndexType & index) const
+{
+  const DataObject *fusionInput = this->GetFusionInput(input);
+
+  if ( fusionInput == ProcessObject::GetInput(0) )
+    {
+    const TInputImage1 *inputPtr1 = static_cast< const TInputImage1 * >( fusionInput );
+    return inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+    }
+  const TInputImage2 *inputPtr2 = static_cast< const TInputImage2 * >( fusionInput );
+  return inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+void *
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::AllocateFusionLine(SizeValueType length) const
+{
+  return new OutputImagePixelType[length];
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+void
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::ReleaseFusionLine(void *line) const
+{
+  delete[] static_cast< OutputImagePixelType * >( line );
+}
+
+template< class TInputImage1, class TInputImage2, class TOutputImage, class TFunction  >
+void
+BinaryFunctorImageFilter< TInputImage1, TInputImage2, TOutputImage, TFunction >
+::EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length)
+{
+  OutputImagePixelType *outputLine = static_cast< OutputImagePixelType * >( output );
+
+  const bool input1IsImage = dynamic_cast< const TInputImage1 * >( ProcessObject::GetInput(0) ) != NULL;
+  const bool input2IsImage = dynamic_cast< const TInputImage2 * >( ProcessObject::GetInput(1) ) != NULL;
+
+  if ( input1IsImage && input2IsImage )
+    {
+    const Input1ImagePixelType *inputLine1 = static_cast< const Input1ImagePixelType * >( inputs[0] );
+    const Input2ImagePixelType *inputLine2 = static_cast< const Input2ImagePixelType * >( inputs[1] );
+    SpanEvaluatorType::Evaluate(m_Functor, inputLine1, inputLine2, outputLine, length);
+    }
+  else if ( input1IsImage )
+    {
+    const Input1ImagePixelType *inputLine1 = static_cast< const Input1ImagePixelType * >( inputs[0] );
+    const Input2ImagePixelType &input2Value = this->GetConstant2();
+    SpanEvaluatorType::EvaluateWithConstant2(m_Functor, inputLine1, input2Value, outputLine, length);
+    }
+  else
+    {
+    const Input1ImagePixelType &input1Value = this->GetConstant1();
+    const Input2ImagePixelType *inputLine2 = static_cast< const Input2ImagePixelType * >( inputs[0] );
+    SpanEvaluatorType::EvaluateWithConstant1(m_Functor, input1Value, inputLine2, outputLine, length);
+    }
+}
 } // end namespace itk
 
 #endif
@@ -124,7 +124,7 @@ protected:
 
   void GenerateData()
   {
-    if ( this->GetInPlace() && this->CanRunInPlace() )
+    if ( this->WillRunInPlace() )
       {
       // nothing to do, so avoid iterating over all the pixels
       // for nothing! Allocate the output, generate a fake progress and exit
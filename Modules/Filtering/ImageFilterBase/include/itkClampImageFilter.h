@@ -130,7 +130,7 @@ protected:
 
   void GenerateData()
     {
-    if( this->GetInPlace() && this->CanRunInPlace() )
+    if( this->WillRunInPlace() )
       {
       // Nothing to do, so avoid iterating over all the pixels for
       // nothing! Allocate the output, generate a fake progress and exit.
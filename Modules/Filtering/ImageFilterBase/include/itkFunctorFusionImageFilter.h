@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkFunctorFusionImageFilter_h
+#define __itkFunctorFusionImageFilter_h
+
+#include "itkImageSource.h"
+#include "itkFunctorFusionStage.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class FunctorFusionImageFilter
+ * \brief Execute a chain of pixel-wise functor filters in a single pass.
+ *
+ * A preprocessing chain such as Cast, Clamp, Mask and BinaryThreshold
+ * normally allocates a full intermediate image for every filter and
+ * streams through memory once per filter.  This filter takes the output
+ * of the last filter of such a chain, with SetChainOutput(), and produces
+ * the same image without running the chain: the functors of all the
+ * consecutive Unary, Binary, Ternary and Nary functor filters upstream
+ * of that output are applied one image line at a time, and only a line
+ * of pixels per fused filter and per thread is kept as temporary storage.
+ *
+ * The chain stops at the first filter that is not a FunctorFusionStage,
+ * or whose CanFuse() method returns false, e.g. RescaleIntensityImageFilter
+ * which needs its whole input to set up its functor.  The images at the
+ * boundary of the chain become the inputs of this filter and are updated
+ * by the usual pipeline mechanism, so only the fused filters are skipped.
+ * Filters of the chain must not be modified while this filter executes.
+ *
+ * The intermediate outputs of the chain are left untouched.  A fused
+ * filter whose output is also used by another filter is executed again
+ * when that other filter updates.
+ *
+ * \sa FunctorFusionStage UnaryFunctorImageFilter BinaryFunctorImageFilter
+ * \sa TernaryFunctorImageFilter NaryFunctorImageFilter
+ *
+ * \ingroup IntensityImageFilters MultiThreaded
+ * \ingroup ITKImageFilterBase
+ */
+template< class TOutputImage >
+class ITK_EXPORT FunctorFusionImageFilter:
+  public ImageSource< TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef FunctorFusionImageFilter    Self;
+  typedef ImageSource< TOutputImage > Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FunctorFusionImageFilter, ImageSource);
+
+  /** Image dimension. */
+  itkStaticConstMacro(ImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+  /** Some convenient typedefs. */
+  typedef TOutputImage                           OutputImageType;
+  typedef typename OutputImageType::ConstPointer OutputImageConstPointer;
+  typedef typename OutputImageType::RegionType   OutputImageRegionType;
+  typedef typename OutputImageType::PixelType    OutputImagePixelType;
+  typedef typename OutputImageType::IndexType    IndexType;
+
+  typedef FunctorFusionStage< TOutputImage::ImageDimension > FusionStageType;
+
+  /** Set/Get the output of the last filter of the chain to execute. */
+  void SetChainOutput(const OutputImageType *chainOutput);
+  const OutputImageType * GetChainOutput() const;
+
+  /** Number of filters of the chain that were fused by the last call to
+   * UpdateOutputInformation(). */
+  unsigned int GetNumberOfFusedFilters() const
+  {
+    return static_cast< unsigned int >( m_Nodes.size() );
+  }
+
+  /** Collect the filters of the chain before propagating the output
+   * information, so that the pipeline only updates the inputs of the
+   * chain. */
+  virtual void UpdateOutputInformation();
+
+protected:
+  FunctorFusionImageFilter();
+  virtual ~FunctorFusionImageFilter();
+
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+  /** The output has the information of the chain output. */
+  virtual void GenerateOutputInformation();
+
+  /** The pixel-wise filters need the output requested region of their
+   * inputs. */
+  virtual void GenerateInputRequestedRegion();
+
+  virtual void BeforeThreadedGenerateData();
+
+  virtual void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                    ThreadIdType threadId);
+
+  virtual void AfterThreadedGenerateData();
+
+private:
+  FunctorFusionImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);           //purposely not implemented
+
+  /** Where a fused filter reads one of its inputs: either the line
+   * produced by another fused filter, or the buffer of an input of this
+   * filter. */
+  struct FusionNodeInput {
+    bool IsNode;
+    unsigned int Index;
+  };
+
+  /** A fused filter.  The nodes are stored so that a filter comes after
+   * all the fused filters it reads from; the last one produces the output. */
+  struct FusionNode {
+    ProcessObject::Pointer         Filter;
+    FusionStageType *              Stage;
+    std::vector< FusionNodeInput > Inputs;
+  };
+
+  /** Add the node of filter, and recursively of the fused filters
+   * upstream of it, and return its index in m_Nodes.  The images read by
+   * the chain are collected in inputs. */
+  unsigned int AddFusionNode(ProcessObject *filter, std::vector< const DataObject * > & inputs);
+
+  /** Release the line buffers of all the threads. */
+  void ReleaseFusionLines();
+
+  OutputImageConstPointer m_ChainOutput;
+
+  std::vector< FusionNode > m_Nodes;
+
+  /** One line buffer per thread and per node, except for the last node
+   * which writes to the output image. */
+  std::vector< std::vector< void * > > m_FusionLines;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFunctorFusionImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,319 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkFunctorFusionImageFilter_hxx
+#define __itkFunctorFusionImageFilter_hxx
+
+#include "itkFunctorFusionImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace itk
+{
+template< class TOutputImage >
+FunctorFusionImageFilter< TOutputImage >
+::FunctorFusionImageFilter()
+{}
+
+template< class TOutputImage >
+FunctorFusionImageFilter< TOutputImage >
+::~FunctorFusionImageFilter()
+{
+  this->ReleaseFusionLines();
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::SetChainOutput(const OutputImageType *chainOutput)
+{
+  if ( m_ChainOutput != chainOutput )
+    {
+    m_ChainOutput = chainOutput;
+    this->Modified();
+    }
+}
+
+template< class TOutputImage >
+const typename FunctorFusionImageFilter< TOutputImage >::OutputImageType *
+FunctorFusionImageFilter< TOutputImage >
+::GetChainOutput() const
+{
+  return m_ChainOutput.GetPointer();
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::UpdateOutputInformation()
+{
+  if ( m_ChainOutput.IsNull() )
+    {
+    itkExceptionMacro(<< "ChainOutput is not set");
+    }
+
+  // Let the chain compute its output information, so that the fused
+  // filters know their inputs, then take its pipeline modification time
+  // into account since the chain is not an input of this filter.
+  const_cast< OutputImageType * >( m_ChainOutput.GetPointer() )->UpdateOutputInformation();
+  if ( m_ChainOutput->GetPipelineMTime() > this->GetMTime()
+       || m_ChainOutput->GetMTime() > this->GetMTime() )
+    {
+    this->Modified();
+    }
+
+  this->ReleaseFusionLines();
+  m_Nodes.clear();
+
+  ProcessObject *tail = m_ChainOutput->GetSource();
+  FusionStageType *tailStage = dynamic_cast< FusionStageType * >( tail );
+  if ( tailStage == NULL || !tailStage->CanFuse() )
+    {
+    itkExceptionMacro(<< "ChainOutput is not produced by a functor filter that can be fused");
+    }
+
+  std::vector< const DataObject * > inputs;
+  this->AddFusionNode(tail, inputs);
+
+  // The images read by the chain replace the previous inputs.
+  for ( unsigned int i = 0; i < inputs.size(); ++i )
+    {
+    this->SetNthInput( i, const_cast< DataObject * >( inputs[i] ) );
+    }
+  this->SetNumberOfIndexedInputs( inputs.size() );
+
+  Superclass::UpdateOutputInformation();
+}
+
+template< class TOutputImage >
+unsigned int
+FunctorFusionImageFilter< TOutputImage >
+::AddFusionNode(ProcessObject *filter, std::vector< const DataObject * > & inputs)
+{
+  // A filter feeding several fused filters is evaluated only once.
+  for ( unsigned int n = 0; n < m_Nodes.size(); ++n )
+    {
+    if ( m_Nodes[n].Filter == filter )
+      {
+      return n;
+      }
+    }
+
+  FusionNode node;
+  node.Filter = filter;
+  node.Stage = dynamic_cast< FusionStageType * >( filter );
+
+  const unsigned int numberOfInputs = node.Stage->GetNumberOfFusionInputs();
+  node.Inputs.resize(numberOfInputs);
+  for ( unsigned int i = 0; i < numberOfInputs; ++i )
+    {
+    const DataObject *input = node.Stage->GetFusionInput(i);
+    ProcessObject *   source = input->GetSource();
+    FusionStageType * sourceStage = dynamic_cast< FusionStageType * >( source );
+
+    if ( sourceStage && sourceStage->CanFuse() )
+      {
+      node.Inputs[i].IsNode = true;
+      node.Inputs[i].Index = this->AddFusionNode(source, inputs);
+      }
+    else
+      {
+      unsigned int inputIndex = 0;
+      while ( inputIndex < inputs.size() && inputs[inputIndex] != input )
+        {
+        ++inputIndex;
+        }
+      if ( inputIndex == inputs.size() )
+        {
+        inputs.push_back(input);
+        }
+      node.Inputs[i].IsNode = false;
+      node.Inputs[i].Index = inputIndex;
+      }
+    }
+
+  m_Nodes.push_back(node);
+  return static_cast< unsigned int >( m_Nodes.size() - 1 );
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::GenerateOutputInformation()
+{
+  this->GetOutput()->CopyInformation(m_ChainOutput);
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::GenerateInputRequestedRegion()
+{
+  const OutputImageRegionType & requestedRegion = this->GetOutput()->GetRequestedRegion();
+
+  for ( unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i )
+    {
+    ImageBase< ImageDimension > *input =
+      dynamic_cast< ImageBase< ImageDimension > * >( this->ProcessObject::GetInput(i) );
+    if ( input )
+      {
+      input->SetRequestedRegion(requestedRegion);
+      }
+    }
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::BeforeThreadedGenerateData()
+{
+  for ( unsigned int n = 0; n < m_Nodes.size(); ++n )
+    {
+    m_Nodes[n].Stage->BeforeFusedGenerateData();
+    }
+
+  this->ReleaseFusionLines();
+
+  const SizeValueType lineLength = this->GetOutput()->GetRequestedRegion().GetSize(0);
+  m_FusionLines.resize( this->GetNumberOfThreads() );
+  for ( unsigned int t = 0; t < m_FusionLines.size(); ++t )
+    {
+    m_FusionLines[t].resize(m_Nodes.size(), NULL);
+    for ( unsigned int n = 0; n + 1 < m_Nodes.size(); ++n )
+      {
+      m_FusionLines[t][n] = m_Nodes[n].Stage->AllocateFusionLine(lineLength);
+      }
+    }
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                       ThreadIdType threadId)
+{
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+
+  if ( lineLength == 0 )
+    {
+    return;
+    }
+
+  OutputImageType *           outputPtr = this->GetOutput();
+  std::vector< void * > &     lines = m_FusionLines[threadId];
+  std::vector< const void * > inputLines;
+  const unsigned int          numberOfNodes = static_cast< unsigned int >( m_Nodes.size() );
+
+  const IndexType & startIndex = outputRegionForThread.GetIndex();
+  IndexType         index = startIndex;
+
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() / lineLength );
+
+  while ( true )
+    {
+    for ( unsigned int n = 0; n < numberOfNodes; ++n )
+      {
+      FusionNode & node = m_Nodes[n];
+
+      inputLines.resize( node.Inputs.size() );
+      for ( unsigned int i = 0; i < node.Inputs.size(); ++i )
+        {
+        if ( node.Inputs[i].IsNode )
+          {
+          inputLines[i] = lines[node.Inputs[i].Index];
+          }
+        else
+          {
+          inputLines[i] = node.Stage->GetFusionInputLine(i, index);
+          }
+        }
+
+      void *outputLine;
+      if ( n + 1 < numberOfNodes )
+        {
+        outputLine = lines[n];
+        }
+      else
+        {
+        outputLine = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+        }
+
+      node.Stage->EvaluateFusionLine(inputLines.empty() ? NULL : &inputLines[0], outputLine, lineLength);
+      }
+    progress.CompletedPixel(); // potential exception thrown here
+
+    // Move to the next line of the region.
+    unsigned int dim = 1;
+    for (; dim < ImageDimension; ++dim )
+      {
+      ++index[dim];
+      if ( index[dim] < startIndex[dim] + static_cast< IndexValueType >( outputRegionForThread.GetSize(dim) ) )
+        {
+        break;
+        }
+      index[dim] = startIndex[dim];
+      }
+    if ( dim >= ImageDimension )
+      {
+      break;
+      }
+    }
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::AfterThreadedGenerateData()
+{
+  this->ReleaseFusionLines();
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::ReleaseFusionLines()
+{
+  for ( unsigned int t = 0; t < m_FusionLines.size(); ++t )
+    {
+    for ( unsigned int n = 0; n < m_FusionLines[t].size(); ++n )
+      {
+      if ( m_FusionLines[t][n] )
+        {
+        m_Nodes[n].Stage->ReleaseFusionLine(m_FusionLines[t][n]);
+        }
+      }
+    }
+  m_FusionLines.clear();
+}
+
+template< class TOutputImage >
+void
+FunctorFusionImageFilter< TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ChainOutput: " << m_ChainOutput.GetPointer() << std::endl;
+  os << indent << "NumberOfFusedFilters: " << m_Nodes.size() << std::endl;
+  for ( unsigned int n = 0; n < m_Nodes.size(); ++n )
+    {
+    os << indent.GetNextIndent() << m_Nodes[n].Filter->GetNameOfClass()
+       << " (" << m_Nodes[n].Filter.GetPointer() << ")" << std::endl;
+    }
+}
+} // end namespace itk
+
+#endif
@@ -19,6 +19,7 @@
 #define __itkNoiseImageFilter_h
 
 #include "itkBoxImageFilter.h"
+#include "itkSummedAreaTable.h"
 #include "itkImage.h"
 #include "itkNumericTraits.h"
 
@@ -84,6 +85,16 @@ public:
 
   typedef typename InputImageType::SizeType InputSizeType;
 
+  /** Set/Get whether the sums over the neighborhoods are read from
+   * summed area tables, in constant time per pixel whatever the radius,
+   * instead of being updated as the neighborhood slides along the lines
+   * of the image.  The tables are the faster for the larger radii.  Off by
+   * default.
+   * \sa SummedAreaTable */
+  itkSetMacro(UseSummedAreaTable, bool);
+  itkGetConstMacro(UseSummedAreaTable, bool);
+  itkBooleanMacro(UseSummedAreaTable);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro( InputHasNumericTraitsCheck,
@@ -93,6 +104,7 @@ public:
 protected:
   NoiseImageFilter();
   virtual ~NoiseImageFilter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
 
   /** NoiseImageFilter can be implemented as a multithreaded filter.
    * Therefore, this implementation provides a ThreadedGenerateData()
@@ -110,6 +122,55 @@ protected:
 private:
   NoiseImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);   //purposely not implemented
+
+  /** Running sums of the pixels and of their squares over the
+   * neighborhood. */
+  class MomentsAccumulator
+  {
+public:
+    MomentsAccumulator(SizeValueType numberOfPixels):
+      m_NumberOfPixels( static_cast< InputRealType >( numberOfPixels ) ) {}
+    void Reset()
+    {
+      m_Sum = NumericTraits< InputRealType >::Zero;
+      m_SumOfSquares = NumericTraits< InputRealType >::Zero;
+    }
+    void Add(const InputPixelType & pixel)
+    {
+      const InputRealType value = static_cast< InputRealType >( pixel );
+      m_Sum += value;
+      m_SumOfSquares += value * value;
+    }
+    void Remove(const InputPixelType & pixel)
+    {
+      const InputRealType value = static_cast< InputRealType >( pixel );
+      m_Sum -= value;
+      m_SumOfSquares -= value * value;
+    }
+    /** Standard deviation.  Rounding errors of the running sums cannot
+     * make the variance of a constant neighborhood negative. */
+    InputRealType GetValue(const InputPixelType &) const
+    {
+      const InputRealType var = ( m_SumOfSquares - ( m_Sum * m_Sum / m_NumberOfPixels ) )
+                                / ( m_NumberOfPixels - 1.0 );
+      return var > NumericTraits< InputRealType >::Zero ? vcl_sqrt(var) : NumericTraits< InputRealType >::Zero;
+    }
+
+private:
+    InputRealType m_Sum;
+    InputRealType m_SumOfSquares;
+    InputRealType m_NumberOfPixels;
+  };
+
+  /** Standard deviation of the box read from the summed area tables. */
+  class SigmaFunction
+  {
+public:
+    InputRealType operator()(const typename SummedAreaTable< InputImageType >::BoxStatistics & box) const
+    { return box.GetSigma(); }
+  };
+
+  bool m_UseSummedAreaTable;
 };
 } // end namespace itk
 
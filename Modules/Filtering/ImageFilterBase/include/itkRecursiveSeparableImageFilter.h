@@ -43,6 +43,13 @@ namespace itk
  * G. Farneback & C.-F. Westin, "On Implementation of Recursive Gaussian
  * Filters", so far unpublished.
  *
+ * When the direction is not the first dimension, the lines are strided
+ * in memory.  They are then filtered by bundles of LineBundleSize lines
+ * adjacent along the first dimension: the bundle is read and written
+ * row by row, which are contiguous, and the recurrences of the lines,
+ * which are independent, are computed together in loops that the
+ * compiler vectorizes.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -87,6 +94,12 @@ public:
   /** Set the direction in which the filter is to be applied. */
   itkSetMacro(Direction, unsigned int);
 
+  /** Set/Get the number of lines filtered together when the direction
+   * is not the first dimension.  The default is 16; 1 filters the lines
+   * one at a time. */
+  itkSetClampMacro( LineBundleSize, unsigned int, 1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro(LineBundleSize, unsigned int);
+
   /** Set Input Image. */
   void SetInputImage(const TInputImage *);
 
@@ -130,6 +143,12 @@ protected:
   void FilterDataArray(RealType *outs, const RealType *data, RealType *scratch,
                        unsigned int ln);
 
+  /** Same as FilterDataArray() for bundleSize interleaved lines: the
+   * value of position i of line b is at index i * bundleSize + b of the
+   * arrays, which hold ln * bundleSize values. */
+  void FilterDataBundle(RealType *outs, const RealType *data, RealType *scratch,
+                        unsigned int ln, unsigned int bundleSize);
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0;
@@ -169,6 +188,9 @@ private:
   /** Direction in which the filter is to be applied
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction;
+
+  /** Number of lines filtered together along a strided direction. */
+  unsigned int m_LineBundleSize;
 };
 } // end namespace itk
 
@@ -21,8 +21,11 @@
 #include "itkRecursiveSeparableImageFilter.h"
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include <algorithm>
 #include <new>
+#include <vector>
 
 namespace itk
 {
@@ -31,6 +34,7 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
 ::RecursiveSeparableImageFilter()
 {
   m_Direction = 0;
+  m_LineBundleSize = 16;
   this->SetNumberOfRequiredOutputs(1);
   this->SetNumberOfRequiredInputs(1);
 
@@ -152,6 +156,125 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
     }
 }
 
+/**
+ * Apply Recursive Filter to a bundle of lines
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::FilterDataBundle(RealType *outs, const RealType *data,
+                   RealType *scratch, unsigned int ln, unsigned int bundleSize)
+{
+  const unsigned int s = bundleSize;
+
+  /**
+   * Causal direction pass: initialize the borders of each line, as in
+   * FilterDataArray()
+   */
+  for ( unsigned int b = 0; b < s; b++ )
+    {
+    const RealType *dt = data + b;
+    RealType       *sc = scratch + b;
+
+    const RealType outV1 = dt[0];
+
+    sc[0]     = RealType(outV1     * m_N0 +     outV1 * m_N1 + outV1     * m_N2 + outV1 * m_N3);
+    sc[s]     = RealType(dt[s]     * m_N0 +     outV1 * m_N1 + outV1     * m_N2 + outV1 * m_N3);
+    sc[2 * s] = RealType(dt[2 * s] * m_N0 + dt[s]     * m_N1 + outV1     * m_N2 + outV1 * m_N3);
+    sc[3 * s] = RealType(dt[3 * s] * m_N0 + dt[2 * s] * m_N1 + dt[s]     * m_N2 + outV1 * m_N3);
+
+    sc[0]     -= RealType(outV1     * m_BN1 + outV1     * m_BN2 + outV1 * m_BN3 + outV1 * m_BN4);
+    sc[s]     -= RealType(sc[0]     * m_D1  + outV1     * m_BN2 + outV1 * m_BN3 + outV1 * m_BN4);
+    sc[2 * s] -= RealType(sc[s]     * m_D1  + sc[0]     * m_D2  + outV1 * m_BN3 + outV1 * m_BN4);
+    sc[3 * s] -= RealType(sc[2 * s] * m_D1  + sc[s]     * m_D2  + sc[0] * m_D3  + outV1 * m_BN4);
+    }
+
+  /**
+   * Recursively filter the rest, the lines of the bundle together
+   */
+  for ( unsigned int i = 4; i < ln; i++ )
+    {
+    const RealType *d0 = data + i * s;
+    const RealType *d1 = d0 - s;
+    const RealType *d2 = d1 - s;
+    const RealType *d3 = d2 - s;
+    RealType       *s0 = scratch + i * s;
+    const RealType *s1 = s0 - s;
+    const RealType *s2 = s1 - s;
+    const RealType *s3 = s2 - s;
+    const RealType *s4 = s3 - s;
+    for ( unsigned int b = 0; b < s; b++ )
+      {
+      s0[b]  = RealType(d0[b] * m_N0 + d1[b] * m_N1 + d2[b] * m_N2 + d3[b] * m_N3);
+      s0[b] -= RealType(s1[b] * m_D1 + s2[b] * m_D2 + s3[b] * m_D3 + s4[b] * m_D4);
+      }
+    }
+
+  /**
+   * Store the causal result
+   */
+  const unsigned int n = ln * s;
+  for ( unsigned int i = 0; i < n; i++ )
+    {
+    outs[i] = scratch[i];
+    }
+
+  /**
+   * AntiCausal direction pass: initialize the borders of each line
+   */
+  for ( unsigned int b = 0; b < s; b++ )
+    {
+    const RealType *d1 = data + ( ln - 1 ) * s + b;
+    const RealType *d2 = d1 - s;
+    const RealType *d3 = d2 - s;
+    RealType       *s1 = scratch + ( ln - 1 ) * s + b;
+    RealType       *s2 = s1 - s;
+    RealType       *s3 = s2 - s;
+    RealType       *s4 = s3 - s;
+
+    const RealType outV2 = d1[0];
+
+    s1[0] = RealType(outV2 * m_M1 + outV2 * m_M2 + outV2 * m_M3 + outV2 * m_M4);
+    s2[0] = RealType(d1[0] * m_M1 + outV2 * m_M2 + outV2 * m_M3 + outV2 * m_M4);
+    s3[0] = RealType(d2[0] * m_M1 + d1[0] * m_M2 + outV2 * m_M3 + outV2 * m_M4);
+    s4[0] = RealType(d3[0] * m_M1 + d2[0] * m_M2 + d1[0] * m_M3 + outV2 * m_M4);
+
+    s1[0] -= RealType(outV2 * m_BM1 + outV2 * m_BM2 + outV2 * m_BM3 + outV2 * m_BM4);
+    s2[0] -= RealType(s1[0] * m_D1  + outV2 * m_BM2 + outV2 * m_BM3 + outV2 * m_BM4);
+    s3[0] -= RealType(s2[0] * m_D1  + s1[0] * m_D2  + outV2 * m_BM3 + outV2 * m_BM4);
+    s4[0] -= RealType(s3[0] * m_D1  + s2[0] * m_D2  + s1[0] * m_D3  + outV2 * m_BM4);
+    }
+
+  /**
+   * Recursively filter the rest
+   */
+  for ( unsigned int i = ln - 4; i > 0; i-- )
+    {
+    const RealType *d1 = data + i * s;
+    const RealType *d2 = d1 + s;
+    const RealType *d3 = d2 + s;
+    const RealType *d4 = d3 + s;
+    RealType       *s0 = scratch + ( i - 1 ) * s;
+    const RealType *s1 = s0 + s;
+    const RealType *s2 = s1 + s;
+    const RealType *s3 = s2 + s;
+    const RealType *s4 = s3 + s;
+    for ( unsigned int b = 0; b < s; b++ )
+      {
+      s0[b]  = RealType(d1[b] * m_M1 + d2[b] * m_M2 + d3[b] * m_M3 + d4[b] * m_M4);
+      s0[b] -= RealType(s1[b] * m_D1 + s2[b] * m_D2 + s3[b] * m_D3 + s4[b] * m_D4);
+      }
+    }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for ( unsigned int i = 0; i < n; i++ )
+    {
+    outs[i] += scratch[i];
+    }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -297,14 +420,90 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
 
   RegionType region = outputRegionForThread;
 
+  const unsigned int ln = region.GetSize()[this->m_Direction];
+
+  const SizeValueType numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / outputRegionForThread.GetSize(this->m_Direction);
+
+  if ( this->m_Direction != 0 && m_LineBundleSize > 1 && region.GetSize(0) > 1 )
+    {
+    // Filter bundles of lines adjacent along the first dimension.  With
+    // all the other sizes set to one, the region iterators walk the
+    // bundle row by row, which interleaves the lines in the arrays.
+    const unsigned int bundleSize = std::min( m_LineBundleSize, static_cast< unsigned int >( region.GetSize(0) ) );
+
+    std::vector< RealType > inps(ln * bundleSize);
+    std::vector< RealType > outs(ln * bundleSize);
+    std::vector< RealType > scratch(ln * bundleSize);
+
+    ProgressReporter progress(this, threadId, numberOfLinesToProcess, 10);
+
+    typename RegionType::SizeType bundleRegionSize;
+    bundleRegionSize.Fill(1);
+    bundleRegionSize[this->m_Direction] = ln;
+    RegionType bundle;
+    bundle.SetSize(bundleRegionSize);
+
+    typename RegionType::IndexType index = region.GetIndex();
+    bool                           done = false;
+    while ( !done )
+      {
+      const unsigned int numberOfLines = std::min( bundleSize, static_cast< unsigned int >(
+                                                     region.GetIndex(0) + region.GetSize(0) - index[0] ) );
+      bundle.SetIndex(index);
+      bundle.SetSize(0, numberOfLines);
+
+      unsigned int i = 0;
+      for ( ImageRegionConstIterator< TInputImage > it(inputImage, bundle); !it.IsAtEnd(); ++it )
+        {
+        inps[i++] = it.Get();
+        }
+
+      this->FilterDataBundle(&outs[0], &inps[0], &scratch[0], ln, numberOfLines);
+
+      i = 0;
+      for ( ImageRegionIterator< TOutputImage > ot(outputImage, bundle); !ot.IsAtEnd(); ++ot )
+        {
+        ot.Set( static_cast< OutputPixelType >( outs[i++] ) );
+        }
+
+      for ( unsigned int j = 0; j < numberOfLines; ++j )
+        {
+        progress.CompletedPixel();
+        }
+
+      // Move to the next bundle, the first dimension varying the fastest
+      // and the direction of filtering skipped.
+      index[0] += numberOfLines;
+      done = true;
+      for ( unsigned int d = 0; d < TInputImage::ImageDimension && done; ++d )
+        {
+        if ( d == this->m_Direction )
+          {
+          continue;
+          }
+        if ( d > 0 )
+          {
+          ++index[d];
+          }
+        if ( index[d] < region.GetIndex(d) + static_cast< IndexValueType >( region.GetSize(d) ) )
+          {
+          done = false;
+          }
+        else
+          {
+          index[d] = region.GetIndex(d);
+          }
+        }
+      }
+    return;
+    }
+
   InputConstIteratorType inputIterator(inputImage,  region);
   OutputIteratorType     outputIterator(outputImage, region);
 
   inputIterator.SetDirection(this->m_Direction);
   outputIterator.SetDirection(this->m_Direction);
 
-  const unsigned int ln = region.GetSize()[this->m_Direction];
-
   RealType *inps = 0;
   RealType *outs = 0;
   RealType *scratch = 0;
@@ -318,7 +517,6 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
     inputIterator.GoToBegin();
     outputIterator.GoToBegin();
 
-    const SizeValueType numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / outputRegionForThread.GetSize(this->m_Direction);
     ProgressReporter   progress(this, threadId, numberOfLinesToProcess, 10);
 
     while ( !inputIterator.IsAtEnd() && !outputIterator.IsAtEnd() )
@@ -375,6 +573,7 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Direction: " << m_Direction << std::endl;
+  os << indent << "LineBundleSize: " << m_LineBundleSize << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,174 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkSeparableConvolutionImageFilter_h
+#define __itkSeparableConvolutionImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkNeighborhoodOperator.h"
+#include "itkProgressReporter.h"
+#include <vector>
+
+namespace itk
+{
+/** \class SeparableConvolutionImageFilter
+ * \brief Convolves a scalar image with a 1-D kernel along each dimension.
+ *
+ * The result is the one of a chain of NeighborhoodOperatorImageFilter,
+ * one per kernel, with the default ZeroFluxNeumannBoundaryCondition,
+ * but the image is processed one line or one plane at a time instead
+ * of one neighborhood at a time, and without any intermediate image.
+ *
+ * The last dimension is swept plane by plane.  The input planes are
+ * converted to the operator value type as they are reached and kept in
+ * a ring of 2r+1 planes, r being the radius of the kernel of that
+ * dimension, so that each input pixel is read once.  A plane of the
+ * result is the weighted sum of the planes of the ring, and the
+ * kernels of the other dimensions are then applied within that plane,
+ * from the highest dimension down to the first one:
+ * - along a dimension other than the first, the weighted sum is
+ *   computed between whole rows, or blocks of rows, of the plane, which
+ *   are contiguous in memory;
+ * - along the first dimension, each line is copied, with its border
+ *   replicated, to a padded line buffer and the weighted sum is
+ *   computed between shifted copies of that buffer.
+ * Every step is thus a multiply-accumulate between contiguous arrays
+ * which the compiler vectorizes, and symmetric kernels use half of the
+ * multiplications.  For large volumes, the planes are further cut in
+ * bands along the second to last dimension, so that the ring stays in
+ * the cache.
+ *
+ * The pixel types must be scalars.  Dimensions without a kernel are
+ * not filtered.
+ *
+ * \sa NeighborhoodOperatorImageFilter
+ * \sa DiscreteGaussianImageFilter
+ * \ingroup ImageFilters
+ * \ingroup ITKImageFilterBase
+ */
+template< class TInputImage, class TOutputImage,
+          class TOperatorValueType = typename NumericTraits< typename TOutputImage::PixelType >::RealType >
+class ITK_EXPORT SeparableConvolutionImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef SeparableConvolutionImageFilter                 Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SeparableConvolutionImageFilter, ImageToImageFilter);
+
+  /** Image type information. */
+  typedef TInputImage                          InputImageType;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename TInputImage::PixelType      InputPixelType;
+  typedef typename TOutputImage::PixelType     OutputPixelType;
+  typedef typename TOutputImage::RegionType    OutputImageRegionType;
+  typedef TOperatorValueType                   OperatorValueType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+  itkStaticConstMacro(InputImageDimension, unsigned int,
+                      TInputImage::ImageDimension);
+
+  /** Coefficients of a kernel.  The length of a kernel is odd, and its
+   * center is the middle coefficient. */
+  typedef std::vector< OperatorValueType > KernelType;
+
+  typedef NeighborhoodOperator< OperatorValueType,
+                                itkGetStaticConstMacro(ImageDimension) > OperatorType;
+
+  /** Set the kernel of a dimension.  An empty kernel, the default,
+   * leaves that dimension unfiltered. */
+  void SetKernel(unsigned int dimension, const KernelType & kernel);
+
+  const KernelType & GetKernel(unsigned int dimension) const
+  { return m_Kernels[dimension]; }
+
+  /** Set the kernel of the direction of a directional operator, such as
+   * a GaussianOperator built with CreateDirectional(), from its
+   * coefficients. */
+  void SetOperator(const OperatorType & oper);
+
+  /** Pad the input requested region by the radius of the kernels. */
+  virtual void GenerateInputRequestedRegion()
+  throw ( InvalidRequestedRegionError );
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  /** Begin concept checking */
+  itkConceptMacro( SameDimensionCheck,
+                   ( Concept::SameDimension< InputImageDimension, ImageDimension > ) );
+  itkConceptMacro( InputConvertibleToOperatorCheck,
+                   ( Concept::Convertible< InputPixelType, OperatorValueType > ) );
+  itkConceptMacro( OperatorConvertibleToOutputCheck,
+                   ( Concept::Convertible< OperatorValueType, OutputPixelType > ) );
+  /** End concept checking */
+#endif
+protected:
+  SeparableConvolutionImageFilter();
+  virtual ~SeparableConvolutionImageFilter() {}
+
+  void BeforeThreadedGenerateData();
+
+  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                            ThreadIdType threadId);
+
+  void PrintSelf(std::ostream & os, Indent indent) const;
+
+private:
+  SeparableConvolutionImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);                  //purposely not implemented
+
+  typedef typename OutputImageRegionType::IndexValueType IndexValueType;
+
+  /** Filter a band of the output region of a thread. */
+  void ConvolveBand(const OutputImageRegionType & band, ProgressReporter & progress);
+
+  /** Apply the kernel of dimension to count lines, or blocks of rows,
+   * of length blockLength laid one after the other in input. */
+  void ConvolveBlocks(unsigned int dimension, const OperatorValueType *input, OperatorValueType *output,
+                      IndexValueType inputStart, SizeValueType inputLength,
+                      IndexValueType outputStart, SizeValueType outputLength,
+                      SizeValueType blockLength, SizeValueType count,
+                      std::vector< OperatorValueType > & line) const;
+
+  /** output = sum of the kernel coefficients times the arrays of
+   * length n pointed by taps. */
+  void WeightedSum(unsigned int dimension, const OperatorValueType * const *taps,
+                   OperatorValueType *output, SizeValueType n) const;
+
+  /** Bounds of the input buffered region, which the indices are clamped
+   * to. */
+  Index< ImageDimension > m_ClampStart;
+  Index< ImageDimension > m_ClampEnd;
+
+  std::vector< KernelType > m_Kernels;
+  std::vector< bool >       m_SymmetricKernels;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkSeparableConvolutionImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,445 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkSeparableConvolutionImageFilter_hxx
+#define __itkSeparableConvolutionImageFilter_hxx
+
+#include "itkSeparableConvolutionImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+namespace itk
+{
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::SeparableConvolutionImageFilter():
+  m_Kernels(ImageDimension),
+  m_SymmetricKernels(ImageDimension, false)
+{}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::SetKernel(unsigned int dimension, const KernelType & kernel)
+{
+  if ( dimension >= ImageDimension )
+    {
+    itkExceptionMacro(<< "Dimension " << dimension << " is not smaller than " << ImageDimension);
+    }
+  if ( kernel.size() % 2 == 0 && !kernel.empty() )
+    {
+    itkExceptionMacro(<< "The kernel of dimension " << dimension << " has an even length");
+    }
+
+  bool symmetric = true;
+  for ( SizeValueType i = 0; i < kernel.size() / 2; ++i )
+    {
+    if ( kernel[i] != kernel[kernel.size() - 1 - i] )
+      {
+      symmetric = false;
+      }
+    }
+
+  m_Kernels[dimension] = kernel;
+  m_SymmetricKernels[dimension] = symmetric;
+  this->Modified();
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::SetOperator(const OperatorType & oper)
+{
+  const unsigned long direction = oper.GetDirection();
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    if ( i != direction && oper.GetRadius(i) != 0 )
+      {
+      itkExceptionMacro(<< "The operator is not directional");
+      }
+    }
+
+  KernelType kernel( oper.Size() );
+  for ( unsigned int i = 0; i < oper.Size(); ++i )
+    {
+    kernel[i] = oper[i];
+    }
+  this->SetKernel(direction, kernel);
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::GenerateInputRequestedRegion()
+throw ( InvalidRequestedRegionError )
+{
+  // call the superclass' implementation of this method. this should
+  // copy the output requested region to the input requested region
+  Superclass::GenerateInputRequestedRegion();
+
+  typename InputImageType::Pointer inputPtr =
+    const_cast< InputImageType * >( this->GetInput() );
+  if ( !inputPtr )
+    {
+    return;
+    }
+
+  typename InputImageType::SizeType radius;
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    radius[i] = m_Kernels[i].size() / 2;
+    }
+
+  // pad the input requested region by the kernel radius, and crop it at
+  // the input's largest possible region
+  typename InputImageType::RegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(radius);
+
+  if ( inputRequestedRegion.Crop( inputPtr->GetLargestPossibleRegion() ) )
+    {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+    }
+  else
+    {
+    // Couldn't crop the region (requested region is outside the largest
+    // possible region).  Throw an exception.
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+    InvalidRequestedRegionError e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+    e.SetDataObject(inputPtr);
+    throw e;
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::BeforeThreadedGenerateData()
+{
+  // The border pixels of the buffered region are replicated, as with
+  // ZeroFluxNeumannBoundaryCondition.
+  const typename InputImageType::RegionType & bufferedRegion = this->GetInput()->GetBufferedRegion();
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    m_ClampStart[i] = bufferedRegion.GetIndex(i);
+    m_ClampEnd[i] = bufferedRegion.GetIndex(i) + static_cast< IndexValueType >( bufferedRegion.GetSize(i) ) - 1;
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                       ThreadIdType threadId)
+{
+  const unsigned int lastDimension = ImageDimension - 1;
+
+  // Number of rows of a band: the ring of planes of the input band,
+  // padded by the kernels, holds about half a million values.
+  SizeValueType numberOfBands = 1;
+  SizeValueType bandSize = 0;
+  if ( ImageDimension > 2 )
+    {
+    const unsigned int   bandDimension = ImageDimension - 2;
+    const SizeValueType  bandRadius = m_Kernels[bandDimension].size() / 2;
+    SizeValueType        rowSize = 2 * ( m_Kernels[lastDimension].size() / 2 ) + 1;
+    for ( unsigned int i = 0; i < bandDimension; ++i )
+      {
+      rowSize *= outputRegionForThread.GetSize(i) + m_Kernels[i].size();
+      }
+    const SizeValueType ringCapacity = 1 << 19;
+    bandSize = ringCapacity / rowSize;
+    bandSize = bandSize > 2 * bandRadius ? bandSize - 2 * bandRadius : 0;
+    bandSize = std::max( bandSize, std::max( 2 * bandRadius, static_cast< SizeValueType >( 1 ) ) );
+
+    const SizeValueType size = outputRegionForThread.GetSize(bandDimension);
+    numberOfBands = ( size + bandSize - 1 ) / bandSize;
+    }
+
+  ProgressReporter progress( this, threadId,
+                             numberOfBands * outputRegionForThread.GetSize(lastDimension) );
+
+  if ( numberOfBands == 1 )
+    {
+    this->ConvolveBand(outputRegionForThread, progress);
+    return;
+    }
+
+  const unsigned int bandDimension = ImageDimension - 2;
+  OutputImageRegionType band = outputRegionForThread;
+  const IndexValueType  end = outputRegionForThread.GetIndex(bandDimension)
+                              + static_cast< IndexValueType >( outputRegionForThread.GetSize(bandDimension) );
+  for ( IndexValueType start = outputRegionForThread.GetIndex(bandDimension); start < end;
+        start += static_cast< IndexValueType >( bandSize ) )
+    {
+    band.SetIndex(bandDimension, start);
+    band.SetSize( bandDimension, std::min( bandSize, static_cast< SizeValueType >( end - start ) ) );
+    this->ConvolveBand(band, progress);
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::ConvolveBand(const OutputImageRegionType & band, ProgressReporter & progress)
+{
+  const unsigned int lastDimension = ImageDimension - 1;
+
+  // Region of the input read for the band, and its extent in each
+  // dimension as the kernels are applied.
+  typename InputImageType::RegionType inputPlane;
+  IndexValueType                      inputStart[ImageDimension];
+  SizeValueType                       extent[ImageDimension];
+  SizeValueType                       planeSize = 1;
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    const IndexValueType radius = static_cast< IndexValueType >( m_Kernels[i].size() / 2 );
+    const IndexValueType start = band.GetIndex(i);
+    const IndexValueType end = start + static_cast< IndexValueType >( band.GetSize(i) ) - 1;
+    inputStart[i] = std::max(start - radius, m_ClampStart[i]);
+    extent[i] = std::min(end + radius, m_ClampEnd[i]) - inputStart[i] + 1;
+    inputPlane.SetIndex(i, inputStart[i]);
+    inputPlane.SetSize(i, extent[i]);
+    if ( i < lastDimension )
+      {
+      planeSize *= extent[i];
+      }
+    }
+  inputPlane.SetSize(lastDimension, 1);
+
+  OutputImageRegionType outputPlane = band;
+  outputPlane.SetSize(lastDimension, 1);
+
+  const InputImageType *input = this->GetInput();
+  OutputImageType      *output = this->GetOutput();
+
+  // Ring of the input planes within reach of the kernel of the last
+  // dimension, and the two planes the other kernels alternate between.
+  const KernelType &   lastKernel = m_Kernels[lastDimension];
+  const IndexValueType lastRadius = static_cast< IndexValueType >( lastKernel.size() / 2 );
+  const SizeValueType  ringSize = 2 * lastRadius + 1;
+
+  std::vector< OperatorValueType >         ring(ringSize * planeSize);
+  std::vector< OperatorValueType >         planes[2];
+  std::vector< OperatorValueType >         line;
+  std::vector< const OperatorValueType * > taps( lastKernel.size() );
+  planes[0].resize(planeSize);
+  planes[1].resize(planeSize);
+
+  IndexValueType nextInputPlane = inputStart[lastDimension];
+
+  const IndexValueType start = band.GetIndex(lastDimension);
+  const IndexValueType end = start + static_cast< IndexValueType >( band.GetSize(lastDimension) );
+  for ( IndexValueType z = start; z < end; ++z )
+    {
+    // Read the input planes the kernel reaches.
+    for (; nextInputPlane <= std::min(z + lastRadius, m_ClampEnd[lastDimension]); ++nextInputPlane )
+      {
+      OperatorValueType *value = &ring[( ( nextInputPlane - inputStart[lastDimension] ) % ringSize ) * planeSize];
+      inputPlane.SetIndex(lastDimension, nextInputPlane);
+      for ( ImageRegionConstIterator< InputImageType > it(input, inputPlane); !it.IsAtEnd(); ++it, ++value )
+        {
+        *value = static_cast< OperatorValueType >( it.Get() );
+        }
+      }
+
+    const OperatorValueType *current;
+    unsigned int             next = 0;
+    if ( lastKernel.empty() )
+      {
+      current = &ring[( ( z - inputStart[lastDimension] ) % ringSize ) * planeSize];
+      }
+    else
+      {
+      for ( IndexValueType k = 0; k < static_cast< IndexValueType >( lastKernel.size() ); ++k )
+        {
+        const IndexValueType index = std::min( std::max(z - lastRadius + k, m_ClampStart[lastDimension]),
+                                               m_ClampEnd[lastDimension] );
+        taps[k] = &ring[( ( index - inputStart[lastDimension] ) % ringSize ) * planeSize];
+        }
+      this->WeightedSum(lastDimension, &taps[0], &planes[next][0], planeSize);
+      current = &planes[next][0];
+      next = 1 - next;
+      }
+
+    // Apply the other kernels within the plane.  The dimensions above the
+    // one filtered are already cropped to the band.
+    SizeValueType planeExtent[ImageDimension];
+    std::copy(extent, extent + ImageDimension, planeExtent);
+    for ( int i = static_cast< int >( lastDimension ) - 1; i >= 0; --i )
+      {
+      if ( m_Kernels[i].empty() )
+        {
+        continue;
+        }
+      SizeValueType blockLength = 1;
+      for ( int j = 0; j < i; ++j )
+        {
+        blockLength *= planeExtent[j];
+        }
+      SizeValueType count = 1;
+      for ( unsigned int j = i + 1; j < lastDimension; ++j )
+        {
+        count *= planeExtent[j];
+        }
+      this->ConvolveBlocks(i, current, &planes[next][0],
+                           inputStart[i], planeExtent[i], band.GetIndex(i), band.GetSize(i),
+                           blockLength, count, line);
+      planeExtent[i] = band.GetSize(i);
+      current = &planes[next][0];
+      next = 1 - next;
+      }
+
+    outputPlane.SetIndex(lastDimension, z);
+    for ( ImageRegionIterator< OutputImageType > it(output, outputPlane); !it.IsAtEnd(); ++it, ++current )
+      {
+      it.Set( static_cast< OutputPixelType >( *current ) );
+      }
+    progress.CompletedPixel();
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::ConvolveBlocks(unsigned int dimension, const OperatorValueType *input, OperatorValueType *output,
+                 IndexValueType inputStart, SizeValueType inputLength,
+                 IndexValueType outputStart, SizeValueType outputLength,
+                 SizeValueType blockLength, SizeValueType count,
+                 std::vector< OperatorValueType > & line) const
+{
+  const KernelType &   kernel = m_Kernels[dimension];
+  const IndexValueType radius = static_cast< IndexValueType >( kernel.size() / 2 );
+  const IndexValueType clampStart = m_ClampStart[dimension];
+  const IndexValueType clampEnd = m_ClampEnd[dimension];
+
+  std::vector< const OperatorValueType * > taps( kernel.size() );
+
+  if ( blockLength == 1 )
+    {
+    // Lines along the first dimension: copy each one to a buffer padded
+    // with its border values, and sum shifted views of the buffer.
+    line.resize( outputLength + 2 * radius );
+    for ( SizeValueType k = 0; k < kernel.size(); ++k )
+      {
+      taps[k] = &line[k];
+      }
+    for ( SizeValueType c = 0; c < count; ++c, input += inputLength, output += outputLength )
+      {
+      for ( IndexValueType t = 0; t < static_cast< IndexValueType >( line.size() ); ++t )
+        {
+        const IndexValueType index = std::min(std::max(outputStart - radius + t, clampStart), clampEnd);
+        line[t] = input[index - inputStart];
+        }
+      this->WeightedSum(dimension, &taps[0], output, outputLength);
+      }
+    return;
+    }
+
+  // Along the other dimensions, the taps are whole blocks of rows.
+  for ( SizeValueType c = 0; c < count; ++c )
+    {
+    for ( SizeValueType i = 0; i < outputLength; ++i, output += blockLength )
+      {
+      const IndexValueType center = outputStart + static_cast< IndexValueType >( i );
+      for ( IndexValueType k = 0; k < static_cast< IndexValueType >( kernel.size() ); ++k )
+        {
+        const IndexValueType index = std::min(std::max(center - radius + k, clampStart), clampEnd);
+        taps[k] = input + ( index - inputStart ) * blockLength;
+        }
+      this->WeightedSum(dimension, &taps[0], output, blockLength);
+      }
+    input += inputLength * blockLength;
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::WeightedSum(unsigned int dimension, const OperatorValueType * const *taps,
+              OperatorValueType *output, SizeValueType n) const
+{
+  const KernelType &  kernel = m_Kernels[dimension];
+  const SizeValueType length = kernel.size();
+  const SizeValueType radius = length / 2;
+
+  // Work by chunks that stay in the first level cache while all the taps
+  // are added.
+  const SizeValueType chunkSize = 1024;
+  for ( SizeValueType offset = 0; offset < n; offset += chunkSize )
+    {
+    const SizeValueType m = std::min(chunkSize, n - offset);
+    OperatorValueType  *out = output + offset;
+
+    if ( m_SymmetricKernels[dimension] )
+      {
+      const OperatorValueType  w = kernel[radius];
+      const OperatorValueType *a = taps[radius] + offset;
+      for ( SizeValueType j = 0; j < m; ++j )
+        {
+        out[j] = w * a[j];
+        }
+      for ( SizeValueType k = 0; k < radius; ++k )
+        {
+        const OperatorValueType  v = kernel[k];
+        const OperatorValueType *b = taps[k] + offset;
+        const OperatorValueType *c = taps[length - 1 - k] + offset;
+        for ( SizeValueType j = 0; j < m; ++j )
+          {
+          out[j] += v * ( b[j] + c[j] );
+          }
+        }
+      }
+    else
+      {
+      const OperatorValueType  w = kernel[0];
+      const OperatorValueType *a = taps[0] + offset;
+      for ( SizeValueType j = 0; j < m; ++j )
+        {
+        out[j] = w * a[j];
+        }
+      for ( SizeValueType k = 1; k < length; ++k )
+        {
+        const OperatorValueType  v = kernel[k];
+        const OperatorValueType *b = taps[k] + offset;
+        for ( SizeValueType j = 0; j < m; ++j )
+          {
+          out[j] += v * b[j];
+          }
+        }
+      }
+    }
+}
+
+template< class TInputImage, class TOutputImage, class TOperatorValueType >
+void
+SeparableConvolutionImageFilter< TInputImage, TOutputImage, TOperatorValueType >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    os << indent << "Kernel[" << i << "]: " << m_Kernels[i].size() << " coefficients"
+       << ( m_SymmetricKernels[i] ? ", symmetric" : "" ) << std::endl;
+    }
+}
+} // end namespace itk
+
+#endif
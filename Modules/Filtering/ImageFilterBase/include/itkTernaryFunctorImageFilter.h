@@ -20,6 +20,7 @@
 
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkFunctorFusionStage.h"
 
 namespace itk
 {
@@ -30,6 +31,9 @@ namespace itk
  * and the type of the output image.  It is also parameterized by the
  * operation to be applied, using a Functor style.
  *
+ * The filter implements FunctorFusionStage, so it can be part of a chain
+ * executed in a single pass by FunctorFusionImageFilter.
+ *
  * \sa BinaryFunctorImageFilter UnaryFunctorImageFilter
  *
  * \ingroup IntensityImageFilters MultiThreaded
@@ -38,7 +42,8 @@ namespace itk
 template< class TInputImage1, class TInputImage2,
           class TInputImage3, class TOutputImage, class TFunction    >
 class ITK_EXPORT TernaryFunctorImageFilter:
-  public InPlaceImageFilter< TInputImage1, TOutputImage >
+  public InPlaceImageFilter< TInputImage1, TOutputImage >,
+  public FunctorFusionStage< TOutputImage::ImageDimension >
 {
 public:
   /** Standard class typedefs. */
@@ -111,6 +116,26 @@ public:
       }
   }
 
+  /** FunctorFusionStage interface. */
+  typedef FunctorFusionStage< TOutputImage::ImageDimension > FusionStageType;
+  typedef typename FusionStageType::FusionIndexType          FusionIndexType;
+
+  virtual bool CanFuse() const;
+
+  virtual unsigned int GetNumberOfFusionInputs() const { return 3; }
+
+  virtual const DataObject * GetFusionInput(unsigned int input) const;
+
+  virtual void BeforeFusedGenerateData();
+
+  virtual const void * GetFusionInputLine(unsigned int input, const FusionIndexType & index) const;
+
+  virtual void * AllocateFusionLine(SizeValueType length) const;
+
+  virtual void ReleaseFusionLine(void *line) const;
+
+  virtual void EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length);
+
   /** Image dimensions */
   itkStaticConstMacro(Input1ImageDimension, unsigned int,
                       TInputImage1::ImageDimension);
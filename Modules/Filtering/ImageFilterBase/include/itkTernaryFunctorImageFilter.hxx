@@ -142,6 +142,103 @@ TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImag
     progress.CompletedPixel(); // potential exception thrown here
     }
 }
+
+template< class TInputImage1, class TInputImage2,
+          class TInputImage3, class TOutputImage, class TFunction  >
+bool
+TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction >
+::CanFuse() const
+{
+  return ProcessObject::GetInput(0) != NULL
+         && ProcessObject::GetInput(1) != NULL
+         && ProcessObject::GetInput(2) != NULL
+         && typeid( TInputImage1 ) == typeid( Image< Input1ImagePixelType, Input1ImageDimension > )
+         && typeid( TInputImage2 ) == typeid( Image< Input2ImagePixelType, Input2ImageDimension > )
+         && typeid( TInputImage3 ) == typeid( Image< Input3ImagePixelType, Input3ImageDimension > )
+         && typeid( TOutputImage ) == typeid( Image< OutputImagePixelType, OutputImageDimension > )
+         && Input1ImageDimension == OutputImageDimension
+         && Input2ImageDimension == OutputImageDimension
+         && Input3ImageDimension == OutputImageDimension;
+}
+
+template< class TInputImage1, class TInputImage2,
+          class TInputImage3, class TOutputImage, class TFunction  >
+const DataObject *
+TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction >
+::GetFusionInput(unsigned int input) const
+{
+  return ProcessObject::GetInput(input);
+}
+
+template< class TInputImage1, class TInputImage2,
+          class TInputImage3, class TOutputImage, class TFunction  >
+void
+TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction >
+::BeforeFusedGenerateData()
+{
+  this->BeforeThreadedGenerateData();
+}
+
+template< class TInputImage1, class TInputImage2,
+          class TInputImage3, class TOutputImage, class TFunction  >
+const void *
+TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction >
+::GetFusionInputLine(unsigned int input, const FusionIndexType & index) const
+{
+  switch ( input )
+    {
+    case 0:
+      {
+      const TInputImage1 *inputPtr1 = static_cast< const TInputImage1 * >( ProcessObject::GetInput(0) );
+      return inputPtr1->GetBufferPointer() + inputPtr1->ComputeOffset(index);
+      }
+    case 1:
+      {
+      const TInputImage2 *inputPtr2 = static_cast< const TInputImage2 * >( ProcessObject::GetInput(1) );
+      return inputPtr2->GetBufferPointer() + inputPtr2->ComputeOffset(index);
+      }
+    default:
+      {
+      const TInputImage3 *inputPtr3 = static_cast< const TInputImage3 * >( ProcessObject::GetInput(2) );
+      return inputPtr3->GetBufferPointer() + inputPtr3->ComputeOffset(index);
+      }
+    }
+}
+
+template< class TInputImage1, class TInputImage2,
+          class TInputImage3, class TOutputImage, class TFunction  >
+void *
+TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction >
+::AllocateFusionLine(SizeValueType length) const
+{
+  return new OutputImagePixelType[length];
+}
+
+template< class TInputImage1, class TInputImage2,
+          class TInputImage3, class TOutputImage, class TFunction  >
+void
+TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction >
+::ReleaseFusionLine(void *line) const
+{
+  delete[] static_cast< OutputImagePixelType * >( line );
+}
+
+template< class TInputImage1, class TInputImage2,
+          class TInputImage3, class TOutputImage, class TFunction  >
+void
+TernaryFunctorImageFilter< TInputImage1, TInputImage2, TInputImage3, TOutputImage, TFunction >
+::EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length)
+{
+  const Input1ImagePixelType *inputLine1 = static_cast< const Input1ImagePixelType * >( inputs[0] );
+  const Input2ImagePixelType *inputLine2 = static_cast< const Input2ImagePixelType * >( inputs[1] );
+  const Input3ImagePixelType *inputLine3 = static_cast< const Input3ImagePixelType * >( inputs[2] );
+  OutputImagePixelType *      outputLine = static_cast< OutputImagePixelType * >( output );
+
+  for ( SizeValueType i = 0; i < length; ++i )
+    {
+    outputLine[i] = m_Functor(inputLine1[i], inputLine2[i], inputLine3[i]);
+    }
+}
 } // end namespace itk
 
 #endif
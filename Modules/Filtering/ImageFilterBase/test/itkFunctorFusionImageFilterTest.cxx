@@ -0,0 +1,225 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFunctorFusionImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkTernaryAddImageFilter.h"
+#include "itkNaryAddImageFilter.h"
+#include "itkRescaleIntensityImageFilter.h"
+#include "itkMaskImageFilter.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkClampImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+namespace
+{
+template< class TImage >
+bool CompareImages(const TImage *fused, const TImage *reference)
+{
+  if ( fused->GetBufferedRegion() != reference->GetBufferedRegion() )
+    {
+    std::cerr << "The fused output has region " << fused->GetBufferedRegion()
+              << " instead of " << reference->GetBufferedRegion() << std::endl;
+    return false;
+    }
+  itk::ImageRegionConstIteratorWithIndex< TImage > fit( fused, fused->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< TImage >          rit( reference, reference->GetBufferedRegion() );
+  for (; !fit.IsAtEnd(); ++fit, ++rit )
+    {
+    if ( fit.Get() != rit.Get() )
+      {
+      std::cerr << "Pixel " << fit.GetIndex() << " is " << fit.Get()
+                << " instead of " << rit.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkFunctorFusionImageFilterTest(int, char* [])
+{
+  const unsigned int Dimension = 3;
+
+  typedef itk::Image< float, Dimension >         FloatImageType;
+  typedef itk::Image< unsigned char, Dimension > MaskImageType;
+  typedef itk::Image< short, Dimension >         ShortImageType;
+
+  FloatImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 19;
+  size[2] = 7;
+  FloatImageType::IndexType start;
+  start.Fill(-3);
+  FloatImageType::RegionType region(start, size);
+
+  FloatImageType::Pointer image1 = FloatImageType::New();
+  FloatImageType::Pointer image2 = FloatImageType::New();
+  MaskImageType::Pointer  mask = MaskImageType::New();
+  image1->SetRegions(region);
+  image1->Allocate();
+  image2->SetRegions(region);
+  image2->Allocate();
+  mask->SetRegions(region);
+  mask->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< FloatImageType > it1( image1, region );
+  itk::ImageRegionIterator< FloatImageType >          it2( image2, region );
+  itk::ImageRegionIterator< MaskImageType >           mit( mask, region );
+  for (; !it1.IsAtEnd(); ++it1, ++it2, ++mit )
+    {
+    const FloatImageType::IndexType & index = it1.GetIndex();
+    it1.Set( 0.5f * index[0] - 2.0f * index[1] + 3.0f * index[2] );
+    it2.Set( static_cast< float >( ( index[0] * 7 + index[1] * 3 + index[2] ) % 11 ) - 5.0f );
+    mit.Set( ( index[0] + index[1] ) % 3 ? 1 : 0 );
+    }
+
+  // A first fusable segment reads the two images, with a constant operand,
+  // a ternary and an n-ary functor.
+  typedef itk::AddImageFilter< FloatImageType, FloatImageType, FloatImageType >      AddType;
+  typedef itk::TernaryAddImageFilter< FloatImageType, FloatImageType,
+                                      FloatImageType, FloatImageType >              TernaryAddType;
+  typedef itk::NaryAddImageFilter< FloatImageType, FloatImageType >                   NaryAddType;
+  typedef itk::RescaleIntensityImageFilter< FloatImageType, FloatImageType >          RescaleType;
+  typedef itk::MultiplyImageFilter< FloatImageType, FloatImageType, FloatImageType > MultiplyType;
+  typedef itk::MaskImageFilter< FloatImageType, MaskImageType, FloatImageType >       MaskType;
+  typedef itk::ClampImageFilter< FloatImageType, ShortImageType >                     ClampType;
+
+  AddType::Pointer add = AddType::New();
+  add->SetInput1( image1 );
+  add->SetConstant2( 10.0f );
+
+  TernaryAddType::Pointer ternaryAdd = TernaryAddType::New();
+  ternaryAdd->SetInput1( add->GetOutput() );
+  ternaryAdd->SetInput2( image2 );
+  ternaryAdd->SetInput3( image1 );
+
+  NaryAddType::Pointer naryAdd = NaryAddType::New();
+  naryAdd->SetInput( 0, ternaryAdd->GetOutput() );
+  naryAdd->SetInput( 1, image2 );
+
+  // The rescaling needs the range of its input, so it ends the chain of the
+  // filters downstream of it.
+  RescaleType::Pointer rescale = RescaleType::New();
+  rescale->SetInput( naryAdd->GetOutput() );
+  rescale->SetOutputMinimum( -40000.0f );
+  rescale->SetOutputMaximum( 40000.0f );
+
+  MultiplyType::Pointer multiply = MultiplyType::New();
+  multiply->SetInput1( rescale->GetOutput() );
+  multiply->SetConstant2( 0.75f );
+
+  MaskType::Pointer maskFilter = MaskType::New();
+  maskFilter->SetInput1( multiply->GetOutput() );
+  maskFilter->SetInput2( mask );
+  maskFilter->SetOutsideValue( -123.0f );
+
+  ClampType::Pointer clamp = ClampType::New();
+  clamp->SetInput( maskFilter->GetOutput() );
+
+  typedef itk::FunctorFusionImageFilter< FloatImageType > FloatFusionType;
+  typedef itk::FunctorFusionImageFilter< ShortImageType > ShortFusionType;
+
+  FloatFusionType::Pointer naryFusion = FloatFusionType::New();
+  naryFusion->SetChainOutput( naryAdd->GetOutput() );
+  naryFusion->SetNumberOfThreads( 3 );
+  naryFusion->Update();
+
+  if ( naryFusion->GetNumberOfFusedFilters() != 3 )
+    {
+    std::cerr << "Fused " << naryFusion->GetNumberOfFusedFilters()
+              << " filters instead of 3" << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( add->GetOutput()->GetBufferedRegion().GetNumberOfPixels() != 0 )
+    {
+    std::cerr << "A fused filter was executed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  naryAdd->Update();
+  if ( !CompareImages< FloatImageType >( naryFusion->GetOutput(), naryAdd->GetOutput() ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  ShortFusionType::Pointer clampFusion = ShortFusionType::New();
+  clampFusion->SetChainOutput( clamp->GetOutput() );
+  clampFusion->SetNumberOfThreads( 4 );
+  clampFusion->Update();
+
+  if ( clampFusion->GetNumberOfFusedFilters() != 3 )
+    {
+    std::cerr << "Fused " << clampFusion->GetNumberOfFusedFilters()
+              << " filters instead of 3" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  clamp->Update();
+  if ( !CompareImages< ShortImageType >( clampFusion->GetOutput(), clamp->GetOutput() ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A change in the chain is seen by the fused execution.
+  maskFilter->SetOutsideValue( 321.0f );
+  multiply->SetConstant2( -2.0f );
+  clampFusion->Update();
+  clamp->Update();
+  if ( !CompareImages< ShortImageType >( clampFusion->GetOutput(), clamp->GetOutput() ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // A requested region smaller than the image.
+  ShortImageType::RegionType requestedRegion = region;
+  requestedRegion.ShrinkByRadius( 2 );
+  clampFusion->GetOutput()->SetRequestedRegion( requestedRegion );
+  clampFusion->Modified();
+  clampFusion->GetOutput()->Update();
+  clamp->GetOutput()->SetRequestedRegion( requestedRegion );
+  clamp->Modified();
+  clamp->GetOutput()->Update();
+  if ( !CompareImages< ShortImageType >( clampFusion->GetOutput(), clamp->GetOutput() ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // The tail of the chain must be fusable.
+  FloatFusionType::Pointer rescaleFusion = FloatFusionType::New();
+  rescaleFusion->SetChainOutput( rescale->GetOutput() );
+  bool caught = false;
+  try
+    {
+    rescaleFusion->Update();
+    }
+  catch ( itk::ExceptionObject & excp )
+    {
+    std::cout << "Caught expected exception: " << excp.GetDescription() << std::endl;
+    caught = true;
+    }
+  if ( !caught )
+    {
+    std::cerr << "A chain ending with RescaleIntensityImageFilter was fused" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  clampFusion->Print( std::cout );
+
+  return EXIT_SUCCESS;
+}
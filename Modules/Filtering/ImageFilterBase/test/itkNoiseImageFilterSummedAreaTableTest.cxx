@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNoiseImageFilter.h"
+#include "itkRandomImageSource.h"
+#include "itkConstNeighborhoodIterator.h"
+
+int itkNoiseImageFilterSummedAreaTableTest(int, char* [] )
+{
+  typedef itk::Image< short, 3 >                                   InputImageType;
+  typedef itk::Image< float, 3 >                                   OutputImageType;
+  typedef itk::NoiseImageFilter< InputImageType, OutputImageType > FilterType;
+
+  itk::RandomImageSource< InputImageType >::Pointer random =
+    itk::RandomImageSource< InputImageType >::New();
+  random->SetMin(-500);
+  random->SetMax(1500);
+  InputImageType::SizeValueType randomSize[3] = { 20, 17, 9 };
+  random->SetSize(randomSize);
+  random->Update();
+
+  InputImageType::SizeType radius;
+  radius[0] = 2;
+  radius[1] = 1;
+  radius[2] = 3;
+
+  FilterType::Pointer noise = FilterType::New();
+  noise->SetInput( random->GetOutput() );
+  noise->SetRadius(radius);
+  noise->Update();
+
+  FilterType::Pointer tableNoise = FilterType::New();
+  tableNoise->SetInput( random->GetOutput() );
+  tableNoise->SetRadius(radius);
+  tableNoise->UseSummedAreaTableOn();
+  tableNoise->Update();
+  std::cout << tableNoise << std::endl;
+
+  // Both ways must give the standard deviation of the neighborhood, with
+  // the pixels outside the image replicating the nearest border pixel.
+  itk::ConstNeighborhoodIterator< InputImageType > nit( radius, random->GetOutput(),
+                                                        random->GetOutput()->GetBufferedRegion() );
+  const double n = nit.Size();
+  for ( nit.GoToBegin(); !nit.IsAtEnd(); ++nit )
+    {
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    for ( unsigned int i = 0; i < nit.Size(); ++i )
+      {
+      const double value = nit.GetPixel(i);
+      sum += value;
+      sumOfSquares += value * value;
+      }
+    const double sigma = vcl_sqrt( ( sumOfSquares - sum * sum / n ) / ( n - 1.0 ) );
+
+    const InputImageType::IndexType index = nit.GetIndex();
+    const double slidingSigma = noise->GetOutput()->GetPixel(index);
+    const double tableSigma = tableNoise->GetOutput()->GetPixel(index);
+    if ( vnl_math_abs(slidingSigma - sigma) > 1e-3 * sigma
+         || vnl_math_abs(tableSigma - sigma) > 1e-3 * sigma )
+      {
+      std::cerr << "Standard deviation at " << index << " is " << slidingSigma
+                << " with the sliding window and " << tableSigma
+                << " with the summed area tables instead of " << sigma << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
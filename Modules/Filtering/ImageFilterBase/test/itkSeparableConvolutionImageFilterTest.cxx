@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSeparableConvolutionImageFilter.h"
+#include "itkNeighborhoodOperatorImageFilter.h"
+#include "itkGaussianOperator.h"
+#include "itkDerivativeOperator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+namespace
+{
+typedef itk::Image< float, 3 >  ImageType;
+typedef itk::Image< double, 3 > RealImageType;
+
+// Compare output with reference over the output buffered region.
+bool CompareImages(const ImageType *output, const RealImageType *reference)
+{
+  itk::ImageRegionConstIterator< ImageType >     it( output, output->GetBufferedRegion() );
+  itk::ImageRegionConstIterator< RealImageType > rt( reference, output->GetBufferedRegion() );
+  for (; !it.IsAtEnd(); ++it, ++rt )
+    {
+    if ( vcl_abs( it.Get() - rt.Get() ) > 1e-4 * ( 1.0 + vcl_abs( rt.Get() ) ) )
+      {
+      std::cerr << "Value " << it.Get() << " at " << it.GetIndex()
+                << " instead of " << rt.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkSeparableConvolutionImageFilterTest(int, char *[])
+{
+  // The rows are long enough for the planes to be cut in bands.
+  ImageType::IndexType start;
+  start[0] = 3;
+  start[1] = -2;
+  start[2] = 1;
+  ImageType::SizeType size;
+  size[0] = 600;
+  size[1] = 96;
+  size[2] = 8;
+  ImageType::RegionType region(start, size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::Statistics::MersenneTwisterRandomVariateGenerator::Pointer random =
+    itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  random->SetSeed(1234);
+  for ( itk::ImageRegionIterator< ImageType > it(image, region); !it.IsAtEnd(); ++it )
+    {
+    it.Set( random->GetUniformVariate(-100.0, 100.0) );
+    }
+
+  // Gaussian kernels along the first and last dimensions, and an
+  // asymmetric derivative along the second one.
+  itk::GaussianOperator< double, 3 > gaussian0;
+  gaussian0.SetDirection(0);
+  gaussian0.SetVariance(3.0);
+  gaussian0.CreateDirectional();
+
+  itk::DerivativeOperator< double, 3 > derivative1;
+  derivative1.SetDirection(1);
+  derivative1.SetOrder(1);
+  derivative1.CreateDirectional();
+
+  itk::GaussianOperator< double, 3 > gaussian2;
+  gaussian2.SetDirection(2);
+  gaussian2.SetVariance(9.0);
+  gaussian2.CreateDirectional();
+
+  // Reference: one NeighborhoodOperatorImageFilter per dimension.
+  typedef itk::NeighborhoodOperatorImageFilter< ImageType, RealImageType, double >     FirstFilterType;
+  typedef itk::NeighborhoodOperatorImageFilter< RealImageType, RealImageType, double > NextFilterType;
+  FirstFilterType::Pointer first = FirstFilterType::New();
+  first->SetInput(image);
+  first->SetOperator(gaussian2);
+  NextFilterType::Pointer second = NextFilterType::New();
+  second->SetInput( first->GetOutput() );
+  second->SetOperator(derivative1);
+  NextFilterType::Pointer third = NextFilterType::New();
+  third->SetInput( second->GetOutput() );
+  third->SetOperator(gaussian0);
+  third->Update();
+
+  typedef itk::SeparableConvolutionImageFilter< ImageType, ImageType, double > FilterType;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetOperator(gaussian0);
+  filter->SetOperator(derivative1);
+  filter->SetOperator(gaussian2);
+  filter->Print(std::cout);
+
+  try
+    {
+    filter->Update();
+    if ( !CompareImages( filter->GetOutput(), third->GetOutput() ) )
+      {
+      return EXIT_FAILURE;
+      }
+
+    // A requested region inside the image, with a number of threads
+    // that does not divide it.
+    ImageType::RegionType requestedRegion = region;
+    requestedRegion.ShrinkByRadius(2);
+    filter->SetNumberOfThreads(3);
+    filter->GetOutput()->SetRequestedRegion(requestedRegion);
+    filter->Update();
+    if ( filter->GetOutput()->GetBufferedRegion() != requestedRegion
+         || !CompareImages( filter->GetOutput(), third->GetOutput() ) )
+      {
+      std::cerr << "Wrong result over the requested region " << requestedRegion << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    // Without kernel along the last dimension.
+    filter->SetKernel( 2, FilterType::KernelType() );
+    first->SetOperator(derivative1);
+    third->SetInput( first->GetOutput() );
+    third->Update();
+    filter->GetOutput()->SetRequestedRegion(region);
+    filter->Update();
+    if ( !CompareImages( filter->GetOutput(), third->GetOutput() ) )
+      {
+      std::cerr << "Wrong result without the kernel of the last dimension" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  catch ( itk::ExceptionObject & excp )
+    {
+    std::cerr << excp << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Kernels of even length are rejected.
+  bool caught = false;
+  try
+    {
+    filter->SetKernel( 0, FilterType::KernelType(4, 0.25) );
+    }
+  catch ( itk::ExceptionObject & )
+    {
+    caught = true;
+    }
+  if ( !caught )
+    {
+    std::cerr << "A kernel of even length was accepted" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -169,8 +169,8 @@ private:
 
   // An overloaded method which may transform the gradient to a
   // physical vector and converts to the correct output pixel type.
-  template <class TValueType>
-  void SetOutputPixel( ImageRegionIterator< VectorImage<TValueType,OutputImageDimension> > &it, CovariantVectorType &gradient )
+  template < template< class > class TIterator, class TValueType >
+  void SetOutputPixel( TIterator< VectorImage<TValueType,OutputImageDimension> > &it, CovariantVectorType &gradient )
   {
     if ( this->m_UseImageDirection )
       {
@@ -184,8 +184,8 @@ private:
       }
   }
 
-  template <class T >
-  void SetOutputPixel( ImageRegionIterator< T > &it, CovariantVectorType &gradient )
+  template < template< class > class TIterator, class T >
+  void SetOutputPixel( TIterator< T > &it, CovariantVectorType &gradient )
   {
     // This uses the more efficient set by reference method
     if ( this->m_UseImageDirection )
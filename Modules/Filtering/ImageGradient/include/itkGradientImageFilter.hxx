@@ -22,10 +22,12 @@
 #include "itkConstNeighborhoodIterator.h"
 #include "itkNeighborhoodInnerProduct.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkDerivativeOperator.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include <vector>
 
 namespace itk
 {
@@ -182,9 +184,72 @@ GradientImageFilter< TInputImage, TOperatorValueType, TOutputValueType, TOutputI
                              op[i].GetSize()[0], nit.GetStride(i) );
     }
 
-  // Process non-boundary face and then each of the boundary faces.
-  // These are N-d regions which border the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
+  // Process non-boundary face.  The neighborhoods of its pixels are
+  // inside the buffer, so the taps of the operators are read at fixed
+  // offsets from the center pixel, line by line, instead of through a
+  // neighborhood iterator.  The products are summed in the same order and
+  // types as in NeighborhoodInnerProduct.
+  typedef typename InputImageType::InternalPixelType                  InputInternalPixelType;
+  typedef typename NumericTraits< InputPixelType >::RealType          InputPixelRealType;
+  typedef typename NumericTraits< InputPixelRealType >::AccumulateType AccumulateRealType;
+  typedef typename NumericTraits< OutputValueType >::ValueType        OutputPixelValueType;
+
+  fit = faceList.begin();
+  if ( fit->GetNumberOfPixels() > 0 )
+    {
+    const SizeValueType                 numberOfTaps = op[0].GetSize()[0];
+    std::vector< OutputPixelValueType > coefficients(InputImageDimension * numberOfTaps);
+    OffsetValueType                     firstTap[InputImageDimension];
+    OffsetValueType                     tapStride[InputImageDimension];
+    for ( i = 0; i < InputImageDimension; ++i )
+      {
+      for ( SizeValueType k = 0; k < numberOfTaps; ++k )
+        {
+        coefficients[i * numberOfTaps + k] = static_cast< OutputPixelValueType >( op[i][k] );
+        }
+      tapStride[i] = inputImage->GetOffsetTable()[i];
+      firstTap[i] = -static_cast< OffsetValueType >( radius[i] ) * tapStride[i];
+      }
+
+    typename InputImageType::NeighborhoodAccessorFunctorType accessor = inputImage->GetNeighborhoodAccessor();
+    accessor.SetBegin( inputImage->GetBufferPointer() );
+
+    ImageScanlineIterator< OutputImageType > sit(outputImage, *fit);
+    while ( !sit.IsAtEnd() )
+      {
+      const InputInternalPixelType *center =
+        inputImage->GetBufferPointer() + inputImage->ComputeOffset( sit.GetIndex() );
+      while ( !sit.IsAtEndOfLine() )
+        {
+        for ( i = 0; i < InputImageDimension; ++i )
+          {
+          const OutputPixelValueType *  coefficient = &coefficients[i * numberOfTaps];
+          const InputInternalPixelType *tap = center + firstTap[i];
+          AccumulateRealType            sum = NumericTraits< AccumulateRealType >::Zero;
+          for ( SizeValueType k = 0; k < numberOfTaps; ++k, tap += tapStride[i] )
+            {
+            sum += static_cast< AccumulateRealType >(
+              coefficient[k] * static_cast< InputPixelRealType >( accessor.Get(tap) ) );
+            }
+          gradient[i] = static_cast< OutputValueType >( sum );
+          }
+
+        // This method optionally performs a tansform for Physical
+        // coordiantes and potential conversion to a different output
+        // pixel type.
+        this->SetOutputPixel( sit, gradient );
+
+        ++center;
+        ++sit;
+        progress.CompletedPixel();
+        }
+      sit.NextLine();
+      }
+    }
+
+  // Process each of the boundary faces.  These are N-d regions which
+  // border the edge of the buffer.
+  for ( ++fit; fit != faceList.end(); ++fit )
     {
     nit = ConstNeighborhoodIterator< InputImageType >(radius,
                                                       inputImage, *fit);
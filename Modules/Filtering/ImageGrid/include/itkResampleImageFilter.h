@@ -26,6 +26,9 @@
 #include "itkLinearInterpolateImageFunction.h"
 #include "itkSize.h"
 #include "itkDefaultConvertPixelTraits.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+#include <vector>
 
 namespace itk
 {
@@ -333,6 +336,24 @@ protected:
                                                  const ComponentType minComponent,
                                                  const ComponentType maxComponent) const;
 
+  /** Working space of ResampleLine(), kept by each thread from line to
+   * line. */
+  struct LineBuffers
+  {
+    std::vector< ContinuousInputIndexType > m_InsideIndices;
+    std::vector< InterpolatorOutputType >   m_InsideValues;
+    std::vector< bool >                     m_IsInside;
+  };
+
+  /** Set the pixels of the line of the output iterator, which is at the
+   * beginning of the line, from the input image at their continuous
+   * indices inputIndices, and move the iterator to the end of the line.  The indices inside the buffer are
+   * evaluated by the interpolator all at once. */
+  void ResampleLine(ImageScanlineIterator< TOutputImage > & outIt,
+                    const ContinuousInputIndexType *inputIndices,
+                    LineBuffers & buffers,
+                    ProgressReporter & progress);
+
 private:
   ResampleImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);      //purposely not implemented
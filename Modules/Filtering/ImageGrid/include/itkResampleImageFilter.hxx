@@ -23,9 +23,11 @@
 #include "itkIdentityTransform.h"
 #include "itkProgressReporter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
 #include "itkImageLinearIteratorWithIndex.h"
 #include "itkSpecialCoordinatesImage.h"
 #include "itkDefaultConvertPixelTraits.h"
+#include <vector>
 
 namespace itk
 {
@@ -283,6 +285,77 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   return outputValue;
 }
 
+/**
+ * Set the pixels of a line of the output
+ */
+template< class TInputImage,
+          class TOutputImage,
+          class TInterpolatorPrecisionType >
+void
+ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
+::ResampleLine(ImageScanlineIterator< TOutputImage > & outIt,
+               const ContinuousInputIndexType *inputIndices,
+               LineBuffers & buffers,
+               ProgressReporter & progress)
+{
+  // Min/max values of the output pixel type AND these values
+  // represented as the output type of the interpolator
+  const PixelComponentType minValue =  NumericTraits< PixelComponentType >::NonpositiveMin();
+  const PixelComponentType maxValue =  NumericTraits< PixelComponentType >::max();
+
+  const ComponentType minOutputValue = static_cast< ComponentType >( minValue );
+  const ComponentType maxOutputValue = static_cast< ComponentType >( maxValue );
+
+  // Gather the indices inside the buffer, to interpolate them at once
+  const SizeValueType lineLength = outIt.GetRegion().GetSize(0);
+  buffers.m_IsInside.resize(lineLength);
+  buffers.m_InsideIndices.resize(lineLength);
+  buffers.m_InsideValues.resize(lineLength);
+
+  SizeValueType numberOfInsideIndices = 0;
+  for ( SizeValueType i = 0; i < lineLength; ++i )
+    {
+    buffers.m_IsInside[i] = m_Interpolator->IsInsideBuffer(inputIndices[i]);
+    if ( buffers.m_IsInside[i] )
+      {
+      buffers.m_InsideIndices[numberOfInsideIndices++] = inputIndices[i];
+      }
+    }
+
+  if ( numberOfInsideIndices > 0 )
+    {
+    m_Interpolator->EvaluateAtContinuousIndices(&buffers.m_InsideIndices[0],
+                                                &buffers.m_InsideValues[0],
+                                                numberOfInsideIndices);
+    }
+
+  SizeValueType insideIndex = 0;
+  for ( SizeValueType i = 0; i < lineLength; ++i )
+    {
+    // Copy the input at right position to the output
+    if ( buffers.m_IsInside[i] )
+      {
+      outIt.Set( this->CastPixelWithBoundsChecking( buffers.m_InsideValues[insideIndex++],
+                                                    minOutputValue, maxOutputValue ) );
+      }
+    else
+      {
+      if( m_Extrapolator.IsNull() )
+        {
+        outIt.Set( m_DefaultPixelValue ); // default background value
+        }
+      else
+        {
+        const InterpolatorOutputType value = m_Extrapolator->EvaluateAtContinuousIndex( inputIndices[i] );
+        outIt.Set( this->CastPixelWithBoundsChecking( value, minOutputValue, maxOutputValue ) );
+        }
+      }
+
+    progress.CompletedPixel();
+    ++outIt;
+    }
+}
+
 /**
  * NonlinearThreadedGenerateData
  */
@@ -302,67 +375,83 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   InputImageConstPointer inputPtr = this->GetInput();
 
   // Create an iterator that will walk the output region for this thread.
-  typedef ImageRegionIteratorWithIndex< TOutputImage > OutputIterator;
+  typedef ImageScanlineIterator< TOutputImage > OutputIterator;
   OutputIterator outIt(outputPtr, outputRegionForThread);
 
-  // Define a few indices that will be used to translate from an input pixel
-  // to an output pixel
-  PointType outputPoint;         // Coordinates of current output pixel
-  PointType inputPoint;          // Coordinates of current input pixel
-
-  ContinuousInputIndexType inputIndex;
+  // The points of a line of the output region, and their images by the
+  // transform, which transforms the whole line at once.
+  typedef typename TransformType::InputPointType  TransformInputPointType;
+  typedef typename TransformType::OutputPointType TransformOutputPointType;
+  const SizeValueType                     lineLength = outputRegionForThread.GetSize(0);
+  std::vector< TransformInputPointType >  outputPoints(lineLength);
+  std::vector< TransformOutputPointType > inputPoints(lineLength);
+
+  // The points of a line are computed from the contribution of the
+  // dimensions above the first one, summed once per line in the same
+  // order as in ImageBase::TransformIndexToPhysicalPoint(), so that they
+  // are the same.  The index to point mapping of a SpecialCoordinatesImage
+  // is not linear, so each of its points is computed by the image.
+  typedef SpecialCoordinatesImage< PixelType, ImageDimension > OutputSpecialCoordinatesImageType;
+  const bool isSpecialCoordinatesImage =
+    dynamic_cast< const OutputSpecialCoordinatesImageType * >( outputPtr.GetPointer() ) != 0;
+  const DirectionType &   indexToPhysicalPoint = outputPtr->GetIndexToPhysicalPoint();
+  const OriginPointType & origin = outputPtr->GetOrigin();
+
+  // The continuous indices in the input image of the points of a line.
+  std::vector< ContinuousInputIndexType > inputIndices(lineLength);
+  LineBuffers                             buffers;
 
   // Support for progress methods/callbacks
   ProgressReporter progress( this,
                              threadId,
                              outputRegionForThread.GetNumberOfPixels() );
 
-  // Min/max values of the output pixel type AND these values
-  // represented as the output type of the interpolator
-  const PixelComponentType minValue =  NumericTraits< PixelComponentType >::NonpositiveMin();
-  const PixelComponentType maxValue =  NumericTraits< PixelComponentType >::max();
-
-  typedef typename InterpolatorType::OutputType OutputType;
-  const ComponentType minOutputValue = static_cast< ComponentType >( minValue );
-  const ComponentType maxOutputValue = static_cast< ComponentType >( maxValue );
-
   // Walk the output region
   outIt.GoToBegin();
 
   while ( !outIt.IsAtEnd() )
     {
-    // Determine the index of the current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    inputPoint = this->m_Transform->TransformPoint(outputPoint);
-    inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
-
-    PixelType        pixval;
-    OutputType       value;
-    // Evaluate input at right position and copy to the output
-    if ( m_Interpolator->IsInsideBuffer(inputIndex) )
+    // Determine the physical points of the pixels of the line
+    const IndexType lineIndex = outIt.GetIndex();
+    if ( isSpecialCoordinatesImage )
       {
-      value = m_Interpolator ->EvaluateAtContinuousIndex(inputIndex);
-      pixval = this->CastPixelWithBoundsChecking( value, minOutputValue, maxOutputValue );
-      outIt.Set(pixval);
+      IndexType index = lineIndex;
+      for ( SizeValueType i = 0; i < lineLength; ++i, ++index[0] )
+        {
+        outputPtr->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+        }
       }
     else
       {
-      if( m_Extrapolator.IsNull() )
+      TransformInputPointType lineOrigin;
+      for ( unsigned int r = 0; r < ImageDimension; ++r )
         {
-        outIt.Set( m_DefaultPixelValue ); // default background value
+        lineOrigin[r] = origin[r];
+        for ( unsigned int c = ImageDimension - 1; c > 0; --c )
+          {
+          lineOrigin[r] = lineOrigin[r] + indexToPhysicalPoint[r][c] * lineIndex[c];
+          }
         }
-      else
+      for ( SizeValueType i = 0; i < lineLength; ++i )
         {
-        value = m_Extrapolator->EvaluateAtContinuousIndex( inputIndex );
-        pixval = this->CastPixelWithBoundsChecking( value, minOutputValue, maxOutputValue );
-        outIt.Set(pixval);
+        const IndexValueType index0 = lineIndex[0] + static_cast< IndexValueType >( i );
+        for ( unsigned int r = 0; r < ImageDimension; ++r )
+          {
+          outputPoints[i][r] = lineOrigin[r] + indexToPhysicalPoint[r][0] * index0;
+          }
         }
       }
 
-    progress.CompletedPixel();
-    ++outIt;
+    // Compute corresponding input pixel positions
+    this->m_Transform->TransformPoints(&outputPoints[0], &inputPoints[0], lineLength);
+
+    for ( SizeValueType i = 0; i < lineLength; ++i )
+      {
+      inputPtr->TransformPhysicalPointToContinuousIndex(inputPoints[i], inputIndices[i]);
+      }
+
+    this->ResampleLine(outIt, &inputIndices[0], buffers, progress);
+    outIt.NextLine();
     }
 
   return;
@@ -387,10 +476,9 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   InputImageConstPointer inputPtr = this->GetInput();
 
   // Create an iterator that will walk the output region for this thread.
-  typedef ImageLinearIteratorWithIndex< TOutputImage > OutputIterator;
+  typedef ImageScanlineIterator< TOutputImage > OutputIterator;
 
   OutputIterator outIt(outputPtr, outputRegionForThread);
-  outIt.SetDirection(0);
 
   // Define a few indices that will be used to translate from an input pixel
   // to an output pixel
@@ -402,6 +490,11 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
   ContinuousInputIndexType inputIndex;
   ContinuousInputIndexType tmpInputIndex;
 
+  // The continuous indices in the input image of the points of a line.
+  const SizeValueType                     lineLength = outputRegionForThread.GetSize(0);
+  std::vector< ContinuousInputIndexType > inputIndices(lineLength);
+  LineBuffers                             buffers;
+
   typedef typename PointType::VectorType VectorType;
   VectorType delta;          // delta in input continuous index coordinate frame
 
@@ -412,20 +505,6 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
                              threadId,
                              outputRegionForThread.GetNumberOfPixels() );
 
-  typedef typename InterpolatorType::OutputType OutputType;
-
-  // Cache information from the superclass
-  PixelType defaultValue = this->GetDefaultPixelValue();
-
-  // Min/max values of the output pixel type AND these values
-  // represented as the output type of the interpolator
-  const PixelComponentType minValue =  NumericTraits< PixelComponentType >::NonpositiveMin();
-  const PixelComponentType maxValue =  NumericTraits< PixelComponentType >::max();
-
-  typedef typename InterpolatorType::OutputType OutputType;
-  const ComponentType minOutputValue = static_cast< ComponentType >( minValue );
-  const ComponentType maxOutputValue = static_cast< ComponentType >( maxValue );
-
   // Determine the position of the first pixel in the scanline
   index = outIt.GetIndex();
   outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
@@ -472,35 +551,13 @@ ResampleImageFilter< TInputImage, TOutputImage, TInterpolatorPrecisionType >
     inputPoint = this->m_Transform->TransformPoint(outputPoint);
     inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
 
-    while ( !outIt.IsAtEndOfLine() )
+    for ( SizeValueType i = 0; i < lineLength; ++i )
       {
-      PixelType  pixval;
-      OutputType value;
-      // Evaluate input at right position and copy to the output
-      if ( m_Interpolator->IsInsideBuffer(inputIndex) )
-        {
-        value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-        pixval = this->CastPixelWithBoundsChecking( value, minOutputValue, maxOutputValue );
-        outIt.Set(pixval);
-        }
-      else
-        {
-        if( m_Extrapolator.IsNull() )
-          {
-          outIt.Set(defaultValue); // default background value
-          }
-        else
-          {
-          value = m_Extrapolator->EvaluateAtContinuousIndex( inputIndex );
-          pixval = this->CastPixelWithBoundsChecking( value, minOutputValue, maxOutputValue );
-          outIt.Set(pixval);
-          }
-        }
-
-      progress.CompletedPixel();
-      ++outIt;
+      inputIndices[i] = inputIndex;
       inputIndex += delta;
       }
+
+    this->ResampleLine(outIt, &inputIndices[0], buffers, progress);
     outIt.NextLine();
     } //while( !outIt.IsAtEnd() )
 
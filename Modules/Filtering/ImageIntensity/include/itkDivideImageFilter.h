@@ -130,7 +130,7 @@ protected:
   DivideImageFilter() {}
   virtual ~DivideImageFilter() {}
 
-  void GenerateData()
+  void BeforeThreadedGenerateData()
     {
     const typename Superclass::DecoratedInput2ImagePixelType *input
        = dynamic_cast< const typename Superclass::DecoratedInput2ImagePixelType * >(
@@ -139,10 +139,6 @@ protected:
       {
       itkGenericExceptionMacro(<<"The constant value used as denominator should not be set to zero");
       }
-    else
-      {
-      Superclass::GenerateData();
-      }
     }
 
 private:
@@ -21,6 +21,7 @@
 #include "itkInPlaceImageFilter.h"
 #include "itkImageIterator.h"
 #include "itkArray.h"
+#include "itkFunctorFusionStage.h"
 
 namespace itk
 {
@@ -34,13 +35,17 @@ namespace itk
  *
  * All the input images must be of the same type.
  *
+ * The filter implements FunctorFusionStage, so it can be part of a chain
+ * executed in a single pass by FunctorFusionImageFilter.
+ *
  * \ingroup IntensityImageFilters MultiThreaded
  * \ingroup ITKImageIntensity
  */
 
 template< class TInputImage, class TOutputImage, class TFunction >
 class ITK_EXPORT NaryFunctorImageFilter:
-  public InPlaceImageFilter< TInputImage, TOutputImage >
+  public InPlaceImageFilter< TInputImage, TOutputImage >,
+  public FunctorFusionStage< TOutputImage::ImageDimension >
 
 {
 public:
@@ -88,6 +93,27 @@ public:
       }
   }
 
+  /** FunctorFusionStage interface.  Null inputs are skipped, as in
+   * ThreadedGenerateData(). */
+  typedef FunctorFusionStage< TOutputImage::ImageDimension > FusionStageType;
+  typedef typename FusionStageType::FusionIndexType          FusionIndexType;
+
+  virtual bool CanFuse() const;
+
+  virtual unsigned int GetNumberOfFusionInputs() const;
+
+  virtual const DataObject * GetFusionInput(unsigned int input) const;
+
+  virtual void BeforeFusedGenerateData();
+
+  virtual const void * GetFusionInputLine(unsigned int input, const FusionIndexType & index) const;
+
+  virtual void * AllocateFusionLine(SizeValueType length) const;
+
+  virtual void ReleaseFusionLine(void *line) const;
+
+  virtual void EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length);
+
   /** ImageDimension constants */
   itkStaticConstMacro(
     InputImageDimension, unsigned int, TInputImage::ImageDimension);
@@ -110,6 +110,109 @@ NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
     delete ( *regionIterators++ );
     }
 }
+
+template< class TInputImage, class TOutputImage, class TFunction >
+bool
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::CanFuse() const
+{
+  return this->GetNumberOfFusionInputs() > 0
+         && typeid( TInputImage ) == typeid( Image< InputImagePixelType, InputImageDimension > )
+         && typeid( TOutputImage ) == typeid( Image< OutputImagePixelType, OutputImageDimension > )
+         && InputImageDimension == OutputImageDimension;
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+unsigned int
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::GetNumberOfFusionInputs() const
+{
+  unsigned int numberOfValidInputImages = 0;
+
+  for ( unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i )
+    {
+    if ( dynamic_cast< const TInputImage * >( ProcessObject::GetInput(i) ) )
+      {
+      ++numberOfValidInputImages;
+      }
+    }
+  return numberOfValidInputImages;
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+const DataObject *
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::GetFusionInput(unsigned int input) const
+{
+  for ( unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i )
+    {
+    const TInputImage *inputPtr = dynamic_cast< const TInputImage * >( ProcessObject::GetInput(i) );
+    if ( inputPtr && input-- == 0 )
+      {
+      return inputPtr;
+      }
+    }
+  return NULL;
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::BeforeFusedGenerateData()
+{
+  this->BeforeThreadedGenerateData();
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+const void *
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::GetFusionInputLine(unsigned int input, const FusionIndexType & index) const
+{
+  const TInputImage *inputPtr = static_cast< const TInputImage * >( this->GetFusionInput(input) );
+
+  return inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(index);
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void *
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::AllocateFusionLine(SizeValueType length) const
+{
+  return new OutputImagePixelType[length];
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::ReleaseFusionLine(void *line) const
+{
+  delete[] static_cast< OutputImagePixelType * >( line );
+}
+
+template< class TInputImage, class TOutputImage, class TFunction >
+void
+NaryFunctorImageFilter< TInputImage, TOutputImage, TFunction >
+::EvaluateFusionLine(const void *const *inputs, void *output, SizeValueType length)
+{
+  const unsigned int numberOfValidInputImages = this->GetNumberOfFusionInputs();
+
+  std::vector< const InputImagePixelType * > inputLines(numberOfValidInputImages);
+  for ( unsigned int j = 0; j < numberOfValidInputImages; ++j )
+    {
+    inputLines[j] = static_cast< const InputImagePixelType * >( inputs[j] );
+    }
+  OutputImagePixelType *outputLine = static_cast< OutputImagePixelType * >( output );
+
+  NaryArrayType naryInputArray(numberOfValidInputImages);
+  for ( SizeValueType i = 0; i < length; ++i )
+    {
+    for ( unsigned int j = 0; j < numberOfValidInputImages; ++j )
+      {
+      naryInputArray[j] = inputLines[j][i];
+      }
+    outputLine[i] = m_Functor(naryInputArray);
+    }
+}
 } // end namespace itk
 
 #endif
@@ -140,6 +140,10 @@ public:
   /** Process to execute before entering the multithreaded section */
   void BeforeThreadedGenerateData(void);
 
+  /** The functor is computed from the input pixels, which a fused pass
+   * never produces. */
+  virtual bool CanFuse() const { return false; }
+
   /** Print internal ivars */
   void PrintSelf(std::ostream & os, Indent indent) const;
 
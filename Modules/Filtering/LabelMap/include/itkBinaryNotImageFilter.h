@@ -145,11 +145,10 @@ protected:
                     << std::endl;
     }
 
-  void GenerateData()
+  void BeforeThreadedGenerateData()
     {
     this->GetFunctor().m_ForegroundValue = m_ForegroundValue;
     this->GetFunctor().m_BackgroundValue = m_BackgroundValue;
-    Superclass::GenerateData();
     }
 
 private:
@@ -135,8 +135,9 @@ public:
    * memory. */
   virtual void Initialize();
 
-  /**  */
-  virtual void Allocate();
+  /** Allocate the label map.  A label map is always initialized
+   * to an empty set of label objects. */
+  virtual void Allocate(bool initializePixels = false);
 
   virtual void Graft(const DataObject *data);
 
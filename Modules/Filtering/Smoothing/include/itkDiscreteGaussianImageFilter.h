@@ -20,6 +20,9 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
+#include "itkGaussianOperator.h"
+#include "itkIsSame.h"
+#include "itkProgressAccumulator.h"
 
 namespace itk
 {
@@ -43,6 +46,11 @@ namespace itk
  * When the Gaussian kernel is small, this filter tends to run faster than
  * itk::RecursiveGaussianImageFilter.
  *
+ * Images of scalars are convolved by a SeparableConvolutionImageFilter,
+ * which applies the kernels of all the dimensions plane by plane without
+ * intermediate image.  Images of vectors go through a streamed
+ * mini-pipeline of NeighborhoodOperatorImageFilter, one per dimension.
+ *
  * \sa GaussianOperator
  * \sa Image
  * \sa Neighborhood
@@ -207,7 +215,9 @@ public:
    * The default value is $ImageDimension^2$.
    *
    * This parameter was introduced to reduce the memory used by images
-   * internally, at the cost of performance.
+   * internally, at the cost of performance.  It only applies to images
+   * of vectors: images of scalars are filtered without intermediate
+   * image.
    */
   itkSetMacro(InternalNumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(InternalNumberOfStreamDivisions, unsigned int);
@@ -245,15 +255,35 @@ protected:
 
   /** Standard pipeline method. While this class does not implement a
    * ThreadedGenerateData(), its GenerateData() delegates all
-   * calculations to an NeighborhoodOperatorImageFilter.  Since the
-   * NeighborhoodOperatorImageFilter is multithreaded, this filter is
-   * multithreaded by default. */
+   * calculations to a SeparableConvolutionImageFilter or to
+   * NeighborhoodOperatorImageFilters.  Since these filters are
+   * multithreaded, this filter is multithreaded by default. */
   void GenerateData();
 
 private:
   DiscreteGaussianImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);              //purposely not implemented
 
+  /** Type of the pixel values of the intermediate results, and of the
+   * kernels. */
+  typedef typename NumericTraits< OutputPixelType >::RealType         RealOutputPixelType;
+  typedef typename NumericTraits< RealOutputPixelType >::ValueType    RealOutputPixelValueType;
+  typedef GaussianOperator< RealOutputPixelValueType, ImageDimension > OperatorType;
+
+  /** Convolve an image of scalars with the operators.  The overload
+   * chosen for images of vectors does nothing and returns false. */
+  bool GenerateDataWithSeparableConvolution(const InputImageType *input,
+                                            const std::vector< OperatorType > & oper,
+                                            ProgressAccumulator *progress,
+                                            TrueType, TrueType);
+
+  template< class TInputIsScalar, class TOutputIsScalar >
+  bool GenerateDataWithSeparableConvolution(const InputImageType *,
+                                            const std::vector< OperatorType > &,
+                                            ProgressAccumulator *,
+                                            TInputIsScalar, TOutputIsScalar)
+  { return false; }
+
   /** The variance of the gaussian blurring kernel in each dimensional
     direction. */
   ArrayType m_Variance;
@@ -20,9 +20,8 @@
 
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkNeighborhoodOperatorImageFilter.h"
-#include "itkGaussianOperator.h"
 #include "itkImageRegionIterator.h"
-#include "itkProgressAccumulator.h"
+#include "itkSeparableConvolutionImageFilter.h"
 #include "itkStreamingImageFilter.h"
 
 namespace itk
@@ -153,11 +152,8 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
     return;
     }
 
-  // Type of the pixel to use for intermediate results
-  typedef typename NumericTraits< OutputPixelType >::RealType RealOutputPixelType;
-  typedef Image< OutputPixelType, ImageDimension >            RealOutputImageType;
-
-  typedef typename NumericTraits<RealOutputPixelType>::ValueType RealOutputPixelValueType;
+  // Type of the image to use for intermediate results
+  typedef Image< OutputPixelType, ImageDimension > RealOutputImageType;
 
   // Type definition for the internal neighborhood filter
   //
@@ -186,8 +182,6 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
   typedef typename StreamingFilterType::Pointer    StreamingFilterPointer;
 
   // Create a series of operators
-  typedef GaussianOperator< RealOutputPixelValueType, ImageDimension > OperatorType;
-
   std::vector< OperatorType > oper;
   oper.resize(filterDimensionality);
 
@@ -229,6 +223,14 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
     oper[reverse_i].CreateDirectional();
     }
 
+  // Images of scalars are convolved in one pass
+  if ( this->GenerateDataWithSeparableConvolution( localInput, oper, progress,
+                                                   typename IsSame< InputPixelType, InputPixelValueType >::Type(),
+                                                   typename IsSame< OutputPixelType, OutputPixelValueType >::Type() ) )
+    {
+    return;
+    }
+
   // Create a chain of filters
   //
   //
@@ -328,6 +330,36 @@ DiscreteGaussianImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< class TInputImage, class TOutputImage >
+bool
+DiscreteGaussianImageFilter< TInputImage, TOutputImage >
+::GenerateDataWithSeparableConvolution(const InputImageType *input,
+                                       const std::vector< OperatorType > & oper,
+                                       ProgressAccumulator *progress,
+                                       TrueType, TrueType)
+{
+  typedef SeparableConvolutionImageFilter< InputImageType, OutputImageType,
+                                           RealOutputPixelValueType > ConvolutionFilterType;
+
+  typename ConvolutionFilterType::Pointer convolutionFilter = ConvolutionFilterType::New();
+  for ( unsigned int i = 0; i < oper.size(); ++i )
+    {
+    convolutionFilter->SetOperator(oper[i]);
+    }
+  convolutionFilter->SetInput(input);
+  convolutionFilter->SetNumberOfThreads( this->GetNumberOfThreads() );
+  progress->RegisterInternalFilter(convolutionFilter, 1.0f);
+
+  // Graft this filters output onto the mini-pipeline so that the
+  // convolution writes to this filters bulk data output, and graft it
+  // back for the region ivars.
+  convolutionFilter->GraftOutput( this->GetOutput() );
+  convolutionFilter->Update();
+  this->GraftOutput( convolutionFilter->GetOutput() );
+
+  return true;
+}
+
 template< class TInputImage, class TOutputImage >
 void
 DiscreteGaussianImageFilter< TInputImage, TOutputImage >
@@ -19,6 +19,7 @@
 #define __itkMeanImageFilter_h
 
 #include "itkBoxImageFilter.h"
+#include "itkSummedAreaTable.h"
 #include "itkImage.h"
 #include "itkNumericTraits.h"
 
@@ -81,6 +82,16 @@ public:
 
   typedef typename InputImageType::SizeType InputSizeType;
 
+  /** Set/Get whether the sums over the neighborhoods are read from
+   * summed area tables, in constant time per pixel whatever the radius,
+   * instead of being updated as the neighborhood slides along the lines
+   * of the image.  The tables are the faster for the larger radii.  Off by
+   * default.
+   * \sa SummedAreaTable */
+  itkSetMacro(UseSummedAreaTable, bool);
+  itkGetConstMacro(UseSummedAreaTable, bool);
+  itkBooleanMacro(UseSummedAreaTable);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro( InputHasNumericTraitsCheck,
@@ -90,6 +101,7 @@ public:
 protected:
   MeanImageFilter();
   virtual ~MeanImageFilter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
 
   /** MeanImageFilter can be implemented as a multithreaded filter.
    * Therefore, this implementation provides a ThreadedGenerateData()
@@ -107,6 +119,32 @@ protected:
 private:
   MeanImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);  //purposely not implemented
+
+  /** Running sum of the pixels of the neighborhood. */
+  class SumAccumulator
+  {
+public:
+    SumAccumulator(SizeValueType numberOfPixels):m_NumberOfPixels(numberOfPixels) {}
+    void Reset() { m_Sum = NumericTraits< InputRealType >::Zero; }
+    void Add(const InputPixelType & value) { m_Sum += static_cast< InputRealType >( value ); }
+    void Remove(const InputPixelType & value) { m_Sum -= static_cast< InputRealType >( value ); }
+    InputRealType GetValue(const InputPixelType &) const
+    { return m_Sum / double(m_NumberOfPixels); }
+
+private:
+    InputRealType m_Sum;
+    SizeValueType m_NumberOfPixels;
+  };
+
+  /** Mean of the box read from the summed area tables. */
+  class MeanFunction
+  {
+public:
+    InputRealType operator()(const typename SummedAreaTable< InputImageType >::BoxStatistics & box) const
+    { return box.GetMean(); }
+  };
+
+  bool m_UseSummedAreaTable;
 };
 } // end namespace itk
 
@@ -19,18 +19,14 @@
 #define __itkMeanImageFilter_hxx
 #include "itkMeanImageFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkImageRegionIterator.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkOffset.h"
-#include "itkProgressReporter.h"
+#include "itkNeighborhoodRegionWalker.h"
 
 namespace itk
 {
 template< class TInputImage, class TOutputImage >
 MeanImageFilter< TInputImage, TOutputImage >
-::MeanImageFilter()
+::MeanImageFilter():
+  m_UseSummedAreaTable(false)
 {}
 
 template< class TInputImage, class TOutputImage >
@@ -39,56 +35,31 @@ MeanImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  unsigned int i;
-
-  ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
-
-  ConstNeighborhoodIterator< InputImageType > bit;
-  ImageRegionIterator< OutputImageType >      it;
-
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename  InputImageType::ConstPointer input  = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC( input, outputRegionForThread, this->GetRadius() );
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
-
   // support progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  InputRealType sum;
-
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
+  if ( m_UseSummedAreaTable )
     {
-    bit = ConstNeighborhoodIterator< InputImageType >(this->GetRadius(),
-                                                      input, *fit);
-    unsigned int neighborhoodSize = bit.Size();
-    it = ImageRegionIterator< OutputImageType >(output, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
+    SummedAreaTable< InputImageType > table( this->GetInput(), this->GetRadius() );
+    MeanFunction function;
+    table.ComputeFromBoxes(this->GetOutput(), outputRegionForThread, function, progress);
+    return;
+    }
 
-    while ( !bit.IsAtEnd() )
-      {
-      sum = NumericTraits< InputRealType >::Zero;
-      for ( i = 0; i < neighborhoodSize; ++i )
-        {
-        sum += static_cast< InputRealType >( bit.GetPixel(i) );
-        }
+  // The sum is updated as the neighborhood slides along the lines.
+  NeighborhoodRegionWalker< InputImageType > walker( this->GetInput(), this->GetRadius() );
+  SumAccumulator                             sum( walker.GetNeighborhoodSize() );
+  walker.ComputeFromSlidingWindow(this->GetOutput(), outputRegionForThread, sum, progress);
+}
 
-      // get the mean value
-      it.Set( static_cast< OutputPixelType >( sum / double(neighborhoodSize) ) );
+template< class TInputImage, class TOutputImage >
+void
+MeanImageFilter< TInputImage, TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
 
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
-      }
-    }
+  os << indent << "UseSummedAreaTable: " << ( m_UseSummedAreaTable ? "On" : "Off" ) << std::endl;
 }
 } // end namespace itk
 
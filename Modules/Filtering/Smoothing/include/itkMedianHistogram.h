@@ -0,0 +1,257 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkMedianHistogram_h
+#define __itkMedianHistogram_h
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include "itkIntTypes.h"
+#include "itkNumericTraits.h"
+
+namespace itk
+{
+namespace Function
+{
+/** \class MedianHistogram
+ * \brief Median of a window of pixels updated as the window slides.
+ *
+ * The histogram follows the interface of the accumulators of
+ * NeighborhoodRegionWalker::ComputeFromSlidingWindow(): Reset(),
+ * Add(), Remove() and GetValue().  It keeps the median value and the
+ * number of values below it, so that after the window moved by one pixel
+ * the median is found again by a short walk from the previous one.
+ *
+ * This generic version stores the counts in a map and only requires the
+ * pixel type to be LessThanComparable.  The small integer types use a
+ * vector of counts instead; see VectorMedianHistogram.
+ *
+ * The median is the value of rank size / 2, as given by
+ * std::nth_element.
+ *
+ * \ingroup ITKSmoothing
+ */
+template< class TInputPixel >
+class MedianHistogram
+{
+public:
+  typedef std::map< TInputPixel, SizeValueType > MapType;
+
+  MedianHistogram():
+    m_NumberOfValues(0),
+    m_NumberBelow(0)
+  {}
+
+  inline void Reset()
+  {
+    m_Map.clear();
+    m_NumberOfValues = 0;
+    m_NumberBelow = 0;
+  }
+
+  inline void Add(const TInputPixel & p)
+  {
+    const typename MapType::iterator it = m_Map.insert( typename MapType::value_type(p, 0) ).first;
+    ++it->second;
+    if ( m_NumberOfValues == 0 )
+      {
+      m_Median = it;
+      }
+    else if ( p < m_Median->first )
+      {
+      ++m_NumberBelow;
+      }
+    ++m_NumberOfValues;
+  }
+
+  inline void Remove(const TInputPixel & p)
+  {
+    // The entries are kept when their count drops to zero, so that
+    // m_Median stays valid; Reset() clears them.
+    --m_Map.find(p)->second;
+    if ( p < m_Median->first )
+      {
+      --m_NumberBelow;
+      }
+    --m_NumberOfValues;
+  }
+
+  inline TInputPixel GetValue(const TInputPixel &)
+  {
+    const SizeValueType rank = m_NumberOfValues / 2;
+    while ( m_NumberBelow > rank )
+      {
+      --m_Median;
+      m_NumberBelow -= m_Median->second;
+      }
+    while ( m_NumberBelow + m_Median->second <= rank )
+      {
+      m_NumberBelow += m_Median->second;
+      ++m_Median;
+      }
+    return m_Median->first;
+  }
+
+  static bool UseVectorBasedAlgorithm()
+  {
+    return false;
+  }
+
+private:
+  // m_Median points into m_Map.
+  MedianHistogram(const MedianHistogram &); //purposely not implemented
+  void operator=(const MedianHistogram &);  //purposely not implemented
+
+  MapType                     m_Map;
+  typename MapType::iterator  m_Median;
+  SizeValueType               m_NumberOfValues;
+  SizeValueType               m_NumberBelow;
+};
+
+/** \class VectorMedianHistogram
+ * \brief MedianHistogram storing the counts in a vector indexed by the
+ * pixel values.
+ *
+ * Used for the integer types of 8 and 16 bits.  Reset() only clears the
+ * range of values added since the previous reset.
+ *
+ * \ingroup ITKSmoothing
+ */
+template< class TInputPixel >
+class VectorMedianHistogram
+{
+public:
+  VectorMedianHistogram():
+    m_Counts(NumericTraits< TInputPixel >::max() - NumericTraits< TInputPixel >::NonpositiveMin() + 1, 0),
+    m_Median(0),
+    m_Minimum(0),
+    m_Maximum(0),
+    m_NumberOfValues(0),
+    m_NumberBelow(0)
+  {}
+
+  inline void Reset()
+  {
+    std::fill(m_Counts.begin() + m_Minimum, m_Counts.begin() + m_Maximum + 1, 0);
+    m_NumberOfValues = 0;
+    m_NumberBelow = 0;
+  }
+
+  inline void Add(const TInputPixel & p)
+  {
+    const SizeValueType bin = Bin(p);
+    ++m_Counts[bin];
+    if ( m_NumberOfValues == 0 )
+      {
+      m_Median = bin;
+      m_Minimum = bin;
+      m_Maximum = bin;
+      }
+    else
+      {
+      m_NumberBelow += ( bin < m_Median );
+      m_Minimum = std::min(m_Minimum, bin);
+      m_Maximum = std::max(m_Maximum, bin);
+      }
+    ++m_NumberOfValues;
+  }
+
+  inline void Remove(const TInputPixel & p)
+  {
+    const SizeValueType bin = Bin(p);
+    --m_Counts[bin];
+    m_NumberBelow -= ( bin < m_Median );
+    --m_NumberOfValues;
+  }
+
+  inline TInputPixel GetValue(const TInputPixel &)
+  {
+    const SizeValueType rank = m_NumberOfValues / 2;
+    while ( m_NumberBelow > rank )
+      {
+      --m_Median;
+      m_NumberBelow -= m_Counts[m_Median];
+      }
+    while ( m_NumberBelow + m_Counts[m_Median] <= rank )
+      {
+      m_NumberBelow += m_Counts[m_Median];
+      ++m_Median;
+      }
+    return static_cast< TInputPixel >( m_Median + NumericTraits< TInputPixel >::NonpositiveMin() );
+  }
+
+  static bool UseVectorBasedAlgorithm()
+  {
+    return true;
+  }
+
+private:
+  static SizeValueType Bin(const TInputPixel & p)
+  {
+    return static_cast< SizeValueType >( p - NumericTraits< TInputPixel >::NonpositiveMin() );
+  }
+
+  std::vector< SizeValueType > m_Counts;
+  SizeValueType                m_Median;
+  SizeValueType                m_Minimum;
+  SizeValueType                m_Maximum;
+  SizeValueType                m_NumberOfValues;
+  SizeValueType                m_NumberBelow;
+};
+
+/** \cond HIDE_SPECIALIZATION_DOCUMENTATION */
+
+// now create MedianHistogram specializations using the
+// VectorMedianHistogram as base class
+
+template<>
+class MedianHistogram< unsigned char >:
+  public VectorMedianHistogram< unsigned char >
+{
+};
+
+template<>
+class MedianHistogram< signed char >:
+  public VectorMedianHistogram< signed char >
+{
+};
+
+template<>
+class MedianHistogram< char >:
+  public VectorMedianHistogram< char >
+{
+};
+
+template<>
+class MedianHistogram< unsigned short >:
+  public VectorMedianHistogram< unsigned short >
+{
+};
+
+template<>
+class MedianHistogram< short >:
+  public VectorMedianHistogram< short >
+{
+};
+
+/** \endcond */
+
+} // end namespace Function
+} // end namespace itk
+
+#endif
@@ -20,6 +20,10 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "itkMedianHistogram.h"
+#include "itkMedianSortingNetwork.h"
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -35,6 +39,24 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * The median can be computed in several ways, selected with
+ * SetAlgorithm():
+ * - NthElement copies each neighborhood and partially sorts it with
+ *   std::nth_element.
+ * - SortingNetwork runs a branch free sorting network pruned to the
+ *   median (see Function::MedianSortingNetwork).  It is the fastest for
+ *   real pixels up to the 5x5x5 neighborhood.
+ * - MovingHistogram slides a histogram of the neighborhood along the
+ *   lines of the image (see Function::MedianHistogram), so that the cost
+ *   per pixel grows with the size of a face of the neighborhood instead
+ *   of its volume.  The histogram is a vector of counts for the integer
+ *   types of 8 and 16 bits, where it is the fastest beyond 3x3, and a
+ *   map for the other types.
+ * - Automatic, the default, picks one of the above from the pixel type
+ *   and the radius.
+ *
+ * All the algorithms give the same result.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -84,6 +106,18 @@ public:
 
   typedef typename InputImageType::SizeType InputSizeType;
 
+  /** Algorithms computing the median. */
+  typedef enum { Automatic, NthElement, SortingNetwork, MovingHistogram } AlgorithmType;
+
+  /** Set/Get the algorithm computing the median.  Defaults to
+   * Automatic. */
+  itkSetMacro(Algorithm, AlgorithmType);
+  itkGetConstMacro(Algorithm, AlgorithmType);
+
+  /** The algorithm used with the current radius and pixel type: the
+   * selected one, or the one Automatic resolves to. */
+  AlgorithmType GetAlgorithmInUse() const;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro( SameDimensionCheck,
@@ -97,6 +131,7 @@ public:
 protected:
   MedianImageFilter();
   virtual ~MedianImageFilter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const;
 
   /** MedianImageFilter can be implemented as a multithreaded filter.
    * Therefore, this implementation provides a ThreadedGenerateData()
@@ -114,6 +149,24 @@ protected:
 private:
   MedianImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);    //purposely not implemented
+
+  /** Median of the values of a neighborhood. */
+  class MedianFunction
+  {
+public:
+    InputPixelType operator()(std::vector< InputPixelType > & values) const
+    {
+      // All of our neighborhoods have an odd number of pixels, so there is
+      // always a median index (if there where an even number of pixels
+      // in the neighborhood we have to average the middle two values).
+      const typename std::vector< InputPixelType >::iterator medianIterator =
+        values.begin() + values.size() / 2;
+      std::nth_element( values.begin(), medianIterator, values.end() );
+      return *medianIterator;
+    }
+  };
+
+  AlgorithmType m_Algorithm;
 };
 } // end namespace itk
 
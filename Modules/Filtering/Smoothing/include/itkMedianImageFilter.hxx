@@ -19,81 +19,92 @@
 #define __itkMedianImageFilter_hxx
 #include "itkMedianImageFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkImageRegionIterator.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkOffset.h"
-#include "itkProgressReporter.h"
-
-#include <vector>
-#include <algorithm>
+#include "itkNeighborhoodRegionWalker.h"
 
 namespace itk
 {
 template< class TInputImage, class TOutputImage >
 MedianImageFilter< TInputImage, TOutputImage >
-::MedianImageFilter()
+::MedianImageFilter():
+  m_Algorithm(Automatic)
 {}
 
+template< class TInputImage, class TOutputImage >
+typename MedianImageFilter< TInputImage, TOutputImage >::AlgorithmType
+MedianImageFilter< TInputImage, TOutputImage >
+::GetAlgorithmInUse() const
+{
+  if ( m_Algorithm != Automatic )
+    {
+    return m_Algorithm;
+    }
+
+  SizeValueType neighborhoodSize = 1;
+  for ( unsigned int i = 0; i < InputImageDimension; ++i )
+    {
+    neighborhoodSize *= 2 * this->GetRadius()[i] + 1;
+    }
+
+  // The vector histograms win as soon as the window slides over a few
+  // pixels, earlier for 8 bits than for 16 bits since there are fewer
+  // bins to walk.  The pruned networks then stay faster than the partial
+  // sort up to the 5x5x5 neighborhood.  The map histograms, slower than
+  // the partial sort in practice, are only used on request.
+  if ( Function::MedianHistogram< InputPixelType >::UseVectorBasedAlgorithm()
+       && this->GetRadius()[0] > 0
+       && neighborhoodSize > ( sizeof( InputPixelType ) == 1 ? 9u : 27u ) )
+    {
+    return MovingHistogram;
+    }
+  if ( neighborhoodSize <= 125 )
+    {
+    return SortingNetwork;
+    }
+  return NthElement;
+}
+
 template< class TInputImage, class TOutputImage >
 void
 MedianImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename  InputImageType::ConstPointer input  = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType
-  faceList = bC( input, outputRegionForThread, this->GetRadius() );
-
   // support progress methods/callbacks
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  // All of our neighborhoods have an odd number of pixels, so there is
-  // always a median index (if there where an even number of pixels
-  // in the neighborhood we have to average the middle two values).
-
-  ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
-  std::vector< InputPixelType >                      pixels;
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator
-        fit = faceList.begin(); fit != faceList.end(); ++fit )
+  NeighborhoodRegionWalker< InputImageType > walker( this->GetInput(), this->GetRadius() );
+  switch ( this->GetAlgorithmInUse() )
     {
-    ImageRegionIterator< OutputImageType > it = ImageRegionIterator< OutputImageType >(output, *fit);
-
-    ConstNeighborhoodIterator< InputImageType > bit =
-      ConstNeighborhoodIterator< InputImageType >(this->GetRadius(), input, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
-    const unsigned int neighborhoodSize = bit.Size();
-    const unsigned int medianPosition = neighborhoodSize / 2;
-    while ( !bit.IsAtEnd() )
+    case SortingNetwork:
       {
-      // collect all the pixels in the neighborhood, note that we use
-      // GetPixel on the NeighborhoodIterator to honor the boundary conditions
-      pixels.resize(neighborhoodSize);
-      for ( unsigned int i = 0; i < neighborhoodSize; ++i )
-        {
-        pixels[i] = ( bit.GetPixel(i) );
-        }
-
-      // get the median value
-      const typename std::vector< InputPixelType >::iterator medianIterator = pixels.begin() + medianPosition;
-      std::nth_element( pixels.begin(), medianIterator, pixels.end() );
-      it.Set( static_cast< typename OutputImageType::PixelType >( *medianIterator ) );
-
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
+      Function::MedianSortingNetwork< InputPixelType > network( walker.GetNeighborhoodSize() );
+      walker.ComputeFromNeighborhoods(this->GetOutput(), outputRegionForThread, network, progress);
+      break;
+      }
+    case MovingHistogram:
+      {
+      Function::MedianHistogram< InputPixelType > histogram;
+      walker.ComputeFromSlidingWindow(this->GetOutput(), outputRegionForThread, histogram, progress);
+      break;
+      }
+    default:
+      {
+      MedianFunction median;
+      walker.ComputeFromNeighborhoods(this->GetOutput(), outputRegionForThread, median, progress);
       }
     }
 }
+
+template< class TInputImage, class TOutputImage >
+void
+MedianImageFilter< TInputImage, TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Algorithm: " << m_Algorithm << std::endl;
+  os << indent << "AlgorithmInUse: " << this->GetAlgorithmInUse() << std::endl;
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkMedianSortingNetwork_h
+#define __itkMedianSortingNetwork_h
+
+#include <algorithm>
+#include <vector>
+#include "itkIntTypes.h"
+
+namespace itk
+{
+namespace Function
+{
+/** \class MedianSortingNetwork
+ * \brief Median of a fixed number of values by a sorting network.
+ *
+ * The network is the merge exchange sort of Batcher (Knuth, The Art of
+ * Computer Programming, vol. 3, algorithm 5.2.2M) for the given number of
+ * values, from which the comparators that do not contribute to the
+ * value of rank size / 2 are removed.  For a 3x3 neighborhood 22
+ * comparators are left, and 113 and 127 for the 5x5 and 3x3x3 ones.
+ *
+ * The sequence of comparisons does not depend on the values and each
+ * comparator compiles to conditional moves or min and max instructions,
+ * so there is no branch to mispredict, as there is in
+ * std::nth_element.
+ *
+ * \ingroup ITKSmoothing
+ */
+template< class TInputPixel >
+class MedianSortingNetwork
+{
+public:
+  MedianSortingNetwork(SizeValueType size):
+    m_Size(size)
+  {
+    // Generate the full network.
+    std::vector< Comparator > network;
+    SizeValueType t = 0;
+    while ( ( static_cast< SizeValueType >( 1 ) << t ) < size )
+      {
+      ++t;
+      }
+    for ( SizeValueType p = ( t > 0 ) ? static_cast< SizeValueType >( 1 ) << ( t - 1 ) : 0; p > 0; p >>= 1 )
+      {
+      SizeValueType q = static_cast< SizeValueType >( 1 ) << ( t - 1 );
+      SizeValueType r = 0;
+      SizeValueType d = p;
+      while ( true )
+        {
+        for ( SizeValueType i = 0; i + d < size; ++i )
+          {
+          if ( ( i & p ) == r )
+            {
+            network.push_back( Comparator( static_cast< unsigned int >( i ), static_cast< unsigned int >( i + d ) ) );
+            }
+          }
+        if ( q == p )
+          {
+          break;
+          }
+        d = q - p;
+        q >>= 1;
+        r = p;
+        }
+      }
+
+    // Keep the comparators the median depends on, walking the network
+    // backward from the output.
+    std::vector< bool > needed(size, false);
+    needed[size / 2] = true;
+    for ( typename std::vector< Comparator >::reverse_iterator it = network.rbegin(); it != network.rend(); ++it )
+      {
+      if ( needed[it->first] || needed[it->second] )
+        {
+        needed[it->first] = true;
+        needed[it->second] = true;
+        m_Comparators.insert(m_Comparators.begin(), *it);
+        }
+      }
+  }
+
+  /** Number of values the network takes. */
+  SizeValueType GetSize() const
+  {
+    return m_Size;
+  }
+
+  /** Number of comparators of the pruned network. */
+  SizeValueType GetNumberOfComparators() const
+  {
+    return m_Comparators.size();
+  }
+
+  /** Median of values, which must have GetSize() elements.  The order
+   * of the values is changed. */
+  inline TInputPixel operator()(std::vector< TInputPixel > & values) const
+  {
+    typename std::vector< TInputPixel >::iterator v = values.begin();
+    for ( typename std::vector< Comparator >::const_iterator c = m_Comparators.begin();
+          c != m_Comparators.end(); ++c )
+      {
+      CompareExchange(v[c->first], v[c->second]);
+      }
+    return v[m_Size / 2];
+  }
+
+private:
+  typedef std::pair< unsigned int, unsigned int > Comparator;
+
+  /** Order a pair of values.  The selections compile to conditional moves
+   * for the integer types; the real types are specialized below to use
+   * the min and max instructions. */
+  static inline void CompareExchange(TInputPixel & x, TInputPixel & y)
+  {
+    const TInputPixel a = x;
+    const TInputPixel b = y;
+    x = ( b < a ) ? b : a;
+    y = ( b < a ) ? a : b;
+  }
+
+  SizeValueType             m_Size;
+  std::vector< Comparator > m_Comparators;
+};
+
+/** \cond HIDE_SPECIALIZATION_DOCUMENTATION */
+
+template<>
+inline void MedianSortingNetwork< float >::CompareExchange(float & x, float & y)
+{
+  const float a = x;
+  const float b = y;
+  x = std::min(a, b);
+  y = std::max(a, b);
+}
+
+template<>
+inline void MedianSortingNetwork< double >::CompareExchange(double & x, double & y)
+{
+  const double a = x;
+  const double b = y;
+  x = std::min(a, b);
+  y = std::max(a, b);
+}
+
+/** \endcond */
+} // end namespace Function
+} // end namespace itk
+
+#endif
@@ -241,7 +241,7 @@ SmoothingRecursiveGaussianImageFilter< TInputImage, TOutputImage >
 
   // If this filter is running in-place, then set the first smoothing
   // filter to steal the bulk data, by running in-place.
-  if ( this->CanRunInPlace() && this->GetInPlace() )
+  if ( this->WillRunInPlace() )
     {
     m_FirstSmoothingFilter->InPlaceOn();
 
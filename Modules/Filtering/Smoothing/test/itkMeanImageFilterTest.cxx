@@ -88,6 +88,29 @@ int itkMeanImageFilterTest(int, char* [] )
   const FloatImage2DType::SizeType & radius = mean->GetRadius();
   std::cout << "mean->GetRadius():" << radius << std::endl;
 
+  // The means read from the summed area tables must match the sliding
+  // window ones
+  itk::MeanImageFilter<FloatImage2DType, FloatImage2DType>::Pointer tableMean;
+  tableMean = itk::MeanImageFilter<FloatImage2DType,FloatImage2DType>::New();
+  tableMean->SetInput(random->GetOutput());
+  tableMean->SetRadius(neighRadius);
+  tableMean->UseSummedAreaTableOn();
+  tableMean->Update();
+  std::cout << tableMean << std::endl;
+
+  itk::ImageRegionIterator<FloatImage2DType> tit;
+  tit = itk::ImageRegionIterator<FloatImage2DType>(tableMean->GetOutput(),
+                                tableMean->GetOutput()->GetBufferedRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++tit)
+    {
+    if (vnl_math_abs(it.Get() - tit.Get()) > 1e-3)
+      {
+      std::cerr << "Summed area table mean " << tit.Get() << " at "
+                << tit.GetIndex() << " differs from " << it.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   return EXIT_SUCCESS;
 }
 
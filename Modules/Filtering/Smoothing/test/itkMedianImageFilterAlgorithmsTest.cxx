@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRandomImageSource.h"
+#include "itkMedianImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+namespace
+{
+// Run every algorithm with the given radius, and check that they all
+// give the result of NthElement.
+template< class TImage >
+bool CompareMedianAlgorithms(const TImage *image, const typename TImage::SizeType & radius)
+{
+  typedef itk::MedianImageFilter< TImage, TImage > FilterType;
+
+  typename FilterType::Pointer reference = FilterType::New();
+  reference->SetInput(image);
+  reference->SetRadius(radius);
+  reference->SetAlgorithm(FilterType::NthElement);
+  reference->Update();
+
+  const typename FilterType::AlgorithmType algorithms[] =
+    { FilterType::SortingNetwork, FilterType::MovingHistogram, FilterType::Automatic };
+  for ( unsigned int a = 0; a < 3; ++a )
+    {
+    typename FilterType::Pointer filter = FilterType::New();
+    filter->SetInput(image);
+    filter->SetRadius(radius);
+    filter->SetAlgorithm(algorithms[a]);
+    filter->Update();
+
+    itk::ImageRegionConstIterator< TImage > rit( reference->GetOutput(), reference->GetOutput()->GetBufferedRegion() );
+    itk::ImageRegionConstIterator< TImage > it( filter->GetOutput(), filter->GetOutput()->GetBufferedRegion() );
+    for ( ; !it.IsAtEnd(); ++it, ++rit )
+      {
+      if ( it.Get() != rit.Get() )
+        {
+        std::cerr << "Algorithm " << algorithms[a] << " with radius " << radius << " gives "
+                  << static_cast< double >( it.Get() ) << " instead of "
+                  << static_cast< double >( rit.Get() ) << " at " << it.GetIndex() << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+template< class TImage >
+typename TImage::Pointer MakeRandomImage(unsigned int size, double maximum)
+{
+  typedef itk::RandomImageSource< TImage > SourceType;
+  typename SourceType::Pointer source = SourceType::New();
+  typename TImage::SizeValueType randomSize[TImage::ImageDimension];
+  for ( unsigned int i = 0; i < TImage::ImageDimension; ++i )
+    {
+    randomSize[i] = size + 3 * i;
+    }
+  source->SetSize(randomSize);
+  source->SetMin(0);
+  source->SetMax(maximum);
+  source->Update();
+  return source->GetOutput();
+}
+}
+
+int itkMedianImageFilterAlgorithmsTest(int, char *[])
+{
+  typedef itk::Image< unsigned char, 2 > CharImageType;
+  typedef itk::Image< short, 3 >         ShortImageType;
+  typedef itk::Image< float, 3 >         FloatImageType;
+
+  // Few distinct values, so that the neighborhoods have many ties.
+  CharImageType::Pointer  charImage = MakeRandomImage< CharImageType >(37, 7);
+  ShortImageType::Pointer shortImage = MakeRandomImage< ShortImageType >(11, 3000);
+  FloatImageType::Pointer floatImage = MakeRandomImage< FloatImageType >(11, 1000);
+
+  CharImageType::SizeType charRadius;
+  for ( unsigned int r = 0; r < 6; ++r )
+    {
+    charRadius[0] = r;
+    charRadius[1] = ( r + 1 ) % 3;
+    if ( !CompareMedianAlgorithms< CharImageType >(charImage, charRadius) )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  ShortImageType::SizeType radius;
+  for ( unsigned int r = 0; r < 4; ++r )
+    {
+    radius[0] = r;
+    radius[1] = 1;
+    radius[2] = r % 2 + 1;
+    if ( !CompareMedianAlgorithms< ShortImageType >(shortImage, radius)
+         || !CompareMedianAlgorithms< FloatImageType >(floatImage, radius) )
+      {
+      return EXIT_FAILURE;
+      }
+    }
+
+  // The automatic choice.
+  typedef itk::MedianImageFilter< ShortImageType, ShortImageType > ShortFilterType;
+  typedef itk::MedianImageFilter< FloatImageType, FloatImageType > FloatFilterType;
+  ShortFilterType::Pointer shortFilter = ShortFilterType::New();
+  FloatFilterType::Pointer floatFilter = FloatFilterType::New();
+  radius.Fill(1);
+  shortFilter->SetRadius(radius);
+  floatFilter->SetRadius(radius);
+  if ( shortFilter->GetAlgorithmInUse() != ShortFilterType::SortingNetwork
+       || floatFilter->GetAlgorithmInUse() != FloatFilterType::SortingNetwork )
+    {
+    std::cerr << "Automatic does not use a sorting network for radius 1" << std::endl;
+    return EXIT_FAILURE;
+    }
+  radius.Fill(2);
+  shortFilter->SetRadius(radius);
+  floatFilter->SetRadius(radius);
+  if ( shortFilter->GetAlgorithmInUse() != ShortFilterType::MovingHistogram
+       || floatFilter->GetAlgorithmInUse() != FloatFilterType::SortingNetwork )
+    {
+    std::cerr << "Unexpected automatic choice for radius 2" << std::endl;
+    return EXIT_FAILURE;
+    }
+  radius.Fill(3);
+  floatFilter->SetRadius(radius);
+  if ( floatFilter->GetAlgorithmInUse() != FloatFilterType::NthElement )
+    {
+    std::cerr << "Unexpected automatic choice for radius 3" << std::endl;
+    return EXIT_FAILURE;
+    }
+  floatFilter->SetAlgorithm(FloatFilterType::SortingNetwork);
+  if ( floatFilter->GetAlgorithmInUse() != FloatFilterType::SortingNetwork )
+    {
+    std::cerr << "The selected algorithm is not used" << std::endl;
+    return EXIT_FAILURE;
+    }
+  floatFilter->Print(std::cout);
+
+  return EXIT_SUCCESS;
+}
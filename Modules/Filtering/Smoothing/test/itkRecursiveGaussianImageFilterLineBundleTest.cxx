@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+// Filtering bundles of lines gives the same result as filtering the
+// lines one at a time.
+int itkRecursiveGaussianImageFilterLineBundleTest(int, char *[])
+{
+  typedef itk::Image< float, 3 >                              ImageType;
+  typedef itk::RecursiveGaussianImageFilter< ImageType >      FilterType;
+
+  // The first size is not a multiple of the bundle sizes.
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 23;
+  size[2] = 11;
+  ImageType::IndexType start;
+  start[0] = -4;
+  start[1] = 7;
+  start[2] = 0;
+  ImageType::RegionType region(start, size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::Statistics::MersenneTwisterRandomVariateGenerator::Pointer random =
+    itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  random->SetSeed(42);
+  for ( itk::ImageRegionIterator< ImageType > it(image, region); !it.IsAtEnd(); ++it )
+    {
+    it.Set( random->GetUniformVariate(0.0, 255.0) );
+    }
+
+  const unsigned int bundleSizes[] = { 16, 5, 64 };
+
+  for ( unsigned int direction = 0; direction < 3; ++direction )
+    {
+    for ( int order = 0; order < 3; ++order )
+      {
+      FilterType::Pointer reference = FilterType::New();
+      reference->SetInput(image);
+      reference->SetDirection(direction);
+      reference->SetSigma(2.5);
+      reference->SetOrder( static_cast< FilterType::OrderEnumType >( order ) );
+      reference->SetLineBundleSize(1);
+      reference->Update();
+
+      for ( unsigned int b = 0; b < sizeof( bundleSizes ) / sizeof( bundleSizes[0] ); ++b )
+        {
+        FilterType::Pointer filter = FilterType::New();
+        filter->SetInput(image);
+        filter->SetDirection(direction);
+        filter->SetSigma(2.5);
+        filter->SetOrder( static_cast< FilterType::OrderEnumType >( order ) );
+        filter->SetLineBundleSize(bundleSizes[b]);
+        filter->SetNumberOfThreads(3);
+        filter->Update();
+
+        itk::ImageRegionConstIterator< ImageType > rt(reference->GetOutput(), region);
+        itk::ImageRegionConstIterator< ImageType > it(filter->GetOutput(), region);
+        for (; !it.IsAtEnd(); ++it, ++rt )
+          {
+          if ( vcl_abs( it.Get() - rt.Get() ) > 1e-4f * ( 1.0f + vcl_abs( rt.Get() ) ) )
+            {
+            std::cerr << "Direction " << direction << ", order " << order
+                      << ", bundles of " << bundleSizes[b] << " lines: " << it.Get()
+                      << " instead of " << rt.Get() << " at " << it.GetIndex() << std::endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
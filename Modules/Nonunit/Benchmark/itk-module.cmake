@@ -0,0 +1,20 @@
+set(DOCUMENTATION "This module contains benchmarks timing representative
+filters, iterators, registration metrics and image readers and writers of the
+toolkit, and comparing the timings against a stored baseline to detect
+performance regressions.")
+
+itk_module(ITKBenchmark
+  TEST_DEPENDS
+    ITKCommon
+    ITKTestKernel
+    ITKImageFunction
+    ITKImageGrid
+    ITKSmoothing
+    ITKMathematicalMorphology
+    ITKMetricsv4
+    ITKIOImageBase
+    ITKIOMeta
+  EXCLUDE_FROM_ALL
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
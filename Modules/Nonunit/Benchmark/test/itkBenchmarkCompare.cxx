@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMacro.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdlib.h>
+
+namespace
+{
+typedef std::map< std::string, double > TimingsType;
+
+// Read the lines written by BenchmarkRecorder::Write(), keyed by the
+// fields identifying each case.
+bool ReadTimings(const char *fileName, TimingsType & timings)
+{
+  std::ifstream file(fileName);
+  if ( !file )
+    {
+    std::cerr << "Cannot read " << fileName << std::endl;
+    return false;
+    }
+
+  std::string line;
+  while ( std::getline(file, line) )
+    {
+    if ( line.empty() || line[0] == '#' )
+      {
+      continue;
+      }
+    const std::string::size_type last = line.rfind('\t');
+    if ( last == std::string::npos )
+      {
+      std::cerr << "Malformed line in " << fileName << ": " << line << std::endl;
+      return false;
+      }
+    timings[line.substr(0, last)] = atof( line.substr(last + 1).c_str() );
+    }
+  return true;
+}
+}
+
+/** Compare the timings of a benchmark run against a baseline.  Fails
+ * when a case is slower than its baseline by more than the tolerance,
+ * a fraction of the baseline time.  Cases missing from the baseline are
+ * reported but do not fail, so that new cases can be added before the
+ * baseline is updated. */
+int itkBenchmarkCompare(int argc, char *argv[])
+{
+  if ( argc < 3 )
+    {
+    std::cerr << "Usage: " << argv[0] << " resultsFile baselineFile [tolerance]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const double tolerance = argc > 3 ? atof(argv[3]) : 0.2;
+
+  TimingsType results;
+  TimingsType baseline;
+  if ( !ReadTimings(argv[1], results) || !ReadTimings(argv[2], baseline) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  unsigned int numberOfRegressions = 0;
+  for ( TimingsType::const_iterator it = results.begin(); it != results.end(); ++it )
+    {
+    const TimingsType::const_iterator baselineIt = baseline.find(it->first);
+    if ( baselineIt == baseline.end() )
+      {
+      std::cout << it->first << "\t" << it->second << "\tnot in the baseline" << std::endl;
+      continue;
+      }
+
+    const double ratio = baselineIt->second > 0 ? it->second / baselineIt->second : 1.0;
+    const bool regression = ratio > 1.0 + tolerance;
+    std::cout << it->first << "\t" << it->second << "\t" << baselineIt->second << "\t"
+              << std::setprecision(3) << ratio << std::setprecision(6)
+              << ( regression ? "\tREGRESSION" : "" ) << std::endl;
+    if ( regression )
+      {
+      ++numberOfRegressions;
+      }
+    }
+
+  if ( numberOfRegressions > 0 )
+    {
+    std::cerr << numberOfRegressions << " case(s) slower than the baseline by more than "
+              << 100 * tolerance << "%" << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
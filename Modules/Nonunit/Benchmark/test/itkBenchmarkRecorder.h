@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef __itkBenchmarkRecorder_h
+#define __itkBenchmarkRecorder_h
+
+#include "itkTimeProbe.h"
+#include "itkProcessObject.h"
+#include "itkMultiThreader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkRecorder
+ * \brief Times benchmark cases and writes the results as a table.
+ *
+ * Each case is run once to warm up the caches and the allocator, then
+ * the given number of times; the median of the wall clock times
+ * measured with a TimeProbe is recorded, so that a single run disturbed
+ * by the system does not change the result.
+ *
+ * Write() saves one line per case with the tab separated fields
+ * benchmark, pixel type, size, number of threads and seconds.  The first
+ * four fields identify the case, and itkBenchmarkCompare matches them
+ * against a baseline written by a previous run.
+ *
+ * \ingroup ITKBenchmark
+ */
+class BenchmarkRecorder
+{
+public:
+  BenchmarkRecorder(unsigned int numberOfRepetitions = 5):
+    m_NumberOfRepetitions(numberOfRepetitions)
+  {}
+
+  /** Functor updating a process object after marking it and its
+   * inputs modified.  The sources of the inputs are not executed again,
+   * but the mini-pipelines of composite filters, which only watch the
+   * input images, are. */
+  class UpdateFunction
+  {
+public:
+    UpdateFunction(ProcessObject *object):m_Object(object) {}
+    void operator()()
+    {
+      ProcessObject::DataObjectPointerArray inputs = m_Object->GetInputs();
+      for ( unsigned int i = 0; i < inputs.size(); ++i )
+        {
+        if ( inputs[i] )
+          {
+          inputs[i]->Modified();
+          }
+        }
+      m_Object->Modified();
+      m_Object->Update();
+    }
+
+private:
+    ProcessObject *m_Object;
+  };
+
+  /** Time function and record the median time. */
+  template< class TFunction >
+  double Run(const std::string & benchmark, const std::string & pixelType,
+             const std::string & size, ThreadIdType numberOfThreads, TFunction function)
+  {
+    function();
+
+    std::vector< double > times;
+    for ( unsigned int i = 0; i < m_NumberOfRepetitions; ++i )
+      {
+      TimeProbe probe;
+      probe.Start();
+      function();
+      probe.Stop();
+      times.push_back( probe.GetTotal() );
+      }
+    std::sort( times.begin(), times.end() );
+    const double seconds = times[times.size() / 2];
+
+    this->Record(benchmark, pixelType, size, numberOfThreads, seconds);
+    return seconds;
+  }
+
+  /** Shortcut timing the update of a process object. */
+  double RunUpdate(const std::string & benchmark, const std::string & pixelType,
+                   const std::string & size, ProcessObject *object)
+  {
+    return this->Run( benchmark, pixelType, size, object->GetNumberOfThreads(), UpdateFunction(object) );
+  }
+
+  void Record(const std::string & benchmark, const std::string & pixelType,
+              const std::string & size, ThreadIdType numberOfThreads, double seconds)
+  {
+    std::ostringstream line;
+    line << benchmark << '\t' << pixelType << '\t' << size << '\t'
+         << numberOfThreads << '\t' << std::setprecision(6) << seconds;
+    m_Lines.push_back( line.str() );
+    std::cout << line.str() << std::endl;
+  }
+
+  /** Write the recorded cases.  Returns false when the file cannot be
+   * written. */
+  bool Write(const std::string & fileName) const
+  {
+    std::ofstream file( fileName.c_str() );
+    file << "# benchmark\tpixel\tsize\tthreads\tseconds" << std::endl;
+    for ( std::vector< std::string >::const_iterator it = m_Lines.begin(); it != m_Lines.end(); ++it )
+      {
+      file << *it << std::endl;
+      }
+    return static_cast< bool >( file );
+  }
+
+  /** The numbers of threads each case is run with: one, and the
+   * default number of threads when it is larger. */
+  static std::vector< ThreadIdType > GetNumbersOfThreads()
+  {
+    std::vector< ThreadIdType > numbers;
+    numbers.push_back(1);
+    const ThreadIdType defaultNumber = MultiThreader::GetGlobalDefaultNumberOfThreads();
+    if ( defaultNumber > 1 )
+      {
+      numbers.push_back(defaultNumber);
+      }
+    return numbers;
+  }
+
+  /** Format a size as 256x256. */
+  template< class TSize >
+  static std::string SizeToString(const TSize & size)
+  {
+    std::ostringstream str;
+    for ( unsigned int i = 0; i < TSize::Dimension; ++i )
+      {
+      str << ( i ? "x" : "" ) << size[i];
+      }
+    return str.str();
+  }
+
+private:
+  unsigned int               m_NumberOfRepetitions;
+  std::vector< std::string > m_Lines;
+};
+} // end namespace itk
+
+#endif
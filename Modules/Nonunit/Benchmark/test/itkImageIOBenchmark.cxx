@@ -0,0 +1,71 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkRecorder.h"
+#include "itkRandomImageSource.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+
+namespace
+{
+template< class TPixel, unsigned int VDimension >
+void ImageIOBenchmark(itk::BenchmarkRecorder & recorder, const std::string & pixelType,
+                      itk::SizeValueType sizeValue, const std::string & fileName)
+{
+  typedef itk::Image< TPixel, VDimension >     ImageType;
+  typedef itk::RandomImageSource< ImageType >  SourceType;
+  typedef itk::ImageFileWriter< ImageType >    WriterType;
+  typedef itk::ImageFileReader< ImageType >    ReaderType;
+
+  typename ImageType::SizeType size;
+  size.Fill(sizeValue);
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetSize(size);
+  source->Update();
+  const std::string sizeString = itk::BenchmarkRecorder::SizeToString(size);
+
+  typename WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( source->GetOutput() );
+  writer->SetFileName(fileName);
+  recorder.RunUpdate("ImageFileWriter/MetaImage", pixelType, sizeString, writer);
+
+  typename ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(fileName);
+  recorder.RunUpdate("ImageFileReader/MetaImage", pixelType, sizeString, reader);
+}
+}
+
+int itkImageIOBenchmark(int argc, char *argv[])
+{
+  if ( argc < 3 )
+    {
+    std::cerr << "Usage: " << argv[0] << " resultsFile scratchImage.mha [numberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::BenchmarkRecorder recorder( argc > 3 ? atoi(argv[3]) : 5 );
+
+  ImageIOBenchmark< unsigned char, 2 >(recorder, "uchar", 2048, argv[2]);
+  ImageIOBenchmark< float, 3 >(recorder, "float", 128, argv[2]);
+
+  if ( !recorder.Write(argv[1]) )
+    {
+    std::cerr << "Cannot write " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkRecorder.h"
+#include "itkRandomImageSource.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkConstNeighborhoodIterator.h"
+
+namespace
+{
+// Sum of the pixels, read with ImageRegionConstIterator.
+template< class TImage >
+class RegionIteratorCase
+{
+public:
+  RegionIteratorCase(const TImage *image):m_Image(image), m_Sum(0) {}
+  void operator()()
+  {
+    double sum = 0;
+    for ( itk::ImageRegionConstIterator< TImage > it( m_Image, m_Image->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+      {
+      sum += it.Get();
+      }
+    m_Sum = sum;
+  }
+
+private:
+  const TImage *   m_Image;
+  volatile double  m_Sum;
+};
+
+// Write each pixel from its index with ImageRegionIteratorWithIndex.
+template< class TImage >
+class RegionIteratorWithIndexCase
+{
+public:
+  RegionIteratorWithIndexCase(TImage *image):m_Image(image) {}
+  void operator()()
+  {
+    for ( itk::ImageRegionIteratorWithIndex< TImage > it( m_Image, m_Image->GetBufferedRegion() ); !it.IsAtEnd(); ++it )
+      {
+      const typename TImage::IndexType & index = it.GetIndex();
+      it.Set( static_cast< typename TImage::PixelType >( index[0] + index[1] ) );
+      }
+  }
+
+private:
+  TImage *m_Image;
+};
+
+// Sum of the 3x3(x3) neighborhoods, read with ConstNeighborhoodIterator,
+// which checks the boundary conditions at each pixel.
+template< class TImage >
+class NeighborhoodIteratorCase
+{
+public:
+  NeighborhoodIteratorCase(const TImage *image):m_Image(image), m_Sum(0) {}
+  void operator()()
+  {
+    typename itk::ConstNeighborhoodIterator< TImage >::RadiusType radius;
+    radius.Fill(1);
+    double sum = 0;
+    for ( itk::ConstNeighborhoodIterator< TImage > it( radius, m_Image, m_Image->GetBufferedRegion() );
+          !it.IsAtEnd(); ++it )
+      {
+      for ( unsigned int i = 0; i < it.Size(); ++i )
+        {
+        sum += it.GetPixel(i);
+        }
+      }
+    m_Sum = sum;
+  }
+
+private:
+  const TImage *   m_Image;
+  volatile double  m_Sum;
+};
+
+template< class TPixel, unsigned int VDimension >
+void IteratorBenchmark(itk::BenchmarkRecorder & recorder, const std::string & pixelType, itk::SizeValueType sizeValue)
+{
+  typedef itk::Image< TPixel, VDimension >  ImageType;
+  typedef itk::RandomImageSource< ImageType > SourceType;
+
+  typename ImageType::SizeType size;
+  size.Fill(sizeValue);
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetSize(size);
+  source->Update();
+  typename ImageType::Pointer image = source->GetOutput();
+  const std::string sizeString = itk::BenchmarkRecorder::SizeToString(size);
+
+  recorder.Run( "ImageRegionConstIterator", pixelType, sizeString, 1,
+                RegionIteratorCase< ImageType >(image) );
+  recorder.Run( "ImageRegionIteratorWithIndex", pixelType, sizeString, 1,
+                RegionIteratorWithIndexCase< ImageType >(image) );
+  recorder.Run( "ConstNeighborhoodIterator", pixelType, sizeString, 1,
+                NeighborhoodIteratorCase< ImageType >(image) );
+}
+}
+
+int itkIteratorBenchmark(int argc, char *argv[])
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " resultsFile [numberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::BenchmarkRecorder recorder( argc > 2 ? atoi(argv[2]) : 5 );
+
+  IteratorBenchmark< unsigned char, 2 >(recorder, "uchar", 1024);
+  IteratorBenchmark< float, 2 >(recorder, "float", 1024);
+  IteratorBenchmark< unsigned char, 3 >(recorder, "uchar", 100);
+  IteratorBenchmark< float, 3 >(recorder, "float", 100);
+
+  if ( !recorder.Write(argv[1]) )
+    {
+    std::cerr << "Cannot write " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
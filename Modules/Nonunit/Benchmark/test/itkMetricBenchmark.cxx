@@ -0,0 +1,119 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkRecorder.h"
+#include "itkRandomImageSource.h"
+#include "itkTranslationTransform.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+
+namespace
+{
+// One evaluation of the value and derivative of a metric, as done at
+// each iteration of a registration.
+template< class TMetric >
+class GetValueAndDerivativeCase
+{
+public:
+  GetValueAndDerivativeCase(TMetric *metric):m_Metric(metric) {}
+  void operator()()
+  {
+    typename TMetric::MeasureType    value;
+    typename TMetric::DerivativeType derivative;
+    m_Metric->GetValueAndDerivative(value, derivative);
+  }
+
+private:
+  TMetric *m_Metric;
+};
+
+template< class TMetric, class TImage >
+void MetricCase(itk::BenchmarkRecorder & recorder, const std::string & benchmark, TMetric *metric,
+                const TImage *fixedImage, const TImage *movingImage)
+{
+  typedef itk::TranslationTransform< double, TImage::ImageDimension > TransformType;
+  typename TransformType::Pointer fixedTransform = TransformType::New();
+  typename TransformType::Pointer movingTransform = TransformType::New();
+  typename TransformType::OutputVectorType offset;
+  offset.Fill(0.5);
+  movingTransform->Translate(offset);
+
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetFixedTransform(fixedTransform);
+  metric->SetMovingTransform(movingTransform);
+
+  const std::string sizeString =
+    itk::BenchmarkRecorder::SizeToString( fixedImage->GetLargestPossibleRegion().GetSize() );
+  const std::vector< itk::ThreadIdType > numbersOfThreads = itk::BenchmarkRecorder::GetNumbersOfThreads();
+  for ( unsigned int i = 0; i < numbersOfThreads.size(); ++i )
+    {
+    metric->SetMaximumNumberOfThreads(numbersOfThreads[i]);
+    metric->Initialize();
+    recorder.Run( benchmark, "float", sizeString, numbersOfThreads[i],
+                  GetValueAndDerivativeCase< TMetric >(metric) );
+    }
+}
+
+template< unsigned int VDimension >
+void MetricBenchmark(itk::BenchmarkRecorder & recorder, itk::SizeValueType sizeValue)
+{
+  typedef itk::Image< float, VDimension >                                                ImageType;
+  typedef itk::RandomImageSource< ImageType >                                            SourceType;
+  typedef itk::MeanSquaresImageToImageMetricv4< ImageType, ImageType >                   MeanSquaresType;
+  typedef itk::MattesMutualInformationImageToImageMetricv4< ImageType, ImageType >       MattesType;
+
+  typename ImageType::SizeType size;
+  size.Fill(sizeValue);
+  typename SourceType::Pointer fixedSource = SourceType::New();
+  fixedSource->SetSize(size);
+  fixedSource->Update();
+  typename SourceType::Pointer movingSource = SourceType::New();
+  movingSource->SetSize(size);
+  movingSource->Update();
+
+  typename MeanSquaresType::Pointer meanSquares = MeanSquaresType::New();
+  MetricCase( recorder, "MeanSquaresImageToImageMetricv4", meanSquares.GetPointer(),
+              fixedSource->GetOutput(), movingSource->GetOutput() );
+
+  typename MattesType::Pointer mattes = MattesType::New();
+  mattes->SetNumberOfHistogramBins(32);
+  MetricCase( recorder, "MattesMutualInformationImageToImageMetricv4", mattes.GetPointer(),
+              fixedSource->GetOutput(), movingSource->GetOutput() );
+}
+}
+
+int itkMetricBenchmark(int argc, char *argv[])
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " resultsFile [numberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::BenchmarkRecorder recorder( argc > 2 ? atoi(argv[2]) : 5 );
+
+  MetricBenchmark< 2 >(recorder, 256);
+  MetricBenchmark< 3 >(recorder, 48);
+
+  if ( !recorder.Write(argv[1]) )
+    {
+    std::cerr << "Cannot write " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
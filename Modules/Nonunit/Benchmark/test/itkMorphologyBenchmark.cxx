@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkRecorder.h"
+#include "itkRandomImageSource.h"
+#include "itkFlatStructuringElement.h"
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleMorphologicalOpeningImageFilter.h"
+
+namespace
+{
+// Dilation and opening with a ball, and dilation with a box, which
+// the filters decompose into lines.
+template< class TPixel, unsigned int VDimension >
+void MorphologyBenchmark(itk::BenchmarkRecorder & recorder, const std::string & pixelType,
+                         itk::SizeValueType sizeValue, itk::SizeValueType radiusValue)
+{
+  typedef itk::Image< TPixel, VDimension >                                                 ImageType;
+  typedef itk::RandomImageSource< ImageType >                                              SourceType;
+  typedef itk::FlatStructuringElement< VDimension >                                        KernelType;
+  typedef itk::GrayscaleDilateImageFilter< ImageType, ImageType, KernelType >              DilateType;
+  typedef itk::GrayscaleMorphologicalOpeningImageFilter< ImageType, ImageType, KernelType > OpeningType;
+
+  typename ImageType::SizeType size;
+  size.Fill(sizeValue);
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetSize(size);
+  source->Update();
+  const std::string sizeString = itk::BenchmarkRecorder::SizeToString(size);
+
+  typename KernelType::RadiusType radius;
+  radius.Fill(radiusValue);
+  const KernelType ball = KernelType::Ball(radius);
+  const KernelType box = KernelType::Box(radius);
+
+  typename DilateType::Pointer dilate = DilateType::New();
+  dilate->SetInput( source->GetOutput() );
+
+  typename OpeningType::Pointer opening = OpeningType::New();
+  opening->SetInput( source->GetOutput() );
+  opening->SetKernel(ball);
+
+  const std::vector< itk::ThreadIdType > numbersOfThreads = itk::BenchmarkRecorder::GetNumbersOfThreads();
+  for ( unsigned int i = 0; i < numbersOfThreads.size(); ++i )
+    {
+    dilate->SetNumberOfThreads(numbersOfThreads[i]);
+    dilate->SetKernel(ball);
+    recorder.RunUpdate("GrayscaleDilateImageFilter/Ball", pixelType, sizeString, dilate);
+    dilate->SetKernel(box);
+    recorder.RunUpdate("GrayscaleDilateImageFilter/Box", pixelType, sizeString, dilate);
+
+    opening->SetNumberOfThreads(numbersOfThreads[i]);
+    recorder.RunUpdate("GrayscaleMorphologicalOpeningImageFilter/Ball", pixelType, sizeString, opening);
+    }
+}
+}
+
+int itkMorphologyBenchmark(int argc, char *argv[])
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " resultsFile [numberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::BenchmarkRecorder recorder( argc > 2 ? atoi(argv[2]) : 5 );
+
+  MorphologyBenchmark< unsigned char, 2 >(recorder, "uchar", 512, 3);
+  MorphologyBenchmark< float, 2 >(recorder, "float", 512, 3);
+  MorphologyBenchmark< unsigned char, 3 >(recorder, "uchar", 64, 2);
+
+  if ( !recorder.Write(argv[1]) )
+    {
+    std::cerr << "Cannot write " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkRecorder.h"
+#include "itkRandomImageSource.h"
+#include "itkResampleImageFilter.h"
+#include "itkAffineTransform.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+
+namespace
+{
+// Resample the image through a small rotation and scaling about its
+// center, with nearest neighbor and linear interpolation.
+template< class TPixel, unsigned int VDimension >
+void ResampleBenchmark(itk::BenchmarkRecorder & recorder, const std::string & pixelType, itk::SizeValueType sizeValue)
+{
+  typedef itk::Image< TPixel, VDimension >                       ImageType;
+  typedef itk::RandomImageSource< ImageType >                    SourceType;
+  typedef itk::ResampleImageFilter< ImageType, ImageType >       FilterType;
+  typedef itk::AffineTransform< double, VDimension >             TransformType;
+  typedef itk::LinearInterpolateImageFunction< ImageType >       LinearType;
+  typedef itk::NearestNeighborInterpolateImageFunction< ImageType > NearestType;
+
+  typename ImageType::SizeType size;
+  size.Fill(sizeValue);
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetSize(size);
+  source->Update();
+  const std::string sizeString = itk::BenchmarkRecorder::SizeToString(size);
+
+  typename TransformType::Pointer transform = TransformType::New();
+  typename TransformType::InputPointType center;
+  center.Fill(sizeValue / 2.0);
+  transform->SetCenter(center);
+  transform->Rotate(0, 1, 0.1);
+  transform->Scale(1.1);
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( source->GetOutput() );
+  filter->SetTransform(transform);
+  filter->SetSize(size);
+
+  const std::vector< itk::ThreadIdType > numbersOfThreads = itk::BenchmarkRecorder::GetNumbersOfThreads();
+  for ( unsigned int i = 0; i < numbersOfThreads.size(); ++i )
+    {
+    filter->SetNumberOfThreads(numbersOfThreads[i]);
+
+    filter->SetInterpolator( NearestType::New() );
+    recorder.RunUpdate("ResampleImageFilter/Nearest", pixelType, sizeString, filter);
+
+    filter->SetInterpolator( LinearType::New() );
+    recorder.RunUpdate("ResampleImageFilter/Linear", pixelType, sizeString, filter);
+    }
+}
+}
+
+int itkResampleBenchmark(int argc, char *argv[])
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " resultsFile [numberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::BenchmarkRecorder recorder( argc > 2 ? atoi(argv[2]) : 5 );
+
+  ResampleBenchmark< unsigned char, 2 >(recorder, "uchar", 1024);
+  ResampleBenchmark< float, 2 >(recorder, "float", 1024);
+  ResampleBenchmark< float, 3 >(recorder, "float", 64);
+
+  if ( !recorder.Write(argv[1]) )
+    {
+    std::cerr << "Cannot write " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBenchmarkRecorder.h"
+#include "itkRandomImageSource.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkDiscreteGaussianImageFilter.h"
+#include "itkMedianImageFilter.h"
+
+namespace
+{
+template< class TPixel, unsigned int VDimension >
+void SmoothingBenchmark(itk::BenchmarkRecorder & recorder, const std::string & pixelType,
+                        itk::SizeValueType sizeValue, itk::SizeValueType medianRadius)
+{
+  typedef itk::Image< TPixel, VDimension >                                      ImageType;
+  typedef itk::RandomImageSource< ImageType >                                   SourceType;
+  typedef itk::SmoothingRecursiveGaussianImageFilter< ImageType, ImageType >    RecursiveGaussianType;
+  typedef itk::DiscreteGaussianImageFilter< ImageType, ImageType >              DiscreteGaussianType;
+  typedef itk::MedianImageFilter< ImageType, ImageType >                        MedianType;
+
+  typename ImageType::SizeType size;
+  size.Fill(sizeValue);
+  typename SourceType::Pointer source = SourceType::New();
+  source->SetSize(size);
+  source->Update();
+  const std::string sizeString = itk::BenchmarkRecorder::SizeToString(size);
+
+  typename RecursiveGaussianType::Pointer recursiveGaussian = RecursiveGaussianType::New();
+  recursiveGaussian->SetInput( source->GetOutput() );
+  recursiveGaussian->SetSigma(2.0);
+
+  typename DiscreteGaussianType::Pointer discreteGaussian = DiscreteGaussianType::New();
+  discreteGaussian->SetInput( source->GetOutput() );
+  discreteGaussian->SetVariance(4.0);
+
+  typename MedianType::Pointer median = MedianType::New();
+  median->SetInput( source->GetOutput() );
+  typename MedianType::InputSizeType radius;
+  radius.Fill(medianRadius);
+  median->SetRadius(radius);
+
+  const std::vector< itk::ThreadIdType > numbersOfThreads = itk::BenchmarkRecorder::GetNumbersOfThreads();
+  for ( unsigned int i = 0; i < numbersOfThreads.size(); ++i )
+    {
+    recursiveGaussian->SetNumberOfThreads(numbersOfThreads[i]);
+    recorder.RunUpdate("SmoothingRecursiveGaussianImageFilter", pixelType, sizeString, recursiveGaussian);
+
+    discreteGaussian->SetNumberOfThreads(numbersOfThreads[i]);
+    recorder.RunUpdate("DiscreteGaussianImageFilter", pixelType, sizeString, discreteGaussian);
+
+    median->SetNumberOfThreads(numbersOfThreads[i]);
+    recorder.RunUpdate("MedianImageFilter", pixelType, sizeString, median);
+    }
+}
+}
+
+int itkSmoothingBenchmark(int argc, char *argv[])
+{
+  if ( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " resultsFile [numberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+    }
+  itk::BenchmarkRecorder recorder( argc > 2 ? atoi(argv[2]) : 5 );
+
+  SmoothingBenchmark< unsigned char, 2 >(recorder, "uchar", 512, 2);
+  SmoothingBenchmark< float, 2 >(recorder, "float", 512, 2);
+  SmoothingBenchmark< float, 3 >(recorder, "float", 64, 1);
+
+  if ( !recorder.Write(argv[1]) )
+    {
+    std::cerr << "Cannot write " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+    }
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,7 @@
 #define __itkBoxMeanImageFilter_h
 
 #include "itkBoxImageFilter.h"
+#include "itkSummedAreaTable.h"
 
 namespace itk
 {
@@ -92,7 +93,16 @@ protected:
 private:
   BoxMeanImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);     //purposely not implemented
-};                                  // end of class
+
+  /** Mean of the box read from the summed area tables. */
+  class MeanFunction
+  {
+public:
+    typedef SummedAreaTable< InputImageType > TableType;
+    typename TableType::RealType operator()(const typename TableType::BoxStatistics & box) const
+    { return box.GetMean(); }
+  };
+};
 } // end namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -19,8 +19,7 @@
 #define __itkBoxMeanImageFilter_hxx
 
 #include "itkBoxMeanImageFilter.h"
-#include "itkProgressAccumulator.h"
-#include "itkBoxUtilities.h"
+#include "itkProgressReporter.h"
 
 
 /*
@@ -45,37 +44,14 @@ void
 BoxMeanImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId)
 {
-  // Accumulate type is too small
-  typedef typename NumericTraits< PixelType >::RealType    AccPixType;
-  typedef Image< AccPixType, TInputImage::ImageDimension > AccumImageType;
-
-  typename TInputImage::SizeType internalRadius;
-  for ( unsigned int i = 0; i < TInputImage::ImageDimension; i++ )
-    {
-    internalRadius[i] = this->GetRadius()[i] + 1;
-    }
-
-  const InputImageType *inputImage = this->GetInput();
-  OutputImageType *     outputImage = this->GetOutput();
-  RegionType            accumRegion = outputRegionForThread;
-  accumRegion.PadByRadius(internalRadius);
-  accumRegion.Crop( inputImage->GetRequestedRegion() );
-
-  ProgressReporter progress( this, threadId, 2 * accumRegion.GetNumberOfPixels() );
-
-  typename AccumImageType::Pointer accImage = AccumImageType::New();
-  accImage->SetRegions(accumRegion);
-  accImage->Allocate();
-
-  BoxAccumulateFunction< TInputImage, AccumImageType >(inputImage, accImage,
-                                                       accumRegion,
-                                                       accumRegion,
-                                                       progress);
-  BoxMeanCalculatorFunction< AccumImageType, TOutputImage >(accImage.GetPointer(), outputImage,
-                                                            accumRegion,
-                                                            outputRegionForThread,
-                                                            this->GetRadius(),
-                                                            progress);
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  // The boxes are cropped to the input image, so that the pixels of the
+  // border are computed over the part of the box inside the image.
+  SummedAreaTable< InputImageType > table( this->GetInput(), this->GetRadius() );
+  table.SetCropBoxes(true);
+  MeanFunction function;
+  table.ComputeFromBoxes(this->GetOutput(), outputRegionForThread, function, progress);
 }
 } // end namespace itk
 #endif
@@ -19,6 +19,7 @@
 #define __itkBoxSigmaImageFilter_h
 
 #include "itkBoxImageFilter.h"
+#include "itkSummedAreaTable.h"
 
 namespace itk
 {
@@ -91,7 +92,16 @@ protected:
 private:
   BoxSigmaImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);      //purposely not implemented
-};                                   // end of class
+
+  /** Standard deviation of the box read from the summed area tables. */
+  class SigmaFunction
+  {
+public:
+    typedef SummedAreaTable< InputImageType > TableType;
+    typename TableType::RealType operator()(const typename TableType::BoxStatistics & box) const
+    { return box.GetSigma(); }
+  };
+};
 } // end namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
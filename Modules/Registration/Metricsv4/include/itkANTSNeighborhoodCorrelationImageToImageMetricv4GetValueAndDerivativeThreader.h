@@ -201,6 +201,19 @@ protected:
     return Superclass::ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
   }
 
+  /** The sparse threader scans a neighborhood around each point, so the
+   * batches of the base class are processed one point at a time, through
+   * \c ProcessVirtualPoint. */
+  virtual void ProcessVirtualPoints( const VirtualIndexType * virtualIndices,
+                                     const VirtualPointType * virtualPoints,
+                                     const SizeValueType numberOfPoints,
+                                     const ThreadIdType threadId ) {
+    for( SizeValueType i = 0; i < numberOfPoints; ++i )
+      {
+      this->ProcessVirtualPoint( virtualIndices[i], virtualPoints[i], threadId );
+      }
+  }
+
 
   /** \c ProcessPoint() must be overloaded since it is a pure virtual function.
    * It is not used for either sparse or dense threader.
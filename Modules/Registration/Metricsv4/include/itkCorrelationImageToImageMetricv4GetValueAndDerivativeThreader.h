@@ -89,12 +89,16 @@ protected:
 
   /** Overload to avoid execution of adding entries to m_MeasurePerThread
    * StorePointDerivativeResult() after this function calls ProcessPoint().
-   * Method called by the threaders to process the given virtual point.  This
-   * in turn calls \c TransformAndEvaluateFixedPoint, \c
-   * TransformAndEvaluateMovingPoint, and \c ProcessPoint. */
-  virtual bool ProcessVirtualPoint( const VirtualIndexType & virtualIndex,
-                                    const VirtualPointType & virtualPoint,
-                                    const ThreadIdType threadId );
+   * Method called by \c ProcessVirtualPoint and \c ProcessVirtualPoints on
+   * a virtual point once it has been transformed and evaluated.  This
+   * computes the image gradients and calls \c ProcessPoint. */
+  virtual bool ProcessMappedPoint( const VirtualIndexType & virtualIndex,
+                                   const VirtualPointType & virtualPoint,
+                                   const FixedImagePointType & mappedFixedPoint,
+                                   const FixedImagePixelType & mappedFixedPixelValue,
+                                   const MovingImagePointType & mappedMovingPoint,
+                                   const MovingImagePixelType & mappedMovingPixelValue,
+                                   const ThreadIdType threadId );
 
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
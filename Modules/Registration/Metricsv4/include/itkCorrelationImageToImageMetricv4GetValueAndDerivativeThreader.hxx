@@ -141,29 +141,35 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
 template<class TDomainPartitioner, class TImageToImageMetric, class TCorrelationMetric>
 bool
 CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner, TImageToImageMetric, TCorrelationMetric>
-::ProcessVirtualPoint( const VirtualIndexType & virtualIndex, const VirtualPointType & virtualPoint, const ThreadIdType threadId )
+::ProcessMappedPoint( const VirtualIndexType & virtualIndex,
+                      const VirtualPointType & virtualPoint,
+                      const FixedImagePointType & mappedFixedPoint,
+                      const FixedImagePixelType & mappedFixedPixelValue,
+                      const MovingImagePointType & mappedMovingPoint,
+                      const MovingImagePixelType & mappedMovingPixelValue,
+                      const ThreadIdType threadId )
 {
-  FixedOutputPointType        mappedFixedPoint;
-  FixedImagePixelType         mappedFixedPixelValue;
   FixedImageGradientType      mappedFixedImageGradient;
-  MovingOutputPointType       mappedMovingPoint;
-  MovingImagePixelType        mappedMovingPixelValue;
   MovingImageGradientType     mappedMovingImageGradient;
   bool                        pointIsValid = false;
   MeasureType                 metricValueResult;
 
-  /* Transform the point into fixed and moving spaces, and evaluate.
+  /* Compute the image gradients needed by the derivative.
    * Different behavior with pre-warping enabled is handled transparently.
    * Do this in a try block to catch exceptions and print more useful info
    * then we otherwise get when exceptions are caught in MultiThreader. */
   try
     {
-    pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateFixedPoint( virtualPoint, mappedFixedPoint, mappedFixedPixelValue );
-    if( pointIsValid &&
-        this->m_CorrelationAssociate->GetComputeDerivative() &&
-        this->m_CorrelationAssociate->GetGradientSourceIncludesFixed() )
+    if( this->m_CorrelationAssociate->GetComputeDerivative() )
       {
-      this->m_CorrelationAssociate->ComputeFixedImageGradientAtPoint( mappedFixedPoint, mappedFixedImageGradient );
+      if( this->m_CorrelationAssociate->GetGradientSourceIncludesFixed() )
+        {
+        this->m_CorrelationAssociate->ComputeFixedImageGradientAtPoint( mappedFixedPoint, mappedFixedImageGradient );
+        }
+      if( this->m_CorrelationAssociate->GetGradientSourceIncludesMoving() )
+        {
+        this->m_CorrelationAssociate->ComputeMovingImageGradientAtPoint( mappedMovingPoint, mappedMovingImageGradient );
+        }
       }
     }
   catch( ExceptionObject & exc )
@@ -174,32 +180,6 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
     ExceptionObject err(__FILE__, __LINE__, msg);
     throw err;
     }
-  if( !pointIsValid )
-    {
-    return pointIsValid;
-    }
-
-  try
-    {
-    pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateMovingPoint( virtualPoint, mappedMovingPoint, mappedMovingPixelValue );
-    if( pointIsValid &&
-        this->m_CorrelationAssociate->GetComputeDerivative() &&
-        this->m_CorrelationAssociate->GetGradientSourceIncludesMoving() )
-      {
-      this->m_CorrelationAssociate->ComputeMovingImageGradientAtPoint( mappedMovingPoint, mappedMovingImageGradient );
-      }
-    }
-  catch( ExceptionObject & exc )
-    {
-    std::string msg("Caught exception: \n");
-    msg += exc.what();
-    ExceptionObject err(__FILE__, __LINE__, msg);
-    throw err;
-    }
-  if( !pointIsValid )
-    {
-    return pointIsValid;
-    }
 
   /* Call the user method in derived classes to do the specific
    * calculations for value and derivative. */
@@ -86,17 +86,21 @@ protected:
 
   /* Overload: don't need to compute the image gradients and store derivatives
    *
-   * Method called by the threaders to process the given virtual point.  This
-   * in turn calls \c TransformAndEvaluateFixedPoint, \c
-   * TransformAndEvaluateMovingPoint, and \c ProcessPoint.
+   * Method called by \c ProcessVirtualPoint and \c ProcessVirtualPoints on
+   * a virtual point once it has been transformed and evaluated.  This sums
+   * the pixel values.
    */
-  virtual bool ProcessVirtualPoint( const VirtualIndexType & virtualIndex,
-                                    const VirtualPointType & virtualPoint,
-                                    const ThreadIdType threadId );
+  virtual bool ProcessMappedPoint( const VirtualIndexType & virtualIndex,
+                                   const VirtualPointType & virtualPoint,
+                                   const FixedImagePointType & mappedFixedPoint,
+                                   const FixedImagePixelType & mappedFixedPixelValue,
+                                   const MovingImagePointType & mappedMovingPoint,
+                                   const MovingImagePixelType & mappedMovingPixelValue,
+                                   const ThreadIdType threadId );
 
 
   /**
-   * Not using. All processing is done in ProcessVirtualPoint.
+   * Not using. All processing is done in ProcessMappedPoint.
    */
   virtual bool ProcessPoint(
         const VirtualIndexType &          ,
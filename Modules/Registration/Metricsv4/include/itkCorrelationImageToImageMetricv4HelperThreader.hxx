@@ -82,70 +82,20 @@ template<class TDomainPartitioner, class TImageToImageMetric, class TCorrelation
 bool
 CorrelationImageToImageMetricv4HelperThreader<TDomainPartitioner,
 TImageToImageMetric, TCorrelationMetric>
-::ProcessVirtualPoint( const VirtualIndexType & itkNotUsed(virtualIndex), const VirtualPointType & virtualPoint, const ThreadIdType threadID )
+::ProcessMappedPoint( const VirtualIndexType & itkNotUsed(virtualIndex),
+                      const VirtualPointType & itkNotUsed(virtualPoint),
+                      const FixedImagePointType & itkNotUsed(mappedFixedPoint),
+                      const FixedImagePixelType & mappedFixedPixelValue,
+                      const MovingImagePointType & itkNotUsed(mappedMovingPoint),
+                      const MovingImagePixelType & mappedMovingPixelValue,
+                      const ThreadIdType threadID )
 {
-  FixedOutputPointType        mappedFixedPoint;
-  FixedImagePixelType         mappedFixedPixelValue;
-  MovingOutputPointType       mappedMovingPoint;
-  MovingImagePixelType        mappedMovingPixelValue;
-  bool                        pointIsValid = false;
-
-  /* Transform the point into fixed and moving spaces, and evaluate.
-   * Different behavior with pre-warping enabled is handled transparently.
-   * Do this in a try block to catch exceptions and print more useful info
-   * then we otherwise get when exceptions are caught in MultiThreader. */
-  try
-    {
-    pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateFixedPoint( virtualPoint, mappedFixedPoint, mappedFixedPixelValue );
-    }
-  catch( ExceptionObject & exc )
-    {
-    //NOTE: there must be a cleaner way to do this:
-    std::string msg("Caught exception: \n");
-    msg += exc.what();
-    ExceptionObject err(__FILE__, __LINE__, msg);
-    throw err;
-    }
-  if( !pointIsValid )
-    {
-    return pointIsValid;
-    }
-
-  try
-    {
-    pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateMovingPoint( virtualPoint, mappedMovingPoint, mappedMovingPixelValue );
-    }
-  catch( ExceptionObject & exc )
-    {
-    std::string msg("Caught exception: \n");
-    msg += exc.what();
-    ExceptionObject err(__FILE__, __LINE__, msg);
-    throw err;
-    }
-  if( !pointIsValid )
-    {
-    return pointIsValid;
-    }
-
   /* Do the specific calculations for values */
-  try
-    {
-    this->m_FixSumPerThread[threadID] += mappedFixedPixelValue;
-    this->m_MovSumPerThread[threadID] += mappedMovingPixelValue;
-    }
-  catch( ExceptionObject & exc )
-    {
-    std::string msg("Exception in ProcessVirtualPoint:\n");
-    msg += exc.what();
-    ExceptionObject err(__FILE__, __LINE__, msg);
-    throw err;
-    }
-  if( pointIsValid )
-    {
-    this->m_NumberOfValidPointsPerThread[threadID]++;
-    }
+  this->m_FixSumPerThread[threadID] += mappedFixedPixelValue;
+  this->m_MovSumPerThread[threadID] += mappedMovingPixelValue;
+  this->m_NumberOfValidPointsPerThread[threadID]++;
 
-  return pointIsValid;
+  return true;
 }
 } // end namespace itk
 
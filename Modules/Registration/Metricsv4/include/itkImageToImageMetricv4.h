@@ -548,6 +548,34 @@ protected:
                          MovingImagePointType & mappedMovingPoint,
                          MovingImagePixelType & mappedMovingPixelValue ) const;
 
+  /**
+   * Transform and evaluate a batch of points from VirtualImage domain to
+   * FixedImage domain, as \c TransformAndEvaluateFixedPoint does for one point.
+   * The points are mapped with a single call to the transform, and the
+   * interpolator evaluates all the valid ones at once, from their continuous
+   * indices.
+   * \c pointIds holds the positions in \c virtualPoints of the \c numberOfPoints
+   * points to process.  On return it holds, in the same order, the positions of
+   * the points that are valid, and their number is returned.
+   * The mapped point and pixel value of a valid point are returned at its
+   * position in \c mappedFixedPoints and \c mappedFixedPixelValues.
+   */
+  SizeValueType TransformAndEvaluateFixedPoints(
+                         const VirtualPointType * virtualPoints,
+                         SizeValueType * pointIds,
+                         SizeValueType numberOfPoints,
+                         FixedImagePointType * mappedFixedPoints,
+                         FixedImagePixelType * mappedFixedPixelValues ) const;
+
+  /** Transform and evaluate a batch of points from VirtualImage domain to
+   * MovingImage domain. */
+  SizeValueType TransformAndEvaluateMovingPoints(
+                         const VirtualPointType * virtualPoints,
+                         SizeValueType * pointIds,
+                         SizeValueType numberOfPoints,
+                         MovingImagePointType * mappedMovingPoints,
+                         MovingImagePixelType * mappedMovingPixelValues ) const;
+
   /** Compute image derivatives for a Fixed point. */
   virtual void ComputeFixedImageGradientAtPoint( const FixedImagePointType & mappedPoint, FixedImageGradientType & gradient ) const;
 
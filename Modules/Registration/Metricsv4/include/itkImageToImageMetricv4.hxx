@@ -358,6 +358,124 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TMetricTraits >
   return pointIsValid;
 }
 
+template<class TFixedImage,class TMovingImage,class TVirtualImage, typename TMetricTraits>
+SizeValueType
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TMetricTraits >
+::TransformAndEvaluateFixedPoints(
+                         const VirtualPointType * virtualPoints,
+                         SizeValueType * pointIds,
+                         SizeValueType numberOfPoints,
+                         FixedImagePointType * mappedFixedPoints,
+                         FixedImagePixelType * mappedFixedPixelValues ) const
+{
+  if( numberOfPoints == 0 )
+    {
+    return 0;
+    }
+
+  typedef typename FixedInterpolatorType::ContinuousIndexType ContinuousIndexType;
+  typedef typename FixedInterpolatorType::OutputType          InterpolatorOutputType;
+
+  // map the points into fixed space
+  std::vector< FixedInputPointType >  inputPoints( numberOfPoints );
+  std::vector< FixedOutputPointType > outputPoints( numberOfPoints );
+  for( SizeValueType k = 0; k < numberOfPoints; ++k )
+    {
+    inputPoints[k] = virtualPoints[pointIds[k]];
+    }
+  this->m_FixedTransform->TransformPoints( &inputPoints[0], &outputPoints[0], numberOfPoints );
+
+  // keep the points within the mask and the image buffer
+  std::vector< ContinuousIndexType > indices( numberOfPoints );
+  SizeValueType numberOfValidPoints = 0;
+  for( SizeValueType k = 0; k < numberOfPoints; ++k )
+    {
+    const SizeValueType id = pointIds[k];
+    mappedFixedPoints[id] = outputPoints[k];
+    if( this->m_FixedImageMask && ! this->m_FixedImageMask->IsInside( mappedFixedPoints[id] ) )
+      {
+      continue;
+      }
+    this->m_FixedInterpolator->ConvertPointToContinuousIndex( mappedFixedPoints[id], indices[numberOfValidPoints] );
+    if( this->m_FixedInterpolator->IsInsideBuffer( indices[numberOfValidPoints] ) )
+      {
+      pointIds[numberOfValidPoints++] = id;
+      }
+    }
+
+  // Evaluate
+  if( numberOfValidPoints > 0 )
+    {
+    std::vector< InterpolatorOutputType > values( numberOfValidPoints );
+    this->m_FixedInterpolator->EvaluateAtContinuousIndices( &indices[0], &values[0], numberOfValidPoints );
+    for( SizeValueType k = 0; k < numberOfValidPoints; ++k )
+      {
+      mappedFixedPixelValues[pointIds[k]] = values[k];
+      }
+    }
+
+  return numberOfValidPoints;
+}
+
+template<class TFixedImage,class TMovingImage,class TVirtualImage, typename TMetricTraits>
+SizeValueType
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TMetricTraits >
+::TransformAndEvaluateMovingPoints(
+                         const VirtualPointType * virtualPoints,
+                         SizeValueType * pointIds,
+                         SizeValueType numberOfPoints,
+                         MovingImagePointType * mappedMovingPoints,
+                         MovingImagePixelType * mappedMovingPixelValues ) const
+{
+  if( numberOfPoints == 0 )
+    {
+    return 0;
+    }
+
+  typedef typename MovingInterpolatorType::ContinuousIndexType ContinuousIndexType;
+  typedef typename MovingInterpolatorType::OutputType          InterpolatorOutputType;
+
+  // map the points into moving space
+  std::vector< MovingInputPointType >  inputPoints( numberOfPoints );
+  std::vector< MovingOutputPointType > outputPoints( numberOfPoints );
+  for( SizeValueType k = 0; k < numberOfPoints; ++k )
+    {
+    inputPoints[k] = virtualPoints[pointIds[k]];
+    }
+  this->m_MovingTransform->TransformPoints( &inputPoints[0], &outputPoints[0], numberOfPoints );
+
+  // keep the points within the mask and the image buffer
+  std::vector< ContinuousIndexType > indices( numberOfPoints );
+  SizeValueType numberOfValidPoints = 0;
+  for( SizeValueType k = 0; k < numberOfPoints; ++k )
+    {
+    const SizeValueType id = pointIds[k];
+    mappedMovingPoints[id] = outputPoints[k];
+    if( this->m_MovingImageMask && ! this->m_MovingImageMask->IsInside( mappedMovingPoints[id] ) )
+      {
+      continue;
+      }
+    this->m_MovingInterpolator->ConvertPointToContinuousIndex( mappedMovingPoints[id], indices[numberOfValidPoints] );
+    if( this->m_MovingInterpolator->IsInsideBuffer( indices[numberOfValidPoints] ) )
+      {
+      pointIds[numberOfValidPoints++] = id;
+      }
+    }
+
+  // Evaluate
+  if( numberOfValidPoints > 0 )
+    {
+    std::vector< InterpolatorOutputType > values( numberOfValidPoints );
+    this->m_MovingInterpolator->EvaluateAtContinuousIndices( &indices[0], &values[0], numberOfValidPoints );
+    for( SizeValueType k = 0; k < numberOfValidPoints; ++k )
+      {
+      mappedMovingPixelValues[pointIds[k]] = values[k];
+      }
+    }
+
+  return numberOfValidPoints;
+}
+
 template<class TFixedImage,class TMovingImage,class TVirtualImage, typename TMetricTraits>
 void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TMetricTraits >
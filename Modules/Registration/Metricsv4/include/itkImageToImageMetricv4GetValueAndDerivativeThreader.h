@@ -96,8 +96,8 @@ protected:
   /** Constructor. */
   ImageToImageMetricv4GetValueAndDerivativeThreader() {}
 
-  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoint on every
-   * point. */
+  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoints on
+   * every line of points. */
   virtual void ThreadedExecution( const DomainType & subdomain,
                                   const ThreadIdType threadId );
 
@@ -169,8 +169,8 @@ protected:
   /** Constructor. */
   ImageToImageMetricv4GetValueAndDerivativeThreader() {}
 
-  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoint on every
-   * point. */
+  /** Walk through the given virtual image domain, and call \c ProcessVirtualPoints on
+   * batches of consecutive points. */
   virtual void ThreadedExecution( const DomainType & subdomain,
                                   const ThreadIdType threadId );
 
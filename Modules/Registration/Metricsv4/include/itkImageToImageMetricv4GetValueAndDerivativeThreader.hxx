@@ -30,16 +30,26 @@ ImageToImageMetricv4GetValueAndDerivativeThreader< ThreadedImageRegionPartitione
 ::ThreadedExecution ( const DomainType & imageSubRegion,
                       const ThreadIdType threadId )
 {
-  VirtualPointType virtualPoint;
-  VirtualIndexType virtualIndex;
   typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
+  typename Superclass::VirtualPointBatchType & batch = this->m_VirtualPointBatchPerThread[threadId];
+
+  /* The points are processed a line of the region at a time. */
+  const SizeValueType lineLength = imageSubRegion.GetSize()[0];
+  batch.VirtualIndices.resize( lineLength );
+  batch.VirtualPoints.resize( lineLength );
+  SizeValueType numberOfPoints = 0;
+
   typedef ImageRegionConstIteratorWithIndex< VirtualImageType > IteratorType;
   IteratorType it( virtualImage, imageSubRegion );
   for( it.GoToBegin(); !it.IsAtEnd(); ++it )
     {
-    virtualIndex = it.GetIndex();
-    virtualImage->TransformIndexToPhysicalPoint( virtualIndex, virtualPoint );
-    this->ProcessVirtualPoint( virtualIndex, virtualPoint, threadId );
+    batch.VirtualIndices[numberOfPoints] = it.GetIndex();
+    virtualImage->TransformIndexToPhysicalPoint( batch.VirtualIndices[numberOfPoints], batch.VirtualPoints[numberOfPoints] );
+    if( ++numberOfPoints == lineLength )
+      {
+      this->ProcessVirtualPoints( &( batch.VirtualIndices[0] ), &( batch.VirtualPoints[0] ), numberOfPoints, threadId );
+      numberOfPoints = 0;
+      }
     }
 }
 
@@ -49,18 +59,28 @@ ImageToImageMetricv4GetValueAndDerivativeThreader< ThreadedIndexedContainerParti
 ::ThreadedExecution ( const DomainType & indexSubRange,
                       const ThreadIdType threadId )
 {
-  VirtualPointType virtualPoint;
-  VirtualIndexType virtualIndex;
   typename VirtualImageType::ConstPointer virtualImage = this->m_Associate->GetVirtualImage();
   typename TImageToImageMetricv4::VirtualPointSetType::ConstPointer virtualSampledPointSet = this->m_Associate->GetVirtualSampledPointSet();
   typedef typename TImageToImageMetricv4::VirtualPointSetType::MeshTraits::PointIdentifier ElementIdentifierType;
   const ElementIdentifierType begin = indexSubRange[0];
   const ElementIdentifierType end   = indexSubRange[1];
+  typename Superclass::VirtualPointBatchType & batch = this->m_VirtualPointBatchPerThread[threadId];
+
+  /* The points are processed in batches of consecutive samples. */
+  const SizeValueType batchSize = 256;
+  batch.VirtualIndices.resize( batchSize );
+  batch.VirtualPoints.resize( batchSize );
+  SizeValueType numberOfPoints = 0;
+
   for( ElementIdentifierType i = begin; i <= end; ++i )
     {
-    virtualPoint = virtualSampledPointSet->GetPoint( i );
-    virtualImage->TransformPhysicalPointToIndex( virtualPoint, virtualIndex );
-    this->ProcessVirtualPoint( virtualIndex, virtualPoint, threadId );
+    batch.VirtualPoints[numberOfPoints] = virtualSampledPointSet->GetPoint( i );
+    virtualImage->TransformPhysicalPointToIndex( batch.VirtualPoints[numberOfPoints], batch.VirtualIndices[numberOfPoints] );
+    if( ++numberOfPoints == batchSize || i == end )
+      {
+      this->ProcessVirtualPoints( &( batch.VirtualIndices[0] ), &( batch.VirtualPoints[0] ), numberOfPoints, threadId );
+      numberOfPoints = 0;
+      }
     }
 }
 
@@ -36,8 +36,10 @@ namespace itk
  *
  *  The \c ThreadedExecution in
  *  ImageToImageMetricv4GetValueAndDerivativeThreader calls \c
- *  ProcessVirtualPoint on every point in the virtual image domain.  \c
- *  ProcessVirtualPoint calls \c ProcessPoint on each point.
+ *  ProcessVirtualPoints on batches of points of the virtual image domain,
+ *  such as the lines of an image region.  \c ProcessVirtualPoints maps and
+ *  evaluates a whole batch at once, then calls \c ProcessMappedPoint on
+ *  each of its valid points.  \c ProcessMappedPoint calls \c ProcessPoint.
  *
  * \ingroup ITKMetricsv4 */
 template < class TDomainPartitioner, class TImageToImageMetricv4 >
@@ -86,6 +88,12 @@ public:
 
   typedef CompensatedSummation<DerivativeValueType>                   CompensatedDerivativeValueType;
   typedef std::vector<CompensatedDerivativeValueType>                 CompensatedDerivativeType;
+  typedef std::vector<CompensatedDerivativeType>                      CompensatedDerivativeBlocksType;
+
+  /** Number of parameters in each of the blocks used to accumulate the
+   * derivatives of transforms with local support but without one
+   * parameter per voxel, e.g. B-spline transforms. */
+  itkStaticConstMacro(DerivativeBlockSize, NumberOfParametersType, 256);
 
   /** Access the GetValueAndDerivative() accesor in image metric base. */
   virtual bool GetComputeDerivative() const;
@@ -114,6 +122,31 @@ protected:
                                     const VirtualPointType & virtualPoint,
                                     const ThreadIdType threadId );
 
+  /** Method called by the threaders to process a batch of virtual points,
+   * with the same results as \c ProcessVirtualPoint on each of them in turn.
+   * The batch is transformed and evaluated in the fixed and moving spaces
+   * with \c TransformAndEvaluateFixedPoints and \c
+   * TransformAndEvaluateMovingPoints, then \c ProcessMappedPoint is called on
+   * the valid points.  Derived classes that override \c ProcessVirtualPoint
+   * to process the points another way must override this method too. */
+  virtual void ProcessVirtualPoints( const VirtualIndexType * virtualIndices,
+                                     const VirtualPointType * virtualPoints,
+                                     const SizeValueType numberOfPoints,
+                                     const ThreadIdType threadId );
+
+  /** Method called by \c ProcessVirtualPoint and \c ProcessVirtualPoints on
+   * a virtual point that has been mapped to and evaluated within the fixed
+   * and moving spaces.  This computes the image gradients as needed and
+   * calls \c ProcessPoint.  Then it adds entries to m_MeasurePerThread and
+   * m_LocalDerivativesPerThread, m_NumberOfValidPointsPerThread. */
+  virtual bool ProcessMappedPoint( const VirtualIndexType & virtualIndex,
+                                   const VirtualPointType & virtualPoint,
+                                   const FixedImagePointType & mappedFixedPoint,
+                                   const FixedImagePixelType & mappedFixedPixelValue,
+                                   const MovingImagePointType & mappedMovingPoint,
+                                   const MovingImagePixelType & mappedMovingPixelValue,
+                                   const ThreadIdType threadId );
+
   /** Method to calculate the metric value and derivative
    * given a point, value and image derivative for both fixed and moving
    * spaces. The provided values have been calculated from \c virtualPoint,
@@ -168,6 +201,13 @@ protected:
   mutable std::vector< DerivativeType >               m_DerivativesPerThread;
   /** Intermediary threaded metric value storage. This is used only with global transforms. */
   mutable std::vector< CompensatedDerivativeType >    m_CompensatedDerivativesPerThread;
+  /** Intermediary threaded metric value storage, used only with B-spline
+   * transforms. Each thread holds the blocks of \c DerivativeBlockSize
+   * parameters it has touched; the other blocks stay empty. As each point
+   * only affects the few parameters whose support holds it, a thread
+   * processing a part of the virtual domain touches only a part of the
+   * parameters. */
+  mutable std::vector< CompensatedDerivativeBlocksType > m_CompensatedDerivativeBlocksPerThread;
   /** Intermediary threaded metric value storage. */
   mutable std::vector< DerivativeType >               m_LocalDerivativesPerThread;
   /** Intermediary threaded metric value storage. */
@@ -176,6 +216,21 @@ protected:
    * classes for efficiency. */
   mutable std::vector< JacobianType >                 m_MovingTransformJacobianPerThread;
 
+  /** Storage for the batches of \c ProcessVirtualPoints, for use by
+   * the \c ThreadedExecution of derived classes as well. */
+  struct VirtualPointBatchType
+    {
+    std::vector< VirtualIndexType >     VirtualIndices;
+    std::vector< VirtualPointType >     VirtualPoints;
+    std::vector< SizeValueType >        PointIds;
+    std::vector< FixedImagePointType >  MappedFixedPoints;
+    std::vector< FixedImagePixelType >  MappedFixedPixelValues;
+    std::vector< MovingImagePointType > MappedMovingPoints;
+    std::vector< MovingImagePixelType > MappedMovingPixelValues;
+    };
+  /** Pre-allocated batch storage, per thread. */
+  mutable std::vector< VirtualPointBatchType >        m_VirtualPointBatchPerThread;
+
   /** Cached values to avoid call overhead.
    *  These will only be set once threading has been started. */
   mutable NumberOfParametersType                      m_CachedNumberOfParameters;
@@ -20,6 +20,7 @@
 
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreaderBase.h"
 #include "itkNumericTraits.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -42,10 +43,13 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
   this->m_MeasurePerThread.resize( this->GetNumberOfThreadsUsed() );
   this->m_NumberOfValidPointsPerThread.resize( this->GetNumberOfThreadsUsed() );
   this->m_CompensatedDerivativesPerThread.resize( this->GetNumberOfThreadsUsed() );
+  this->m_CompensatedDerivativeBlocksPerThread.resize( this->GetNumberOfThreadsUsed() );
   /* This one is intermediary, for getting per-point results. */
   this->m_LocalDerivativesPerThread.resize( this->GetNumberOfThreadsUsed() );
   /* Per-thread pre-allocated Jacobian objects for efficiency */
   this->m_MovingTransformJacobianPerThread.resize( this->GetNumberOfThreadsUsed() );
+  /* Batch storage, that keeps its capacity from one batch to the next. */
+  this->m_VirtualPointBatchPerThread.resize( this->GetNumberOfThreadsUsed() );
 
   /* Make sure to clear this vector first. Otherwise if we've previoulsy pointed each element
    * Array to an m_DerivativeResult that's been deallocated, we'll get an access
@@ -76,6 +80,22 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
           this->m_DerivativesPerThread[i].SetData( this->m_Associate->m_DerivativeResult->data_block(),
                                                    this->m_Associate->m_DerivativeResult->Size(), false );
         }
+      else if ( this->m_Associate->m_MovingTransform->GetTransformCategory() == MovingTransformType::BSpline )
+        {
+        /* For B-spline transforms, each thread only gets the blocks of
+         * parameters it touches, see StorePointDerivativeResult.
+         * The blocks are kept from one call to the next, since the same
+         * parts of the domain usually go to the same threads. */
+        const NumberOfParametersType numberOfBlocks =
+          ( globalDerivativeSize + Self::DerivativeBlockSize - 1 ) / Self::DerivativeBlockSize;
+        if( this->m_CompensatedDerivativeBlocksPerThread[i].size() != numberOfBlocks )
+          {
+          this->m_CompensatedDerivativeBlocksPerThread[i].clear();
+          this->m_CompensatedDerivativeBlocksPerThread[i].resize( numberOfBlocks );
+          }
+        /* Free the memory of any global transform used before. */
+        CompensatedDerivativeType().swap( this->m_CompensatedDerivativesPerThread[i] );
+        }
       else
         {
         itkDebugMacro("ImageToImageMetricv4::Initialize: transform does NOT have local support\n");
@@ -84,6 +104,7 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
          * Use a CompensatedSummation value to provide for better consistency between
          * different number of threads. */
           this->m_CompensatedDerivativesPerThread[i].resize( globalDerivativeSize );
+          this->m_CompensatedDerivativeBlocksPerThread[i].clear();
         }
       }
     }
@@ -96,7 +117,18 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
     this->m_MeasurePerThread[thread] = NumericTraits< InternalComputationValueType >::Zero;
     if( this->m_Associate->GetComputeDerivative() )
       {
-      if ( this->m_Associate->m_MovingTransform->GetTransformCategory() != MovingTransformType::DisplacementField )
+      if ( this->m_Associate->m_MovingTransform->GetTransformCategory() == MovingTransformType::BSpline )
+        {
+        CompensatedDerivativeBlocksType & blocks = this->m_CompensatedDerivativeBlocksPerThread[thread];
+        for( size_t b = 0; b < blocks.size(); b++ )
+          {
+          for( size_t p = 0; p < blocks[b].size(); p++ )
+            {
+            blocks[b][p].ResetToZero();
+            }
+          }
+        }
+      else if ( this->m_Associate->m_MovingTransform->GetTransformCategory() != MovingTransformType::DisplacementField )
         {
         /* Be sure to init to 0 here, because the threader may not use
          * all the threads if the region is better split into fewer
@@ -132,7 +164,39 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
   /* For global transforms, sum the derivatives from each region. */
   if( this->m_Associate->GetComputeDerivative() )
     {
-    if ( this->m_Associate->m_MovingTransform->GetTransformCategory() != MovingTransformType::DisplacementField )
+    if ( this->m_Associate->m_MovingTransform->GetTransformCategory() == MovingTransformType::BSpline )
+      {
+      /* Only sum the blocks that have been touched by some thread. */
+      const NumberOfParametersType numberOfParameters = this->m_Associate->GetNumberOfParameters();
+      const NumberOfParametersType numberOfBlocks =
+        ( numberOfParameters + Self::DerivativeBlockSize - 1 ) / Self::DerivativeBlockSize;
+      for (NumberOfParametersType b = 0; b < numberOfBlocks; b++ )
+        {
+        const NumberOfParametersType blockStart = b * Self::DerivativeBlockSize;
+        const NumberOfParametersType blockSize =
+          std::min( static_cast< NumberOfParametersType >( Self::DerivativeBlockSize ), numberOfParameters - blockStart );
+        for (NumberOfParametersType p = 0; p < blockSize; p++ )
+          {
+          CompensatedDerivativeValueType sum;
+          sum.ResetToZero();
+          bool touched = false;
+          for (ThreadIdType i=0; i<this->GetNumberOfThreadsUsed(); i++)
+            {
+            const CompensatedDerivativeType & block = this->m_CompensatedDerivativeBlocksPerThread[i][b];
+            if( ! block.empty() )
+              {
+              sum += block[p].GetSum();
+              touched = true;
+              }
+            }
+          if( touched )
+            {
+            (*(this->m_Associate->m_DerivativeResult))[blockStart + p] += sum.GetSum();
+            }
+          }
+        }
+      }
+    else if ( this->m_Associate->m_MovingTransform->GetTransformCategory() != MovingTransformType::DisplacementField )
       {
       for (NumberOfParametersType p = 0; p < this->m_Associate->GetNumberOfParameters(); p++ )
         {
@@ -181,12 +245,9 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
 {
   FixedOutputPointType        mappedFixedPoint;
   FixedImagePixelType         mappedFixedPixelValue;
-  FixedImageGradientType      mappedFixedImageGradient;
   MovingOutputPointType       mappedMovingPoint;
   MovingImagePixelType        mappedMovingPixelValue;
-  MovingImageGradientType     mappedMovingImageGradient;
   bool                        pointIsValid = false;
-  MeasureType                 metricValueResult;
 
   /* Transform the point into fixed and moving spaces, and evaluate.
    * Do this in a try block to catch exceptions and print more useful info
@@ -194,12 +255,6 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
   try
     {
     pointIsValid = this->m_Associate->TransformAndEvaluateFixedPoint( virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
-    if( pointIsValid &&
-        this->m_Associate->GetComputeDerivative() &&
-        this->m_Associate->GetGradientSourceIncludesFixed() )
-      {
-      this->m_Associate->ComputeFixedImageGradientAtPoint( mappedFixedPoint, mappedFixedImageGradient );
-      }
     }
   catch( ExceptionObject & exc )
     {
@@ -217,12 +272,6 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
   try
     {
     pointIsValid = this->m_Associate->TransformAndEvaluateMovingPoint( virtualPoint, mappedMovingPoint, mappedMovingPixelValue );
-    if( pointIsValid &&
-        this->m_Associate->GetComputeDerivative() &&
-        this->m_Associate->GetGradientSourceIncludesMoving() )
-      {
-      this->m_Associate->ComputeMovingImageGradientAtPoint( mappedMovingPoint, mappedMovingImageGradient );
-      }
     }
   catch( ExceptionObject & exc )
     {
@@ -236,6 +285,109 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
     return pointIsValid;
     }
 
+  return this->ProcessMappedPoint( virtualIndex, virtualPoint,
+                                   mappedFixedPoint, mappedFixedPixelValue,
+                                   mappedMovingPoint, mappedMovingPixelValue,
+                                   threadId );
+}
+
+template< class TDomainPartitioner, class TImageToImageMetricv4 >
+void
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImageToImageMetricv4 >
+::ProcessVirtualPoints( const VirtualIndexType * virtualIndices,
+                        const VirtualPointType * virtualPoints,
+                        const SizeValueType numberOfPoints,
+                        const ThreadIdType threadId )
+{
+  if( numberOfPoints == 0 )
+    {
+    return;
+    }
+
+  VirtualPointBatchType & batch = this->m_VirtualPointBatchPerThread[threadId];
+  batch.PointIds.resize( numberOfPoints );
+  batch.MappedFixedPoints.resize( numberOfPoints );
+  batch.MappedFixedPixelValues.resize( numberOfPoints );
+  batch.MappedMovingPoints.resize( numberOfPoints );
+  batch.MappedMovingPixelValues.resize( numberOfPoints );
+  for( SizeValueType i = 0; i < numberOfPoints; ++i )
+    {
+    batch.PointIds[i] = i;
+    }
+
+  /* Transform the points into fixed and moving spaces, and evaluate.
+   * Only the points that are valid in the fixed space go on to the moving
+   * space, and the point ids are narrowed down to the valid points. */
+  SizeValueType numberOfValidPoints = 0;
+  try
+    {
+    numberOfValidPoints = this->m_Associate->TransformAndEvaluateFixedPoints( virtualPoints,
+                                                                              &( batch.PointIds[0] ), numberOfPoints,
+                                                                              &( batch.MappedFixedPoints[0] ),
+                                                                              &( batch.MappedFixedPixelValues[0] ) );
+    numberOfValidPoints = this->m_Associate->TransformAndEvaluateMovingPoints( virtualPoints,
+                                                                               &( batch.PointIds[0] ), numberOfValidPoints,
+                                                                               &( batch.MappedMovingPoints[0] ),
+                                                                               &( batch.MappedMovingPixelValues[0] ) );
+    }
+  catch( ExceptionObject & exc )
+    {
+    std::string msg("Caught exception: \n");
+    msg += exc.what();
+    ExceptionObject err(__FILE__, __LINE__, msg);
+    throw err;
+    }
+
+  /* Process the valid points in the order of the batch. */
+  for( SizeValueType k = 0; k < numberOfValidPoints; ++k )
+    {
+    const SizeValueType i = batch.PointIds[k];
+    this->ProcessMappedPoint( virtualIndices[i], virtualPoints[i],
+                              batch.MappedFixedPoints[i], batch.MappedFixedPixelValues[i],
+                              batch.MappedMovingPoints[i], batch.MappedMovingPixelValues[i],
+                              threadId );
+    }
+}
+
+template< class TDomainPartitioner, class TImageToImageMetricv4 >
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImageToImageMetricv4 >
+::ProcessMappedPoint( const VirtualIndexType & virtualIndex,
+                      const VirtualPointType & virtualPoint,
+                      const FixedImagePointType & mappedFixedPoint,
+                      const FixedImagePixelType & mappedFixedPixelValue,
+                      const MovingImagePointType & mappedMovingPoint,
+                      const MovingImagePixelType & mappedMovingPixelValue,
+                      const ThreadIdType threadId )
+{
+  FixedImageGradientType      mappedFixedImageGradient;
+  MovingImageGradientType     mappedMovingImageGradient;
+  bool                        pointIsValid = false;
+  MeasureType                 metricValueResult;
+
+  /* Compute the image gradients needed by the derivative. */
+  try
+    {
+    if( this->m_Associate->GetComputeDerivative() )
+      {
+      if( this->m_Associate->GetGradientSourceIncludesFixed() )
+        {
+        this->m_Associate->ComputeFixedImageGradientAtPoint( mappedFixedPoint, mappedFixedImageGradient );
+        }
+      if( this->m_Associate->GetGradientSourceIncludesMoving() )
+        {
+        this->m_Associate->ComputeMovingImageGradientAtPoint( mappedMovingPoint, mappedMovingImageGradient );
+        }
+      }
+    }
+  catch( ExceptionObject & exc )
+    {
+    std::string msg("Caught exception: \n");
+    msg += exc.what();
+    ExceptionObject err(__FILE__, __LINE__, msg);
+    throw err;
+    }
+
   /* Call the user method in derived classes to do the specific
    * calculations for value and derivative. */
   try
@@ -288,9 +440,35 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase< TDomainPartitioner, TImag
         this->m_LocalDerivativesPerThread[threadId][p] = static_cast<DerivativeValueType>( test / correctionResolution );
         }
       }
-    for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; p++ )
+    if ( this->m_Associate->m_MovingTransform->GetTransformCategory() == MovingTransformType::BSpline )
       {
-      this->m_CompensatedDerivativesPerThread[threadId][p] += this->m_LocalDerivativesPerThread[threadId][p];
+      /* Local support: only the parameters whose support holds the point
+       * are not zero. Accumulate those into the blocks of this thread,
+       * allocating each block on first use. */
+      const DerivativeType & localDerivative = this->m_LocalDerivativesPerThread[threadId];
+      CompensatedDerivativeBlocksType & blocks = this->m_CompensatedDerivativeBlocksPerThread[threadId];
+      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; p++ )
+        {
+        if( localDerivative[p] != NumericTraits< DerivativeValueType >::Zero )
+          {
+          const NumberOfParametersType b = p / Self::DerivativeBlockSize;
+          const NumberOfParametersType blockStart = b * Self::DerivativeBlockSize;
+          CompensatedDerivativeType & block = blocks[b];
+          if( block.empty() )
+            {
+            block.resize( std::min( static_cast< NumberOfParametersType >( Self::DerivativeBlockSize ),
+                                    this->m_CachedNumberOfParameters - blockStart ) );
+            }
+          block[p - blockStart] += localDerivative[p];
+          }
+        }
+      }
+    else
+      {
+      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; p++ )
+        {
+        this->m_CompensatedDerivativesPerThread[threadId][p] += this->m_LocalDerivativesPerThread[threadId][p];
+        }
       }
     }
   else
@@ -75,7 +75,7 @@ public:
 protected:
   JointHistogramMutualInformationComputeJointPDFThreader() {}
 
-  /** Walk through the domain, and call this->ProcessPoint on every point. */
+  /** Walk through the domain, and call this->ProcessPoints on every line of points. */
   virtual void ThreadedExecution( const DomainType & subdomain,
                                   const ThreadIdType threadId );
 
@@ -118,7 +118,7 @@ public:
 protected:
   JointHistogramMutualInformationComputeJointPDFThreader() {}
 
-  /** Walk through the domain, and call this->ProcessPoint on every point. */
+  /** Walk through the domain, and call this->ProcessPoints on batches of points. */
   virtual void ThreadedExecution( const DomainType & subdomain,
                                   const ThreadIdType threadId );
 
@@ -30,15 +30,23 @@ JointHistogramMutualInformationComputeJointPDFThreader< ThreadedImageRegionParti
 ::ThreadedExecution( const DomainType & imageSubRegion,
                      const ThreadIdType threadId )
 {
-  VirtualPointType virtualPoint;
-  VirtualIndexType virtualIndex;
+  typename Superclass::VirtualPointBatchType & batch = this->m_VirtualPointBatchPerThread[threadId];
+
+  /* The points are processed a line of the region at a time. */
+  const SizeValueType lineLength = imageSubRegion.GetSize()[0];
+  batch.VirtualPoints.resize( lineLength );
+  SizeValueType numberOfPoints = 0;
+
   typedef ImageRegionConstIteratorWithIndex< VirtualImageType > IteratorType;
   IteratorType it( this->m_Associate->GetVirtualImage(), imageSubRegion );
   for( it.GoToBegin(); !it.IsAtEnd(); ++it )
     {
-    virtualIndex = it.GetIndex();
-    this->m_Associate->TransformVirtualIndexToPhysicalPoint( virtualIndex, virtualPoint );
-    this->ProcessPoint( virtualIndex, virtualPoint, threadId );
+    this->m_Associate->TransformVirtualIndexToPhysicalPoint( it.GetIndex(), batch.VirtualPoints[numberOfPoints] );
+    if( ++numberOfPoints == lineLength )
+      {
+      this->ProcessPoints( &( batch.VirtualPoints[0] ), numberOfPoints, threadId );
+      numberOfPoints = 0;
+      }
     }
 }
 
@@ -48,16 +56,24 @@ JointHistogramMutualInformationComputeJointPDFThreader< ThreadedIndexedContainer
 ::ThreadedExecution( const DomainType & indexSubRange,
                      const ThreadIdType threadId )
 {
-  VirtualPointType virtualPoint;
-  VirtualIndexType virtualIndex;
   typedef typename VirtualPointSetType::MeshTraits::PointIdentifier ElementIdentifierType;
   const ElementIdentifierType begin = indexSubRange[0];
   const ElementIdentifierType end   = indexSubRange[1];
+  typename Superclass::VirtualPointBatchType & batch = this->m_VirtualPointBatchPerThread[threadId];
+
+  /* The points are processed in batches of consecutive samples. */
+  const SizeValueType batchSize = 256;
+  batch.VirtualPoints.resize( batchSize );
+  SizeValueType numberOfPoints = 0;
+
   for( ElementIdentifierType i = begin; i <= end; ++i )
     {
-    virtualPoint = this->m_Associate->m_VirtualSampledPointSet->GetPoint( i );
-    this->m_Associate->TransformPhysicalPointToVirtualIndex( virtualPoint, virtualIndex );
-    this->ProcessPoint( virtualIndex, virtualPoint, threadId );
+    batch.VirtualPoints[numberOfPoints] = this->m_Associate->m_VirtualSampledPointSet->GetPoint( i );
+    if( ++numberOfPoints == batchSize || i == end )
+      {
+      this->ProcessPoints( &( batch.VirtualPoints[0] ), numberOfPoints, threadId );
+      numberOfPoints = 0;
+      }
     }
 }
 
@@ -67,11 +67,24 @@ protected:
   /** Create the \c m_JointPDFPerThread's. */
   virtual void BeforeThreadedExecution();
 
-  /** Called by the \c ThreadedExecution of derived classes. */
+  /** Add the pair of values at a point to the joint histogram of the thread. */
   virtual void ProcessPoint( const VirtualIndexType & virtualIndex,
                              const VirtualPointType & virtualPoint,
                              const ThreadIdType threadId );
 
+  /** Called by the \c ThreadedExecution of derived classes.  Same as \c
+   * ProcessPoint on each of the points in turn, but the points are
+   * transformed and evaluated in the fixed and moving spaces at once. */
+  virtual void ProcessPoints( const VirtualPointType * virtualPoints,
+                              const SizeValueType numberOfPoints,
+                              const ThreadIdType threadId );
+
+  /** Add a pair of fixed and moving image values to the joint histogram of
+   * the thread. */
+  void AddToJointHistogram( const typename JointHistogramMetricType::FixedImagePixelType & fixedImageValue,
+                            const typename JointHistogramMetricType::MovingImagePixelType & movingImageValue,
+                            const ThreadIdType threadId );
+
   /** Collect the results per and normalize. */
   virtual void AfterThreadedExecution();
 
@@ -79,6 +92,19 @@ protected:
   std::vector< typename JointHistogramType::Pointer > m_JointHistogramPerThread;
   std::vector< SizeValueType >                        m_JointHistogramCountPerThread;
 
+  /** Storage for the batches of \c ProcessPoints, for use by the \c
+   * ThreadedExecution of derived classes as well. */
+  struct VirtualPointBatchType
+    {
+    std::vector< VirtualPointType >                                         VirtualPoints;
+    std::vector< SizeValueType >                                            PointIds;
+    std::vector< typename JointHistogramMetricType::FixedImagePointType >   MappedFixedPoints;
+    std::vector< typename JointHistogramMetricType::FixedImagePixelType >   FixedImageValues;
+    std::vector< typename JointHistogramMetricType::MovingImagePointType >  MappedMovingPoints;
+    std::vector< typename JointHistogramMetricType::MovingImagePixelType >  MovingImageValues;
+    };
+  std::vector< VirtualPointBatchType >                m_VirtualPointBatchPerThread;
+
 private:
   JointHistogramMutualInformationComputeJointPDFThreaderBase( const Self & ); // purposely not implemented
   void operator=( const Self & ); // purposely not implemented
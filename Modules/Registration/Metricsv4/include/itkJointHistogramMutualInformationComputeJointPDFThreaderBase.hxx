@@ -38,6 +38,7 @@ JointHistogramMutualInformationComputeJointPDFThreaderBase< TDomainPartitioner,
 {
   this->m_JointHistogramPerThread.resize( this->GetNumberOfThreadsUsed() );
   this->m_JointHistogramCountPerThread.resize( this->GetNumberOfThreadsUsed() );
+  this->m_VirtualPointBatchPerThread.resize( this->GetNumberOfThreadsUsed() );
   for( ThreadIdType i = 0; i < this->GetNumberOfThreadsUsed(); ++i )
     {
     if( this->m_JointHistogramPerThread[i].IsNull() )
@@ -87,18 +88,80 @@ JointHistogramMutualInformationComputeJointPDFThreaderBase< TDomainPartitioner,
   /** Add the paired intensity points to the joint histogram */
   if( pointIsValid )
     {
-    JointPDFPointType jointPDFpoint;
-    this->m_Associate->ComputeJointPDFPoint( fixedImageValue, movingImageValue, jointPDFpoint );
-    JointPDFIndexType jointPDFIndex;
-    this->m_JointHistogramPerThread[threadId]->TransformPhysicalPointToIndex( jointPDFpoint, jointPDFIndex );
-    if( this->m_JointHistogramPerThread[threadId]->GetBufferedRegion().IsInside( jointPDFIndex ) )
-      {
-      typename JointHistogramType::PixelType jointHistogramPixel;
-      jointHistogramPixel = this->m_JointHistogramPerThread[threadId]->GetPixel( jointPDFIndex );
-      jointHistogramPixel++;
-      this->m_JointHistogramPerThread[threadId]->SetPixel( jointPDFIndex, jointHistogramPixel );
-      this->m_JointHistogramCountPerThread[threadId]++;
-      }
+    this->AddToJointHistogram( fixedImageValue, movingImageValue, threadId );
+    }
+}
+
+template< class TDomainPartitioner, class TJointHistogramMetric >
+void
+JointHistogramMutualInformationComputeJointPDFThreaderBase< TDomainPartitioner, TJointHistogramMetric >
+::ProcessPoints( const VirtualPointType * virtualPoints,
+                 const SizeValueType numberOfPoints,
+                 const ThreadIdType threadId )
+{
+  if( numberOfPoints == 0 )
+    {
+    return;
+    }
+
+  VirtualPointBatchType & batch = this->m_VirtualPointBatchPerThread[threadId];
+  batch.PointIds.resize( numberOfPoints );
+  batch.MappedFixedPoints.resize( numberOfPoints );
+  batch.FixedImageValues.resize( numberOfPoints );
+  batch.MappedMovingPoints.resize( numberOfPoints );
+  batch.MovingImageValues.resize( numberOfPoints );
+  for( SizeValueType i = 0; i < numberOfPoints; ++i )
+    {
+    batch.PointIds[i] = i;
+    }
+
+  SizeValueType numberOfValidPoints = 0;
+  try
+    {
+    numberOfValidPoints = this->m_Associate->TransformAndEvaluateFixedPoints( virtualPoints,
+                                                                              &( batch.PointIds[0] ), numberOfPoints,
+                                                                              &( batch.MappedFixedPoints[0] ),
+                                                                              &( batch.FixedImageValues[0] ) );
+    numberOfValidPoints = this->m_Associate->TransformAndEvaluateMovingPoints( virtualPoints,
+                                                                               &( batch.PointIds[0] ), numberOfValidPoints,
+                                                                               &( batch.MappedMovingPoints[0] ),
+                                                                               &( batch.MovingImageValues[0] ) );
+    }
+  catch( ExceptionObject & exc )
+    {
+    //NOTE: there must be a cleaner way to do this:
+    std::string msg("Caught exception: \n");
+    msg += exc.what();
+    ExceptionObject err(__FILE__, __LINE__, msg);
+    throw err;
+    }
+
+  /** Add the paired intensity points to the joint histogram */
+  for( SizeValueType k = 0; k < numberOfValidPoints; ++k )
+    {
+    const SizeValueType i = batch.PointIds[k];
+    this->AddToJointHistogram( batch.FixedImageValues[i], batch.MovingImageValues[i], threadId );
+    }
+}
+
+template< class TDomainPartitioner, class TJointHistogramMetric >
+void
+JointHistogramMutualInformationComputeJointPDFThreaderBase< TDomainPartitioner, TJointHistogramMetric >
+::AddToJointHistogram( const typename JointHistogramMetricType::FixedImagePixelType & fixedImageValue,
+                       const typename JointHistogramMetricType::MovingImagePixelType & movingImageValue,
+                       const ThreadIdType threadId )
+{
+  JointPDFPointType jointPDFpoint;
+  this->m_Associate->ComputeJointPDFPoint( fixedImageValue, movingImageValue, jointPDFpoint );
+  JointPDFIndexType jointPDFIndex;
+  this->m_JointHistogramPerThread[threadId]->TransformPhysicalPointToIndex( jointPDFpoint, jointPDFIndex );
+  if( this->m_JointHistogramPerThread[threadId]->GetBufferedRegion().IsInside( jointPDFIndex ) )
+    {
+    typename JointHistogramType::PixelType jointHistogramPixel;
+    jointHistogramPixel = this->m_JointHistogramPerThread[threadId]->GetPixel( jointPDFIndex );
+    jointHistogramPixel++;
+    this->m_JointHistogramPerThread[threadId]->SetPixel( jointPDFIndex, jointHistogramPixel );
+    this->m_JointHistogramCountPerThread[threadId]++;
     }
 }
 
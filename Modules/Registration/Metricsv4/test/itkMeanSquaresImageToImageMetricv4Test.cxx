@@ -17,6 +17,7 @@
  *=========================================================================*/
 #include "itkMeanSquaresImageToImageMetricv4.h"
 #include "itkTranslationTransform.h"
+#include "itkBSplineTransform.h"
 
 /* Simple test to verify that class builds and runs.
  * Results are not verified. See ImageToImageMetricv4Test
@@ -190,6 +191,63 @@ int itkMeanSquaresImageToImageMetricv4Test(int, char ** const)
     return EXIT_FAILURE;
     }
 
+  // Test that a transform with local support, whose derivatives are
+  // accumulated by blocks of parameters, gives the same derivative with
+  // one and several threads.
+  std::cout << "Testing with a B-spline transform." << std::endl;
+  typedef itk::BSplineTransform<double,imageDimensionality,3> BSplineTransformType;
+  BSplineTransformType::Pointer bsplineTransform = BSplineTransformType::New();
+  BSplineTransformType::PhysicalDimensionsType physicalDimensions;
+  BSplineTransformType::MeshSizeType           meshSize;
+  for( unsigned int d = 0; d < imageDimensionality; d++ )
+    {
+    physicalDimensions[d] = spacing[d] * static_cast<double>( imageSize - 1 );
+    }
+  meshSize.Fill( 4 );
+  bsplineTransform->SetTransformDomainOrigin( origin );
+  bsplineTransform->SetTransformDomainDirection( direction );
+  bsplineTransform->SetTransformDomainPhysicalDimensions( physicalDimensions );
+  bsplineTransform->SetTransformDomainMeshSize( meshSize );
+  BSplineTransformType::ParametersType bsplineParameters( bsplineTransform->GetNumberOfParameters() );
+  for( unsigned int p = 0; p < bsplineParameters.Size(); p++ )
+    {
+    bsplineParameters[p] = 0.01 * static_cast<double>( p % 7 );
+    }
+  bsplineTransform->SetParameters( bsplineParameters );
+
+  metric->SetMovingTransform( bsplineTransform );
+  metric->SetUseFloatingPointCorrection( false );
+  MetricType::DerivativeType derivativeOneThread, derivativeThreaded;
+  try
+    {
+    metric->SetMaximumNumberOfThreads( 1 );
+    metric->Initialize();
+    metric->GetValueAndDerivative( valueReturn1, derivativeOneThread );
+    metric->SetMaximumNumberOfThreads( 4 );
+    metric->Initialize();
+    metric->GetValueAndDerivative( valueReturn2, derivativeThreaded );
+    }
+  catch( itk::ExceptionObject & exc )
+    {
+    std::cerr << "Caught unexpected exception with the B-spline transform: " << exc << std::endl;
+    return EXIT_FAILURE;
+    }
+  if( derivativeOneThread.Size() != bsplineTransform->GetNumberOfParameters()
+      || derivativeOneThread.two_norm() == 0.0 )
+    {
+    std::cerr << "Unexpected derivative with the B-spline transform: " << derivativeOneThread << std::endl;
+    return EXIT_FAILURE;
+    }
+  for( unsigned int p = 0; p < derivativeOneThread.Size(); p++ )
+    {
+    if( vcl_fabs( derivativeOneThread[p] - derivativeThreaded[p] ) > 1e-10 * ( 1.0 + vcl_fabs( derivativeOneThread[p] ) ) )
+      {
+      std::cerr << "B-spline derivatives differ with the number of threads at parameter " << p << ": "
+                << derivativeOneThread[p] << ", " << derivativeThreaded[p] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
 }
@@ -337,6 +337,27 @@ double itkMetricImageGradientTestRunTest( unsigned int imageSize, typename TTran
 
     bool b = metric->TransformAndEvaluateMovingPoint( virtualPoint, mappedMovingPoint, mappedMovingPixelValue );
 
+    // A batch of the same point and of a point far outside of the moving
+    // image must give the same result.
+    typename MetricType::VirtualPointType virtualPoints[2];
+    virtualPoints[0] = virtualPoint;
+    virtualPoints[1] = virtualPoint;
+    virtualPoints[1][0] += 10.0 * imageSize;
+    itk::SizeValueType pointIds[2] = { 0, 1 };
+    typename ImageType::PointType mappedMovingPoints[2];
+    typename ImageType::PixelType mappedMovingPixelValues[2];
+    const itk::SizeValueType numberOfValidPoints =
+      metric->TransformAndEvaluateMovingPoints( virtualPoints, pointIds, 2, mappedMovingPoints, mappedMovingPixelValues );
+    if ( numberOfValidPoints != ( b ? 1 : 0 )
+         || ( b && ( pointIds[0] != 0
+                     || mappedMovingPoints[0] != mappedMovingPoint
+                     || mappedMovingPixelValues[0] != mappedMovingPixelValue ) ) )
+      {
+      std::cerr << "TransformAndEvaluateMovingPoints does not match TransformAndEvaluateMovingPoint at "
+                << virtualPoint << std::endl;
+      return 0.0;
+      }
+
     // computed explicitly as ground truth
     if ( b )
       {
@@ -141,6 +141,27 @@ private:
   BinaryMedianImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);          //purposely not implemented
 
+  /** Counts the foreground pixels of the neighborhood; the median is
+   * the foreground value when they are the majority. */
+  class ForegroundCounter
+  {
+public:
+    ForegroundCounter(const InputPixelType & foreground, const InputPixelType & background,
+                      SizeValueType numberOfPixels):
+      m_Foreground(foreground), m_Background(background), m_MedianPosition(numberOfPixels / 2) {}
+    void Reset() { m_Count = 0; }
+    void Add(const InputPixelType & value) { m_Count += ( value == m_Foreground ); }
+    void Remove(const InputPixelType & value) { m_Count -= ( value == m_Foreground ); }
+    InputPixelType GetValue(const InputPixelType &) const
+    { return m_Count > m_MedianPosition ? m_Foreground : m_Background; }
+
+private:
+    InputPixelType m_Foreground;
+    InputPixelType m_Background;
+    SizeValueType  m_MedianPosition;
+    SizeValueType  m_Count;
+  };
+
   InputSizeType m_Radius;
 
   InputPixelType m_ForegroundValue;
@@ -19,15 +19,7 @@
 #define __itkBinaryMedianImageFilter_hxx
 #include "itkBinaryMedianImageFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkImageRegionIterator.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkOffset.h"
-#include "itkProgressReporter.h"
-
-#include <vector>
-#include <algorithm>
+#include "itkNeighborhoodRegionWalker.h"
 
 namespace itk
 {
@@ -96,67 +88,14 @@ BinaryMedianImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
-
-  ConstNeighborhoodIterator< InputImageType > bit;
-  ImageRegionIterator< OutputImageType >      it;
-
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename InputImageType::ConstPointer input  = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC(input, outputRegionForThread, m_Radius);
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
-
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
-    {
-    bit = ConstNeighborhoodIterator< InputImageType >(m_Radius, input, *fit);
-    it  = ImageRegionIterator< OutputImageType >(output, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
-
-    unsigned int neighborhoodSize = bit.Size();
-
-    // All of our neighborhoods have an odd number of pixels, so there is
-    // always a median index (if there where an even number of pixels
-    // in the neighborhood we have to average the middle two values).
-    unsigned int medianPosition = neighborhoodSize / 2;
-
-    while ( !bit.IsAtEnd() )
-      {
-      // count the pixels in the neighborhood
-      unsigned int count = 0;
-      for ( unsigned int i = 0; i < neighborhoodSize; ++i )
-        {
-        InputPixelType value = bit.GetPixel(i);
-        if ( value == m_ForegroundValue )
-          {
-          count++;
-          }
-        }
-
-      if ( count > medianPosition )
-        {
-        it.Set( static_cast< OutputPixelType >( m_ForegroundValue ) );
-        }
-      else
-        {
-        it.Set( static_cast< OutputPixelType >( m_BackgroundValue ) );
-        }
-
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
-      }
-    }
+  // All of our neighborhoods have an odd number of pixels, so there is
+  // always a median index.  The count of the foreground pixels is
+  // updated as the neighborhood slides along the lines.
+  NeighborhoodRegionWalker< InputImageType > walker(this->GetInput(), m_Radius);
+  ForegroundCounter counter( m_ForegroundValue, m_BackgroundValue, walker.GetNeighborhoodSize() );
+  walker.ComputeFromSlidingWindow(this->GetOutput(), outputRegionForThread, counter, progress);
 }
 
 /**
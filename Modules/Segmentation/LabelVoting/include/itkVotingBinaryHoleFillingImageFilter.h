@@ -130,6 +130,43 @@ private:
   VotingBinaryHoleFillingImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);                     //purposely not implemented
 
+  /** Counts the foreground pixels of the neighborhood, fills the
+   * background pixels where they reach the birth threshold, and counts
+   * the filled pixels. */
+  class HoleFillingAccumulator
+  {
+public:
+    HoleFillingAccumulator(const InputPixelType & foreground, const InputPixelType & background,
+                           unsigned int birthThreshold):
+      m_Foreground(foreground), m_Background(background),
+      m_BirthThreshold(birthThreshold), m_NumberOfPixelsChanged(0) {}
+    void Reset() { m_Count = 0; }
+    void Add(const InputPixelType & value) { m_Count += ( value == m_Foreground ); }
+    void Remove(const InputPixelType & value) { m_Count -= ( value == m_Foreground ); }
+    InputPixelType GetValue(const InputPixelType & center)
+    {
+      if ( center != m_Background )
+        {
+        return m_Foreground;
+        }
+      if ( m_Count >= m_BirthThreshold )
+        {
+        ++m_NumberOfPixelsChanged;
+        return m_Foreground;
+        }
+      return m_Background;
+    }
+    SizeValueType GetNumberOfPixelsChanged() const
+    { return m_NumberOfPixelsChanged; }
+
+private:
+    InputPixelType m_Foreground;
+    InputPixelType m_Background;
+    unsigned int   m_BirthThreshold;
+    unsigned int   m_Count;
+    SizeValueType  m_NumberOfPixelsChanged;
+  };
+
   unsigned int m_MajorityThreshold;
 
   SizeValueType m_NumberOfPixelsChanged;
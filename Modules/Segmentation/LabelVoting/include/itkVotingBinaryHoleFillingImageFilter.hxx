@@ -19,14 +19,7 @@
 #define __itkVotingBinaryHoleFillingImageFilter_hxx
 #include "itkVotingBinaryHoleFillingImageFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkImageRegionIterator.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkProgressReporter.h"
-
-#include <vector>
-#include <algorithm>
+#include "itkNeighborhoodRegionWalker.h"
 
 namespace itk
 {
@@ -78,78 +71,16 @@ VotingBinaryHoleFillingImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
-
-  ConstNeighborhoodIterator< InputImageType > bit;
-  ImageRegionIterator< OutputImageType >      it;
-
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename InputImageType::ConstPointer input  = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC( input, outputRegionForThread, this->GetRadius() );
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
-
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  const InputPixelType backgroundValue = this->GetBackgroundValue();
-  const InputPixelType foregroundValue = this->GetForegroundValue();
-  const unsigned int   birthThreshold  = (unsigned int)( this->GetBirthThreshold() );
-
-  unsigned int numberOfPixelsChanged = 0;
+  // The count of the foreground pixels is updated as the neighborhood
+  // slides along the lines.
+  NeighborhoodRegionWalker< InputImageType > walker( this->GetInput(), this->GetRadius() );
+  HoleFillingAccumulator holeFilling( this->GetForegroundValue(), this->GetBackgroundValue(),
+                                      (unsigned int)( this->GetBirthThreshold() ) );
+  walker.ComputeFromSlidingWindow(this->GetOutput(), outputRegionForThread, holeFilling, progress);
 
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
-    {
-    bit = ConstNeighborhoodIterator< InputImageType >(this->GetRadius(), input, *fit);
-    it  = ImageRegionIterator< OutputImageType >(output, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
-
-    unsigned int neighborhoodSize = bit.Size();
-
-    while ( !bit.IsAtEnd() )
-      {
-      const InputPixelType inpixel = bit.GetCenterPixel();
-
-      if ( inpixel == backgroundValue )
-        {
-        // count the pixels ON in the neighborhood
-        unsigned int count = 0;
-        for ( unsigned int i = 0; i < neighborhoodSize; ++i )
-          {
-          InputPixelType value = bit.GetPixel(i);
-          if ( value == foregroundValue )
-            {
-            count++;
-            }
-          }
-
-        if ( count >= birthThreshold )
-          {
-          it.Set( static_cast< OutputPixelType >( foregroundValue ) );
-          numberOfPixelsChanged++;
-          }
-        else
-          {
-          it.Set( static_cast< OutputPixelType >( backgroundValue ) );
-          }
-        }
-      else
-        {
-        it.Set( static_cast< OutputPixelType >( foregroundValue ) );
-        }
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
-      }
-    }
-  this->m_Count[threadId] = numberOfPixelsChanged;
+  this->m_Count[threadId] = holeFilling.GetNumberOfPixelsChanged();
 }
 
 template< class TInputImage, class TOutputImage >
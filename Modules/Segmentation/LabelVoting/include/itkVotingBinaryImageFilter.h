@@ -142,6 +142,41 @@ private:
   VotingBinaryImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);          //purposely not implemented
 
+  /** Counts the foreground pixels of the neighborhood and applies the
+   * birth and survival rules to the center pixel. */
+  class VotingAccumulator
+  {
+public:
+    VotingAccumulator(const InputPixelType & foreground, const InputPixelType & background,
+                      unsigned int birthThreshold, unsigned int survivalThreshold):
+      m_Foreground(foreground), m_Background(background),
+      m_BirthThreshold(birthThreshold), m_SurvivalThreshold(survivalThreshold) {}
+    void Reset() { m_Count = 0; }
+    void Add(const InputPixelType & value) { m_Count += ( value == m_Foreground ); }
+    void Remove(const InputPixelType & value) { m_Count -= ( value == m_Foreground ); }
+    InputPixelType GetValue(const InputPixelType & center) const
+    {
+      // Unless the birth or survival rate is meet the pixel will be
+      // the same value
+      if ( center == m_Background && m_Count >= m_BirthThreshold )
+        {
+        return m_Foreground;
+        }
+      else if ( center == m_Foreground && m_Count < m_SurvivalThreshold )
+        {
+        return m_Background;
+        }
+      return center;
+    }
+
+private:
+    InputPixelType m_Foreground;
+    InputPixelType m_Background;
+    unsigned int   m_BirthThreshold;
+    unsigned int   m_SurvivalThreshold;
+    unsigned int   m_Count;
+  };
+
   InputSizeType m_Radius;
 
   InputPixelType m_ForegroundValue;
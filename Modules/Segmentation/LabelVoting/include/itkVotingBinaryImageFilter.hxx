@@ -19,14 +19,7 @@
 #define __itkVotingBinaryImageFilter_hxx
 #include "itkVotingBinaryImageFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhoodInnerProduct.h"
-#include "itkImageRegionIterator.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkProgressReporter.h"
-
-#include <vector>
-#include <algorithm>
+#include "itkNeighborhoodRegionWalker.h"
 
 namespace itk
 {
@@ -97,69 +90,13 @@ VotingBinaryImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
-
-  ConstNeighborhoodIterator< InputImageType > bit;
-  ImageRegionIterator< OutputImageType >      it;
-
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename InputImageType::ConstPointer input  = this->GetInput();
-
-  // Find the data-set boundary "faces"
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType faceList;
-  NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
-  faceList = bC(input, outputRegionForThread, m_Radius);
-
-  typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType::iterator fit;
-
   ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
 
-  // Process each of the boundary faces.  These are N-d regions which border
-  // the edge of the buffer.
-  for ( fit = faceList.begin(); fit != faceList.end(); ++fit )
-    {
-    bit = ConstNeighborhoodIterator< InputImageType >(m_Radius, input, *fit);
-    it  = ImageRegionIterator< OutputImageType >(output, *fit);
-    bit.OverrideBoundaryCondition(&nbc);
-    bit.GoToBegin();
-
-    unsigned int neighborhoodSize = bit.Size();
-
-    while ( !bit.IsAtEnd() )
-      {
-      const InputPixelType inpixel = bit.GetCenterPixel();
-
-      // count the pixels ON in the neighborhood
-      unsigned int count = 0;
-      for ( unsigned int i = 0; i < neighborhoodSize; ++i )
-        {
-        InputPixelType value = bit.GetPixel(i);
-        if ( value == m_ForegroundValue )
-          {
-          count++;
-          }
-        }
-
-      // Unless the birth or survival rate is meet the pixel will be
-      // the same value
-      it.Set( static_cast< OutputPixelType >( inpixel ) );
-
-      if ( inpixel == m_BackgroundValue && count >= m_BirthThreshold )
-        {
-        it.Set( static_cast< OutputPixelType >( m_ForegroundValue ) );
-        }
-      else if ( inpixel == m_ForegroundValue && count < m_SurvivalThreshold )
-        {
-        it.Set( static_cast< OutputPixelType >( m_BackgroundValue ) );
-        }
-
-
-      ++bit;
-      ++it;
-      progress.CompletedPixel();
-      }
-    }
+  // The count of the foreground pixels is updated as the neighborhood
+  // slides along the lines.
+  NeighborhoodRegionWalker< InputImageType > walker(this->GetInput(), m_Radius);
+  VotingAccumulator voting(m_ForegroundValue, m_BackgroundValue, m_BirthThreshold, m_SurvivalThreshold);
+  walker.ComputeFromSlidingWindow(this->GetOutput(), outputRegionForThread, voting, progress);
 }
 
 /**